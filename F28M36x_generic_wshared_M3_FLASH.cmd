@@ -156,6 +156,7 @@ SECTIONS
 
  
  	SERIALBUFFER : > C0913
+ 	SAMPLESBUFFER : > C0913
 	ETHERNETBUFFER : > C1415
 
  	MTOC_MSG_RAM : > MTOCRAM
@@ -35,7 +35,9 @@
 
 #include "board_drivers/hardware_def.h"
 #include "communication_drivers/ipc/ipc_lib.h"
+#include "communication_drivers/profiler/profiler.h"
 #include "communication_drivers/system_task/system_task.h"
+#include "communication_drivers/timer/timer.h"
 
 #include "adcp.h"
 
@@ -154,6 +156,7 @@ void isr_adcp(void)
 {
     unsigned long ulStatus;
 	uint8_t count = 0;
+	uint32_t t_start = get_cycle_counter();
 
 	//GPIOPinWrite(DEBUG_BASE, DEBUG_PIN, ON);
 
@@ -190,6 +193,8 @@ void isr_adcp(void)
 	// Clear any pending status
 	SSIIntClear(ADCP_SPI_BASE, ulStatus);
 
+	prof_record(PROF_ISR_ADCP, get_cycle_counter() - t_start);
+
 	//GPIOPinWrite(DEBUG_BASE, DEBUG_PIN, OFF);
 }
 
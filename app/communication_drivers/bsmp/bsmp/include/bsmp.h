@@ -6,6 +6,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "../src/md5/md5.h"
+
 /* Library-wide limits */
 
 #define BSMP_HEADER_SIZE            3       // Command code + 2 bytes for size
@@ -84,6 +86,8 @@ enum bsmp_err
 #define BSMP_CURVE_LIST_INFO        5
 #define BSMP_CURVE_BLOCK_INFO       3
 #define BSMP_CURVE_CSUM_SIZE        16
+#define BSMP_CURVE_CSUM_BLOCK_SIZE  1024    // Largest block hashed through
+                                            // read_block, if not mapped
 
 #define BSMP_FUNC_MAX_INPUT         64//32//15
 #define BSMP_FUNC_MAX_OUTPUT        32//15
@@ -155,6 +159,17 @@ struct bsmp_curve_info
     uint8_t  checksum[16];          // MD5 checksum of the curve
 };
 
+// Incremental checksum of a writable curve. The MD5 context holds the first
+// next_block blocks already hashed, so a write beyond them doesn't discard the
+// work done. gen is incremented on every write to the curve.
+struct bsmp_curve_csum
+{
+    uint32_t next_block;            // Number of blocks hashed into ctx
+    uint32_t gen;                   // Write counter
+    bool     valid;                 // Whether info.checksum is up to date
+    MD5_CTX  ctx;                   // MD5 context after next_block blocks
+};
+
 struct bsmp_curve;
 
 typedef bool (*bsmp_curve_read_t)  (struct bsmp_curve *curve, uint16_t block,
@@ -173,6 +188,15 @@ struct bsmp_curve
     bool (*write_block)(struct bsmp_curve *curve, uint16_t block, uint8_t *data,
                         uint16_t len);
 
+    // Optional function to get the address of a block in memory. If present,
+    // block reads may be answered without copying the block (zero-copy). If it
+    // returns false, the block is read through read_block.
+    bool (*map_block)(struct bsmp_curve *curve, uint16_t block, uint8_t **data,
+                      uint16_t *len);
+
+    // Checksum state of writable curves, maintained by BSMP
+    struct bsmp_curve_csum csum;
+
     // The user can make use of this variable as he wishes. It is not touched by
     // BSMP
     void *user;
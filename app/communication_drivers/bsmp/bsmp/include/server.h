@@ -15,6 +15,21 @@ enum bsmp_operation
 typedef bool (*bsmp_hook_t) (enum bsmp_operation op, struct bsmp_var **list);
 typedef bool (*bsmp_custom_md5_t) (struct bsmp_curve *curve, uint8_t *csum);
 
+// Function hook. Called right before a function is executed (done = false)
+// and right after it returns (done = true).
+typedef void (*bsmp_func_hook_t) (uint8_t func_id, bool done);
+
+// Maximum number of copy runs shared by the read plans of all groups
+#define BSMP_MAX_GROUP_RUNS         256
+
+// Contiguous memory region copied into a group read answer. Variables of a
+// group which are adjacent in memory are merged into a single run.
+struct bsmp_group_run
+{
+    volatile uint8_t            *data;
+    uint16_t                    size;
+};
+
 // BSMP instance
 struct bsmp_server
 {
@@ -26,6 +41,14 @@ struct bsmp_server
     struct bsmp_var             *modified_list[BSMP_MAX_VARIABLES+1];
     bsmp_hook_t                 hook;
     bsmp_custom_md5_t           custom_md5;
+    bsmp_func_hook_t            func_hook;
+
+    // Read plans of groups, compiled on first read after any group change.
+    // A group with variables but no runs is read variable by variable.
+    struct bsmp_group_run       group_runs[BSMP_MAX_GROUP_RUNS];
+    uint16_t                    group_first_run[BSMP_MAX_GROUPS];
+    uint16_t                    group_num_runs[BSMP_MAX_GROUPS];
+    bool                        group_plans_ok;
 };
 
 // Handle to a server instance
@@ -38,6 +61,13 @@ struct bsmp_raw_packet
 {
     uint8_t *data;
     uint16_t len;
+
+    // Zero-copy answers. If ext_enabled is set on the response packet by the
+    // caller, a curve block may be answered as an external span, to be sent
+    // right after the len bytes of data. Otherwise ext_len is always 0.
+    bool     ext_enabled;
+    uint8_t  *ext_data;
+    uint16_t ext_len;
 };
 
 /**
@@ -175,6 +205,44 @@ enum bsmp_err bsmp_register_hook (bsmp_server_t *server, bsmp_hook_t hook);
  */
 enum bsmp_err bsmp_register_md5(bsmp_server_t *server, bsmp_custom_md5_t md5);
 
+/**
+ * Register a function that will be called around the execution of every BSMP
+ * function, for instance to measure its execution time. It's not required to
+ * register a function hook.
+ *
+ * @param server [input] Handle to a server instance
+ * @param hook [input] Function hook
+ *
+ * @return BSMP_SUCCESS or one of the following errors:
+ * <ul>
+ *   <li> BSMP_ERR_PARAM_INVALID: Either server or hook is a NULL pointer. </li>
+ * </ul>
+ */
+enum bsmp_err bsmp_register_func_hook(bsmp_server_t *server,
+                                      bsmp_func_hook_t hook);
+
+/**
+ * Update the checksum of writable curves, one block at a time. It's meant to be
+ * called periodically from a background task, so the checksum is already up to
+ * date when queried. Nothing is done if a custom md5 function is registered.
+ *
+ * Read-only curves are not updated, since their content may change without
+ * notice to BSMP. Their checksum is only calculated by CMD_CURVE_RECALC_CSUM.
+ *
+ * @param server [input] Handle to a server instance.
+ *
+ * @return true if a block was processed, false if there's nothing to update.
+ */
+bool bsmp_update_csum (bsmp_server_t *server);
+
+/**
+ * Notify that the content of a writable curve was modified without going
+ * through BSMP, so its checksum is calculated again.
+ *
+ * @param curve [input] Curve whose content was modified.
+ */
+void bsmp_invalidate_csum (struct bsmp_curve *curve);
+
 /**
  * Process a received message and prepare an answer.
  *
@@ -21,6 +21,9 @@ without express or implied warranty of any kind.
 These notices must be retained in any copies of any part of this
 documentation and/or software. */
 
+#ifndef BSMP_MD5_H
+#define BSMP_MD5_H
+
 #include <stdint.h>
 
 /* MD5 context. */
@@ -33,3 +36,5 @@ typedef struct {
 void MD5Init(MD5_CTX *);
 void MD5Update(MD5_CTX *, uint8_t *, unsigned int);
 void MD5Final(uint8_t [16], MD5_CTX *);
+
+#endif
@@ -50,6 +50,8 @@ enum bsmp_err bsmp_register_variable (bsmp_server_t *server,
     else
         group_add_var(&server->groups.list[GROUP_READ_ID], var);
 
+    server->group_plans_ok = false;
+
     return BSMP_SUCCESS;
 }
 
@@ -57,6 +59,7 @@ enum bsmp_err bsmp_register_curve (bsmp_server_t *server,
                                    struct bsmp_curve *curve)
 {
     SERVER_REGISTER(curve, BSMP_MAX_CURVES);
+    curve_csum_reset(curve);
     return BSMP_SUCCESS;
 }
 
@@ -87,6 +90,44 @@ enum bsmp_err bsmp_register_md5(bsmp_server_t *server, bsmp_custom_md5_t md5)
     return BSMP_SUCCESS;
 }
 
+enum bsmp_err bsmp_register_func_hook(bsmp_server_t *server,
+                                      bsmp_func_hook_t hook)
+{
+    if(!server || !hook)
+        return BSMP_ERR_PARAM_INVALID;
+
+    server->func_hook = hook;
+
+    return BSMP_SUCCESS;
+}
+
+void bsmp_invalidate_csum (struct bsmp_curve *curve)
+{
+    if(curve)
+        curve_csum_invalidate(curve, 0);
+}
+
+bool bsmp_update_csum (bsmp_server_t *server)
+{
+    if(!server || server->custom_md5)
+        return false;
+
+    struct bsmp_curve *curve;
+    unsigned int i;
+    for(i = 0; i < server->curves.count; ++i)
+    {
+        curve = server->curves.list[i];
+
+        if(curve->info.writable && !curve->csum.valid)
+        {
+            curve_csum_step(curve);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 struct raw_message
 {
     uint8_t command_code;
@@ -144,7 +185,10 @@ enum bsmp_err bsmp_process_packet (bsmp_server_t *server,
     recv_msg.payload      = recv_raw_msg->payload;
     recv_msg.payload_size = (recv_raw_msg->size[0] << 8)+recv_raw_msg->size[1];
 
-    send_msg.payload = send_raw_msg->payload;
+    send_msg.payload     = send_raw_msg->payload;
+    send_msg.ext_enabled = response->ext_enabled;
+    send_msg.ext_payload = NULL;
+    send_msg.ext_size    = 0;
 
     server->modified_list[0] = NULL;
 
@@ -164,7 +208,10 @@ enum bsmp_err bsmp_process_packet (bsmp_server_t *server,
     send_raw_msg->size[0] = send_msg.payload_size >> 8;
     send_raw_msg->size[1] = send_msg.payload_size;
 
-    response->len = send_msg.payload_size + BSMP_HEADER_SIZE;
+    response->len = send_msg.payload_size - send_msg.ext_size +
+                    BSMP_HEADER_SIZE;
+    response->ext_data = send_msg.ext_payload;
+    response->ext_len  = send_msg.ext_size;
 
     return BSMP_SUCCESS;
 }
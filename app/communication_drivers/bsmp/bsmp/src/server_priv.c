@@ -84,6 +84,127 @@ static void group_to_mod_list (bsmp_server_t *server, struct bsmp_group *grp)
     server->modified_list[i] = NULL;
 }
 
+// Compile read plans of all groups into the shared pool of copy runs
+void group_compile_plans (bsmp_server_t *server)
+{
+    struct bsmp_group *grp;
+    struct bsmp_var *var;
+    struct bsmp_group_run *run;
+    unsigned int g, i;
+    uint16_t n = 0;
+
+    for(g = 0; g < server->groups.count; ++g)
+    {
+        grp = &server->groups.list[g];
+        server->group_first_run[g] = n;
+        server->group_num_runs[g]  = 0;
+        run = NULL;
+
+        for(i = 0; i < grp->vars.count; ++i)
+        {
+            var = server->vars.list[grp->vars.list[i]->id];
+
+            // Merge with previous run if variable is adjacent in memory
+            if(run && (run->data + run->size == var->data))
+            {
+                run->size += var->info.size;
+                continue;
+            }
+
+            // Pool is full: this group is read variable by variable
+            if(n == BSMP_MAX_GROUP_RUNS)
+            {
+                n = server->group_first_run[g];
+                server->group_num_runs[g] = 0;
+                break;
+            }
+
+            run = &server->group_runs[n++];
+            run->data = var->data;
+            run->size = var->info.size;
+            ++server->group_num_runs[g];
+        }
+    }
+
+    server->group_plans_ok = true;
+}
+
+/* Helper Curve functions */
+
+void curve_csum_reset (struct bsmp_curve *curve)
+{
+    curve->csum.next_block = 0;
+    curve->csum.valid      = false;
+    MD5Init(&curve->csum.ctx);
+    memset(curve->info.checksum, 0, sizeof(curve->info.checksum));
+}
+
+// Called after a block is written. Hashed blocks are kept if the written one
+// comes after them, which is the case of a curve written in order.
+void curve_csum_invalidate (struct bsmp_curve *curve, uint16_t block)
+{
+    ++curve->csum.gen;
+
+    if(curve->csum.valid || block < curve->csum.next_block)
+        curve_csum_reset(curve);
+}
+
+// Scratch of curve_csum_step(), kept off the stack. Checksums are only
+// computed from the main loop, so they're never used concurrently.
+static uint8_t csum_block[BSMP_CURVE_CSUM_BLOCK_SIZE];
+static MD5_CTX csum_md5ctx;
+
+// Hash next block of curve, finishing the checksum on the last one. Blocks
+// are hashed in place if the curve maps them, otherwise they're read into a
+// scratch buffer. Returns false if the block couldn't be read (resource busy,
+// or not mapped and larger than BSMP_CURVE_CSUM_BLOCK_SIZE).
+bool curve_csum_step (struct bsmp_curve *curve)
+{
+    struct bsmp_curve_csum *csum = &curve->csum;
+
+    if(csum->valid)
+        return true;
+
+    uint32_t gen = csum->gen;
+    uint32_t next_block = csum->next_block;
+    uint8_t *block;
+    uint16_t read_bytes = 0;
+    MD5_CTX *md5ctx = &csum_md5ctx;
+
+    if(!curve->map_block ||
+       !curve->map_block(curve, (uint16_t)next_block, &block, &read_bytes))
+    {
+        block = csum_block;
+
+        if(curve->info.block_size > sizeof(csum_block) ||
+           !curve->read_block(curve, (uint16_t)next_block, block, &read_bytes))
+            return false;
+    }
+
+    *md5ctx = csum->ctx;
+    MD5Update(md5ctx, block, read_bytes);
+
+    // Curve was written while hashing (another interface)
+    if(gen != csum->gen)
+        return true;
+
+    csum->ctx        = *md5ctx;
+    csum->next_block = ++next_block;
+
+    if(next_block >= curve->info.nblocks ||
+       read_bytes < curve->info.block_size)
+    {
+        MD5Final(curve->info.checksum, md5ctx);
+        csum->valid = true;
+    }
+
+    // Curve was written while saving the result: discard it
+    if(gen != csum->gen)
+        curve_csum_reset(curve);
+
+    return true;
+}
+
 /* Version */
 
 SERVER_CMD_FUNCTION (query_version)
@@ -368,14 +489,34 @@ SERVER_CMD_FUNCTION (group_read)
     // Iterate over group's variables
     MESSAGE_SET_ANSWER(send_msg, CMD_GROUP_VALUES);
 
-    struct bsmp_var *var;
-    unsigned int i;
+    if(!server->group_plans_ok)
+        group_compile_plans(server);
+
     uint8_t *payloadp = send_msg->payload;
-    for(i = 0; i < grp->vars.count; ++i)
+    uint16_t nruns = server->group_num_runs[group_id];
+
+    if(nruns)
     {
-        var = server->vars.list[grp->vars.list[i]->id];
-        memcpy(payloadp, var->data, var->info.size);
-        payloadp += var->info.size;
+        struct bsmp_group_run *run;
+        run = &server->group_runs[server->group_first_run[group_id]];
+
+        while(nruns--)
+        {
+            memcpy(payloadp, run->data, run->size);
+            payloadp += run->size;
+            ++run;
+        }
+    }
+    else
+    {
+        struct bsmp_var *var;
+        unsigned int i;
+        for(i = 0; i < grp->vars.count; ++i)
+        {
+            var = server->vars.list[grp->vars.list[i]->id];
+            memcpy(payloadp, var->data, var->info.size);
+            payloadp += var->info.size;
+        }
     }
     send_msg->payload_size = grp->size;
 }
@@ -518,6 +659,7 @@ SERVER_CMD_FUNCTION (group_create)
 
     // Group created
     ++server->groups.count;
+    group_compile_plans(server);
 
     // Prepare answer
     MESSAGE_SET_ANSWER(send_msg, CMD_OK);
@@ -530,6 +672,7 @@ SERVER_CMD_FUNCTION (group_remove_all)
         MESSAGE_SET_ANSWER_RET(send_msg, CMD_ERR_INVALID_PAYLOAD_SIZE);
 
     server->groups.count = GROUP_STANDARD_COUNT;
+    server->group_plans_ok = false;
     MESSAGE_SET_ANSWER(send_msg, CMD_OK);
 }
 
@@ -574,6 +717,8 @@ SERVER_CMD_FUNCTION (curve_query_csum)
 
     struct bsmp_curve *curve = server->curves.list[curve_id];
 
+    // Checksum of a writable curve is zero until updated on background by
+    // bsmp_update_csum() or by CMD_CURVE_RECALC_CSUM
     MESSAGE_SET_ANSWER(send_msg, CMD_CURVE_CSUM);
     memcpy(send_msg->payload, curve->info.checksum, BSMP_CURVE_CSUM_SIZE);
     send_msg->payload_size = BSMP_CURVE_CSUM_SIZE;
@@ -604,6 +749,17 @@ SERVER_CMD_FUNCTION (curve_block_request)
     send_msg->payload[1] = recv_msg->payload[1];    // Offset (most sig.)
     send_msg->payload[2] = recv_msg->payload[2];    // Offset (less sig.)
 
+    // Leave block in place, if both curve and caller support it
+    uint16_t len = 0;
+
+    if(send_msg->ext_enabled && curve->map_block &&
+       curve->map_block(curve, block_offset, &send_msg->ext_payload, &len))
+    {
+        send_msg->ext_size     = len;
+        send_msg->payload_size = BSMP_CURVE_BLOCK_INFO + len;
+        return;
+    }
+
     bool ok = curve->read_block(curve, block_offset,
                                 send_msg->payload + BSMP_CURVE_BLOCK_INFO,
                                 &send_msg->payload_size);
@@ -651,7 +807,7 @@ SERVER_CMD_FUNCTION (curve_block)
     if(!ok)
         MESSAGE_SET_ANSWER_RET(send_msg, CMD_ERR_RESOURCE_BUSY);
 
-    memset(curve->info.checksum, 0, sizeof(curve->info.checksum));
+    curve_csum_invalidate(curve, block_offset);
     MESSAGE_SET_ANSWER(send_msg, CMD_OK);
 }
 
@@ -676,25 +832,41 @@ SERVER_CMD_FUNCTION (curve_recalc_csum)
         if(!server->custom_md5(curve, curve->info.checksum))
             MESSAGE_SET_ANSWER_RET(send_msg, CMD_ERR_RESOURCE_BUSY);
     }
+    else if(curve->info.writable)
+    {
+        // Resume from the last block hashed
+        while(!curve->csum.valid)
+            if(!curve_csum_step(curve))
+                MESSAGE_SET_ANSWER_RET(send_msg, CMD_ERR_RESOURCE_BUSY);
+    }
     else
     {
-        uint8_t block[curve->info.block_size];
-        MD5_CTX md5ctx;
+        // Same scratch as curve_csum_step(), since blocks may be larger than
+        // the whole stack
+        uint8_t *block;
+        MD5_CTX *md5ctx = &csum_md5ctx;
 
-        MD5Init(&md5ctx);
+        MD5Init(md5ctx);
 
         unsigned int i;
         for(i = 0; i < curve->info.nblocks; ++i)
         {
             uint16_t read_bytes = 0;
-            if(!curve->read_block(curve, (uint16_t)i, block, &read_bytes))
-                MESSAGE_SET_ANSWER_RET(send_msg, CMD_ERR_RESOURCE_BUSY);
-            MD5Update(&md5ctx, block, read_bytes);
-
-            if(read_bytes < curve->info.nblocks)
+            if(!curve->map_block ||
+               !curve->map_block(curve, (uint16_t)i, &block, &read_bytes))
+            {
+                block = csum_block;
+
+                if(curve->info.block_size > sizeof(csum_block) ||
+                   !curve->read_block(curve, (uint16_t)i, block, &read_bytes))
+                    MESSAGE_SET_ANSWER_RET(send_msg, CMD_ERR_RESOURCE_BUSY);
+            }
+            MD5Update(md5ctx, block, read_bytes);
+
+            if(read_bytes < curve->info.block_size)
                 break;
         }
-        MD5Final(curve->info.checksum, &md5ctx);
+        MD5Final(curve->info.checksum, md5ctx);
     }
 
     MESSAGE_SET_ANSWER(send_msg, CMD_CURVE_CSUM);
@@ -742,8 +914,14 @@ SERVER_CMD_FUNCTION (func_execute)
 
     uint8_t ret;
 
+    if(server->func_hook)
+        server->func_hook(func_id, false);
+
     ret = func->func_p(&recv_msg->payload[1], &send_msg->payload[0]);
 
+    if(server->func_hook)
+        server->func_hook(func_id, true);
+
     if(ret)
     {
         MESSAGE_SET_ANSWER(send_msg, CMD_FUNC_ERROR);
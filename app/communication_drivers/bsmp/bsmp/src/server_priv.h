@@ -25,8 +25,13 @@
 struct message
 {
     uint8_t  command_code;
-    uint16_t payload_size;
+    uint16_t payload_size;      // Includes ext_size
     uint8_t  *payload;
+
+    // Last ext_size bytes of payload, kept outside of it (zero-copy)
+    bool     ext_enabled;
+    uint8_t  *ext_payload;
+    uint16_t ext_size;
 };
 
 struct generic_list
@@ -48,6 +53,11 @@ enum bsmp_err func_check    (struct bsmp_func *func);
 
 void          group_init    (struct bsmp_group *grp, uint8_t id);
 void          group_add_var (struct bsmp_group *grp, struct bsmp_var *var);
+void          group_compile_plans (bsmp_server_t *server);
+
+void          curve_csum_reset      (struct bsmp_curve *curve);
+void          curve_csum_invalidate (struct bsmp_curve *curve, uint16_t block);
+bool          curve_csum_step       (struct bsmp_curve *curve);
 
 SERVER_CMD_FUNCTION (query_version);
 SERVER_CMD_FUNCTION (var_query_list);
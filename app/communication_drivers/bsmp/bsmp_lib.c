@@ -32,12 +32,16 @@
 #include "communication_drivers/common/structs.h"
 #include "communication_drivers/control/control.h"
 #include "communication_drivers/i2c_onboard/eeprom.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
 #include "communication_drivers/i2c_onboard/exio.h"
 #include "communication_drivers/ipc/ipc_lib.h"
+#include "communication_drivers/ipc/ipc_cmd_queue.h"
 #include "communication_drivers/parameters/ps_parameters.h"
+#include "communication_drivers/profiler/profiler.h"
 #include "communication_drivers/psmodules/fbp_dclink/fbp_dclink.h"
 #include "communication_drivers/rs485/rs485.h"
 #include "communication_drivers/system_task/system_task.h"
+#include "communication_drivers/timer/timer.h"
 
 #include "inc/hw_memmap.h"
 #include "inc/hw_ipc.h"
@@ -50,24 +54,89 @@
 #include "driverlib/sysctl.h"
 
 #include "bsmp/include/server.h"
+#include "bsmp/src/bsmp_priv.h"
 #include "bsmp_lib.h"
 
-#define TIMEOUT_DSP_IPC_ACK     30
-
 #define SIZE_WFMREF_BLOCK       8192
 #define SIZE_SAMPLES_BUFFER     16384
 
 #define NUMBER_OF_BSMP_SERVERS  4
 #define NUMBER_OF_BSMP_CURVES   8
 
+#define PARAM_BANK_BLOCK_SIZE   1024
+
+/**
+ * Return value of BSMP functions when resource is busy
+ */
+#define FUNC_RET_BUSY           6
+
+/**
+ * Return value of BSMP functions with invalid arguments or not supported
+ */
+#define FUNC_RET_INVALID        8
+
 bsmp_server_t bsmp[NUMBER_OF_BSMP_SERVERS];
 
-volatile unsigned long ulTimeout;
-static uint8_t dummy_u8;
+static bsmp_stats_t bsmp_stats[NUMBER_OF_BSMP_SERVERS];
+
+static const uint8_t bsmp_cmd_stats_id[256] =
+{
+    [CMD_QUERY_VERSION]         = BSMP_STATS_QUERY_VERSION,
+    [CMD_VAR_QUERY_LIST]        = BSMP_STATS_VAR_QUERY_LIST,
+    [CMD_GROUP_QUERY_LIST]      = BSMP_STATS_GROUP_QUERY_LIST,
+    [CMD_GROUP_QUERY]           = BSMP_STATS_GROUP_QUERY,
+    [CMD_CURVE_QUERY_LIST]      = BSMP_STATS_CURVE_QUERY_LIST,
+    [CMD_CURVE_QUERY_CSUM]      = BSMP_STATS_CURVE_QUERY_CSUM,
+    [CMD_FUNC_QUERY_LIST]       = BSMP_STATS_FUNC_QUERY_LIST,
+    [CMD_VAR_READ]              = BSMP_STATS_VAR_READ,
+    [CMD_GROUP_READ]            = BSMP_STATS_GROUP_READ,
+    [CMD_VAR_WRITE]             = BSMP_STATS_VAR_WRITE,
+    [CMD_GROUP_WRITE]           = BSMP_STATS_GROUP_WRITE,
+    [CMD_VAR_BIN_OP]            = BSMP_STATS_VAR_BIN_OP,
+    [CMD_GROUP_BIN_OP]          = BSMP_STATS_GROUP_BIN_OP,
+    [CMD_VAR_WRITE_READ]        = BSMP_STATS_VAR_WRITE_READ,
+    [CMD_GROUP_CREATE]          = BSMP_STATS_GROUP_CREATE,
+    [CMD_GROUP_REMOVE_ALL]      = BSMP_STATS_GROUP_REMOVE_ALL,
+    [CMD_CURVE_BLOCK_REQUEST]   = BSMP_STATS_CURVE_BLOCK_REQUEST,
+    [CMD_CURVE_BLOCK]           = BSMP_STATS_CURVE_BLOCK,
+    [CMD_CURVE_RECALC_CSUM]     = BSMP_STATS_CURVE_RECALC_CSUM,
+    [CMD_FUNC_EXECUTE]          = BSMP_STATS_FUNC_EXECUTE
+};
 
 static struct bsmp_var bsmp_vars[NUMBER_OF_BSMP_SERVERS][BSMP_MAX_VARIABLES];
 static struct bsmp_curve bsmp_curves[NUMBER_OF_BSMP_SERVERS][NUMBER_OF_BSMP_CURVES];
 
+static uint32_t t_start_bsmp_func;
+
+/**
+ * Measure execution time of BSMP functions
+ */
+static void profile_bsmp_func(uint8_t func_id, bool done)
+{
+    if(done)
+    {
+        prof_record(PROF_BSMP_FUNC(func_id),
+                    get_cycle_counter() - t_start_bsmp_func);
+    }
+    else
+    {
+        t_start_bsmp_func = get_cycle_counter();
+    }
+}
+
+static void prepare_turn_on(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[p_cmd->ps_id].ps_status.bit.state = SlowRef;
+}
+
+static void complete_turn_on(ipc_cmd_t *p_cmd)
+{
+    if(g_ipc_ctom.ps_module[0].ps_status.bit.model == FBP_DCLink)
+    {
+        g_ipc_mtoc.ps_module[0].ps_setpoint.f = get_digital_potentiometer();
+    }
+}
+
 /**
  * @brief Turn on BSMP Function
  *
@@ -78,37 +147,14 @@ static struct bsmp_curve bsmp_curves[NUMBER_OF_BSMP_SERVERS][NUMBER_OF_BSMP_CURV
  */
 static uint8_t bsmp_turn_on(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Turn_On)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Turn_On, prepare_turn_on,
+                                complete_turn_on, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_status.bit.state = SlowRef;
-        send_ipc_lowpriority_msg(g_current_ps_id, Turn_On);
-
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Turn_On)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            if(g_ipc_ctom.ps_module[0].ps_status.bit.model == FBP_DCLink)
-            {
-                g_ipc_mtoc.ps_module[0].ps_setpoint.f = get_digital_potentiometer();
-            }
-
-            *output = 0;
-        }
+        *output = 6;
     }
 
     return *output;
@@ -120,6 +166,11 @@ static struct bsmp_func bsmp_func_turn_on = {
     .info.output_size = 1, // command_ack
 };
 
+static void prepare_turn_off(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[p_cmd->ps_id].ps_status.bit.state = Off;
+}
+
 /**
  * @brief Turn off BSMP Function
  *
@@ -130,27 +181,16 @@ static struct bsmp_func bsmp_func_turn_on = {
  */
 static uint8_t bsmp_turn_off(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Turn_Off)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Turn_Off, prepare_turn_off,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_status.bit.state = Off;
-        send_ipc_lowpriority_msg(g_current_ps_id, Turn_Off);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Turn_Off)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK)){
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK){
-            *output = 5;
-        }
-        else{
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -160,6 +200,11 @@ static struct bsmp_func bsmp_func_turn_off = {
     .info.output_size = 1,       // command_ack
 };
 
+static void prepare_open_loop(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[p_cmd->ps_id].ps_status.bit.openloop = 1;
+}
+
 /**
  * @brief Open loop BSMP Function
  *
@@ -170,26 +215,16 @@ static struct bsmp_func bsmp_func_turn_off = {
  */
 uint8_t bsmp_open_loop(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Open_Loop))){
-        *output = 6;
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Open_Loop, prepare_open_loop,
+                                NULL, NULL, 0))
+    {
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_status.bit.openloop = 1;
-        send_ipc_lowpriority_msg(g_current_ps_id, Open_Loop);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Open_Loop)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK)){
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK){
-            *output = 5;
-        }
-        else{
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -199,6 +234,11 @@ static struct bsmp_func bsmp_func_open_loop = {
     .info.output_size = 1,      // command_ack
 };
 
+static void prepare_closed_loop(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[p_cmd->ps_id].ps_status.bit.openloop = 0;
+}
+
 /**
  * @brief Close Loop BSMP Function
  *
@@ -209,27 +249,16 @@ static struct bsmp_func bsmp_func_open_loop = {
  */
 uint8_t bsmp_closed_loop(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Close_Loop)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Close_Loop,
+                                prepare_closed_loop, NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_status.bit.openloop = 0;
-        send_ipc_lowpriority_msg(g_current_ps_id, Close_Loop);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Close_Loop)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK)){
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK){
-            *output = 5;
-        }
-        else{
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -239,6 +268,12 @@ static struct bsmp_func bsmp_func_closed_loop = {
     .info.output_size = 1,       // command_ack
 };
 
+static void prepare_select_op_mode(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[p_cmd->ps_id].ps_status.bit.state =
+            (ps_state_t) p_cmd->data.u16[0];
+}
+
 /**
  * @brief Select operation mode BSMP Function
  *
@@ -249,29 +284,16 @@ static struct bsmp_func bsmp_func_closed_loop = {
  */
 uint8_t bsmp_select_op_mode(uint8_t *input, uint8_t *output)
 {
-
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Operating_Mode)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Operating_Mode,
+                                prepare_select_op_mode, NULL, input, 2))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_status.bit.state =
-                (ps_state_t)(input[1] << 8) | input[0];
-        send_ipc_lowpriority_msg(g_current_ps_id, Operating_Mode);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Operating_Mode)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK)){
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK){
-            *output = 5;
-        }
-        else{
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -281,6 +303,11 @@ static struct bsmp_func bsmp_func_select_op_mode = {
     .info.output_size = 1,      // command_ack
 };
 
+static void complete_reset_interlocks(ipc_cmd_t *p_cmd)
+{
+    TaskSetNew(CLEAR_ITLK_ALARM);
+}
+
 /**
  * @brief Reset interlocks BSMP Function
  *
@@ -291,30 +318,16 @@ static struct bsmp_func bsmp_func_select_op_mode = {
  */
 uint8_t bsmp_reset_interlocks(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Reset_Interlocks)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Reset_Interlocks, NULL,
+                                complete_reset_interlocks, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Reset_Interlocks);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Reset_Interlocks)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            TaskSetNew(CLEAR_ITLK_ALARM);
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -356,32 +369,18 @@ static struct bsmp_func bsmp_func_set_serial_termination = {
  */
 uint8_t bsmp_enable_buf_samples(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-
     g_ipc_mtoc.buf_samples[0].status = Buffering;
 
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Enable_Buf_Samples)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Enable_Buf_Samples, NULL,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Enable_Buf_Samples);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Enable_Buf_Samples)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout == TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -401,8 +400,6 @@ static struct bsmp_func bsmp_func_enable_buf_samples = {
  */
 uint8_t bsmp_disable_buf_samples(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-
     /**
      * TODO: It sets as Postmortem to wait buffer complete. Maybe
      * it's better to create a postmortem BSMP function
@@ -410,28 +407,16 @@ uint8_t bsmp_disable_buf_samples(uint8_t *input, uint8_t *output)
     //g_ipc_mtoc.buf_samples[0].status = Idle;
     g_ipc_mtoc.buf_samples[0].status = Postmortem;
 
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Disable_Buf_Samples)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Disable_Buf_Samples, NULL,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Disable_Buf_Samples);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Disable_Buf_Samples)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout == TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -451,7 +436,6 @@ static struct bsmp_func bsmp_func_disable_buf_samples = {
  */
 uint8_t bsmp_sync_pulse(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
     if(ipc_mtoc_busy(SYNC_PULSE))
     {
         *output = 6;
@@ -459,19 +443,7 @@ uint8_t bsmp_sync_pulse(uint8_t *input, uint8_t *output)
     else
     {
         send_ipc_msg(g_current_ps_id, SYNC_PULSE);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) & SYNC_PULSE) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 0;
     }
     return *output;
 }
@@ -482,6 +454,20 @@ static struct bsmp_func bsmp_func_sync_pulse = {
     .info.output_size = 1,      // command_ack
 };
 
+static void prepare_set_slowref(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[p_cmd->ps_id].ps_setpoint.u32 = p_cmd->data.u32[0];
+}
+
+static void complete_set_slowref(ipc_cmd_t *p_cmd)
+{
+    if(g_ipc_ctom.ps_module[0].ps_status.bit.model == FBP_DCLink)
+    {
+        SysCtlDelay(750); /// Wait 10 us for DSP update reference
+        set_digital_potentiometer(g_ipc_ctom.ps_module[0].ps_reference.f);
+    }
+}
+
 /**
  * @brief Set SlowRef setpoint BSMP Function
  *
@@ -492,41 +478,17 @@ static struct bsmp_func bsmp_func_sync_pulse = {
  */
 uint8_t bsmp_set_slowref (uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_SlowRef)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Set_SlowRef,
+                                prepare_set_slowref, complete_set_slowref,
+                                input, 4))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_setpoint.u32 = (input[3]<< 24) |
-                (input[2] << 16)|(input[1] << 8) | input[0];
-
-        send_ipc_lowpriority_msg(g_current_ps_id, Set_SlowRef);
-
-        while( (HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Set_SlowRef)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK) )
-        {
-            ulTimeout++;
-        }
-
-        if(ulTimeout == TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-
-        else
-        {
-            if(g_ipc_ctom.ps_module[0].ps_status.bit.model == FBP_DCLink)
-            {
-                SysCtlDelay(750); /// Wait 10 us for DSP update reference
-                set_digital_potentiometer(g_ipc_ctom.ps_module[0].ps_reference.f);
-            }
-
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -536,6 +498,14 @@ static struct bsmp_func bsmp_func_set_slowref = {
     .info.output_size = 1,      // command_ack
 };
 
+static void prepare_set_slowref_fbp(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.ps_module[0].ps_setpoint.u32 = p_cmd->data.u32[0];
+    g_ipc_mtoc.ps_module[1].ps_setpoint.u32 = p_cmd->data.u32[1];
+    g_ipc_mtoc.ps_module[2].ps_setpoint.u32 = p_cmd->data.u32[2];
+    g_ipc_mtoc.ps_module[3].ps_setpoint.u32 = p_cmd->data.u32[3];
+}
+
 /**
  * @brief Set SlowRef FBP BSMP Function
  *
@@ -546,39 +516,16 @@ static struct bsmp_func bsmp_func_set_slowref = {
  */
 uint8_t bsmp_set_slowref_fbp(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_SlowRef_All_PS)))
+    if(post_ipc_lowpriority_cmd(0, Set_SlowRef_All_PS, prepare_set_slowref_fbp,
+                                NULL, input, 16))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[0].ps_setpoint.u32 = (input[3]<< 24)  |
-                (input[2] << 16)  | (input[1] << 8)  | input[0];
-        g_ipc_mtoc.ps_module[1].ps_setpoint.u32 = (input[7]<< 24)  |
-                (input[6] << 16)  | (input[5] << 8)  | input[4];
-        g_ipc_mtoc.ps_module[2].ps_setpoint.u32 = (input[11]<< 24) |
-                (input[10] << 16) | (input[9] << 8)  | input[8];
-        g_ipc_mtoc.ps_module[3].ps_setpoint.u32 = (input[15]<< 24) |
-                (input[14] << 16) | (input[13] << 8) | input[12];
-
-        send_ipc_lowpriority_msg(0, Set_SlowRef_All_PS);
-
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Set_SlowRef_All_PS)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -598,29 +545,16 @@ static struct bsmp_func bsmp_func_set_slowref_fbp = {
  */
 uint8_t bsmp_reset_counters(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Reset_Counters)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Reset_Counters, NULL,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Reset_Counters);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Reset_Counters)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -663,29 +597,16 @@ static struct bsmp_func bsmp_func_scale_wfmref = {
  */
 uint8_t bsmp_reset_wfmref(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Reset_WfmRef)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Reset_WfmRef, NULL,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Reset_WfmRef);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Reset_WfmRef)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -695,6 +616,19 @@ static struct bsmp_func bsmp_func_reset_wfmref = {
     .info.output_size = 1,      // command_ack
 };
 
+static void prepare_cfg_siggen(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.siggen.type.u16         = p_cmd->data.u16[0];
+    g_ipc_mtoc.siggen.num_cycles.u16   = p_cmd->data.u16[1];
+    g_ipc_mtoc.siggen.freq.u32         = p_cmd->data.u32[1];
+    g_ipc_mtoc.siggen.amplitude.u32    = p_cmd->data.u32[2];
+    g_ipc_mtoc.siggen.offset.u32       = p_cmd->data.u32[3];
+    g_ipc_mtoc.siggen.aux_param[0].u32 = p_cmd->data.u32[4];
+    g_ipc_mtoc.siggen.aux_param[1].u32 = p_cmd->data.u32[5];
+    g_ipc_mtoc.siggen.aux_param[2].u32 = p_cmd->data.u32[6];
+    g_ipc_mtoc.siggen.aux_param[3].u32 = p_cmd->data.u32[7];
+}
+
 /**
  * @brief Configuration of SigGen BSMP function
  *
@@ -703,68 +637,20 @@ static struct bsmp_func bsmp_func_reset_wfmref = {
  */
 uint8_t bsmp_cfg_siggen(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Cfg_SigGen)))
+    if(g_ipc_ctom.siggen.enable.u16)
     {
-        *output = 6;
+        *output = 7;
+    }
+    else if(post_ipc_lowpriority_cmd(0, Cfg_SigGen, prepare_cfg_siggen, NULL,
+                                     input, 32))
+    {
+        *output = 0;
     }
     else
     {
-        if(g_ipc_ctom.siggen.enable.u16)
-        {
-            *output = 7;
-        }
-        else
-        {
-            g_ipc_mtoc.siggen.type.u16       = (input[1] << 8) | input[0];
-
-            g_ipc_mtoc.siggen.num_cycles.u16 = (input[3] << 8) | input[2];
-
-            g_ipc_mtoc.siggen.freq.u32       = (input[7]<< 24) |
-                                                  (input[6] << 16) |
-                                                  (input[5] << 8) | input[4];
-
-            g_ipc_mtoc.siggen.amplitude.u32  = (input[11]<< 24) |
-                                                  (input[10] << 16) |
-                                                  (input[9] << 8) | input[8];
-
-            g_ipc_mtoc.siggen.offset.u32     = (input[15]<< 24) |
-                                                  (input[14] << 16) |
-                                                  (input[13] << 8) | input[12];
-
-            g_ipc_mtoc.siggen.aux_param[0].u32 = (input[19]<< 24) |
-                                                    (input[18] << 16) |
-                                                    (input[17] << 8) | input[16];
-
-            g_ipc_mtoc.siggen.aux_param[1].u32 = (input[23]<< 24) |
-                                                    (input[22] << 16) |
-                                                    (input[21] << 8) | input[20];
-
-            g_ipc_mtoc.siggen.aux_param[2].u32 = (input[27]<< 24) |
-                                                    (input[26] << 16) |
-                                                    (input[25] << 8) | input[24];
-
-            g_ipc_mtoc.siggen.aux_param[3].u32 = (input[31]<< 24) |
-                                                    (input[30] << 16) |
-                                                    (input[29] << 8) | input[28];
-
-            send_ipc_lowpriority_msg(0, Cfg_SigGen);
-
-            while( (HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) & low_priority_msg_to_reg(Cfg_SigGen) ) &&
-                   (ulTimeout<TIMEOUT_DSP_IPC_ACK) )
-            {
-                ulTimeout++;
-            }
-            if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-            {
-                *output = 5;
-            }
-            else
-            {
-                *output = 0;
-            }
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -774,6 +660,13 @@ static struct bsmp_func bsmp_func_cfg_siggen = {
     .info.output_size = 1,      // command_ack
 };
 
+static void prepare_set_siggen(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.siggen.freq.u32      = p_cmd->data.u32[0];
+    g_ipc_mtoc.siggen.amplitude.u32 = p_cmd->data.u32[1];
+    g_ipc_mtoc.siggen.offset.u32    = p_cmd->data.u32[2];
+}
+
 /**
  * @brief Set continuous operation parameters of SigGen BSMP function
  *
@@ -782,43 +675,18 @@ static struct bsmp_func bsmp_func_cfg_siggen = {
  */
 uint8_t bsmp_set_siggen(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_SigGen)))
+    if(post_ipc_lowpriority_cmd(0, Set_SigGen, prepare_set_siggen,
+                                NULL, input, 12))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        g_ipc_mtoc.siggen.freq.u32       = (input[3]<< 24) |
-                                              (input[2] << 16) |
-                                              (input[1] << 8) | input[0];
-
-        g_ipc_mtoc.siggen.amplitude.u32  = (input[7]<< 24) |
-                                              (input[6] << 16) |
-                                              (input[5] << 8) | input[4];
-
-        g_ipc_mtoc.siggen.offset.u32     = (input[11]<< 24) |
-                                              (input[10] << 16) |
-                                              (input[9] << 8) | input[8];
+        *output = 6;
+    }
 
-        send_ipc_lowpriority_msg(0, Set_SigGen);
-
-        while( (HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) & low_priority_msg_to_reg(Set_SigGen) ) &&
-               (ulTimeout<TIMEOUT_DSP_IPC_ACK) )
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
-    }
-    return *output;
-}
+    return *output;
+}
 
 static struct bsmp_func bsmp_func_set_siggen = {
     .func_p           = bsmp_set_siggen,
@@ -834,29 +702,16 @@ static struct bsmp_func bsmp_func_set_siggen = {
  */
 uint8_t bsmp_enable_siggen(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Enable_SigGen)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Enable_SigGen, NULL,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Enable_SigGen);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-        low_priority_msg_to_reg(Enable_SigGen)) &&
-        (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -874,29 +729,16 @@ static struct bsmp_func bsmp_func_enable_siggen = {
  */
 uint8_t bsmp_disable_siggen(uint8_t *input, uint8_t *output)
 {
-    ulTimeout=0;
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Disable_SigGen)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Disable_SigGen, NULL,
+                                NULL, NULL, 0))
     {
-        *output = 6;
+        *output = 0;
     }
     else
     {
-        send_ipc_lowpriority_msg(g_current_ps_id, Disable_SigGen);
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-        low_priority_msg_to_reg(Disable_SigGen)) &&
-        (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            *output = 5;
-        }
-        else
-        {
-            *output = 0;
-        }
+        *output = 6;
     }
+
     return *output;
 }
 
@@ -919,34 +761,20 @@ uint8_t bsmp_set_slowref_readback(uint8_t *input, uint8_t *output)
 {
     uint8_t result;
 
-    ulTimeout = 0;
-
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_SlowRef)))
+    if(post_ipc_lowpriority_cmd(g_current_ps_id, Set_SlowRef,
+                                prepare_set_slowref, complete_set_slowref,
+                                input, 4))
     {
-        result = 6;
+        /**
+         * Readback is the latest load current, measured before the new
+         * setpoint is applied by C28
+         */
+        memcpy(output,g_controller_ctom.net_signals[g_current_ps_id].u8,4);
+        result = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[g_current_ps_id].ps_setpoint.u32 = (input[3]<< 24) |
-                (input[2] << 16)|(input[1] << 8) | input[0];
-
-        send_ipc_lowpriority_msg(g_current_ps_id, Set_SlowRef);
-
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Set_SlowRef)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            result = 5;
-        }
-        else
-        {
-            memcpy(output,g_controller_ctom.net_signals[g_current_ps_id].u8,4);
-            result = 0;
-        }
+        result = 6;
     }
 
     return result;
@@ -971,46 +799,17 @@ uint8_t bsmp_set_slowref_fbp_readback(uint8_t *input, uint8_t *output)
 {
     uint8_t result;
 
-    ulTimeout=0;
-
-    if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_SlowRef_All_PS)))
+    if(post_ipc_lowpriority_cmd(0, Set_SlowRef_All_PS, prepare_set_slowref_fbp,
+                                NULL, input, 16))
     {
-        result = 6;
+        memcpy(output,g_controller_ctom.net_signals[0].u8,16);
+        result = 0;
     }
     else
     {
-        g_ipc_mtoc.ps_module[0].ps_setpoint.u32 = (input[3]<< 24)  |
-                (input[2] << 16)  | (input[1] << 8)  | input[0];
-        g_ipc_mtoc.ps_module[1].ps_setpoint.u32 = (input[7]<< 24)  |
-                (input[6] << 16)  | (input[5] << 8)  | input[4];
-        g_ipc_mtoc.ps_module[2].ps_setpoint.u32 = (input[11]<< 24) |
-                (input[10] << 16) | (input[9] << 8)  | input[8];
-        g_ipc_mtoc.ps_module[3].ps_setpoint.u32 = (input[15]<< 24) |
-                (input[14] << 16) | (input[13] << 8) | input[12];
-
-        GPIOPinWrite(DEBUG_BASE, DEBUG_PIN, ON);
-
-        send_ipc_lowpriority_msg(0, Set_SlowRef_All_PS);
-
-        while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-                low_priority_msg_to_reg(Set_SlowRef_All_PS)) &&
-                (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-        {
-            ulTimeout++;
-        }
-
-        GPIOPinWrite(DEBUG_BASE, DEBUG_PIN, OFF);
-
-        if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-        {
-            result = 5;
-        }
-        else
-        {
-            memcpy(output,g_controller_ctom.net_signals[0].u8,16);
-            result = 0;
-        }
+        result = 6;
     }
+
     return result;
 }
 
@@ -1106,7 +905,11 @@ uint8_t bsmp_save_param_eeprom(uint8_t *input, uint8_t *output)
     n.u8[0] = input[2];
     n.u8[1] = input[3];
 
-    if( save_param_eeprom( (param_id_t) id.u16, n.u16) )
+    if(eeprom_queue_busy())
+    {
+        *output = 6;
+    }
+    else if( post_save_param_eeprom( (param_id_t) id.u16, n.u16) )
     {
         *output = 0;
     }
@@ -1165,8 +968,15 @@ static struct bsmp_func bsmp_func_load_param_eeprom = {
  */
 uint8_t bsmp_save_param_bank(uint8_t *input, uint8_t *output)
 {
-    save_param_bank();
-    *output = 0;
+    if(post_save_param_bank())
+    {
+        *output = 0;
+    }
+    else
+    {
+        *output = 6;
+    }
+
     return *output;
 }
 
@@ -1184,8 +994,16 @@ static struct bsmp_func bsmp_func_save_param_bank = {
  */
 uint8_t bsmp_load_param_bank(uint8_t *input, uint8_t *output)
 {
-    load_param_bank();
-    *output = 0;
+    if(eeprom_queue_busy())
+    {
+        *output = 6;
+    }
+    else
+    {
+        load_param_bank();
+        *output = 0;
+    }
+
     return *output;
 }
 
@@ -1195,6 +1013,92 @@ static struct bsmp_func bsmp_func_load_param_bank = {
     .info.output_size = 1,
 };
 
+/**
+ * @brief Save modified parameters into EEPROM
+ *
+ * Mode 0 posts only elements modified by set_param since last save or load
+ * into EEPROM write queue. Mode 1 compares whole bank with saved values and
+ * posts it only if any element differs. Both return busy while EEPROM write
+ * queue is occupied.
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_save_param_bank_changed(uint8_t *input, uint8_t *output)
+{
+    switch(input[0])
+    {
+        case 0:
+        {
+            if(post_save_param_bank_dirty())
+            {
+                *output = 0;
+            }
+            else
+            {
+                *output = 6;
+            }
+            break;
+        }
+
+        case 1:
+        {
+            if(post_save_param_bank_diff())
+            {
+                *output = 0;
+            }
+            else
+            {
+                *output = 6;
+            }
+            break;
+        }
+
+        default:
+        {
+            *output = 8;
+            break;
+        }
+    }
+
+    return *output;
+}
+
+static struct bsmp_func bsmp_func_save_param_bank_changed = {
+    .func_p           = bsmp_save_param_bank_changed,
+    .info.input_size  = 1,
+    .info.output_size = 1,
+};
+
+/**
+ * @brief Reset profiler
+ *
+ * Clear execution time statistics of ISRs, tasks and BSMP functions, which
+ * are read from curve 4.
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_reset_profiler(uint8_t *input, uint8_t *output)
+{
+    reset_profiler();
+
+    *output = 0;
+    return *output;
+}
+
+static struct bsmp_func bsmp_func_reset_profiler = {
+    .func_p           = bsmp_reset_profiler,
+    .info.input_size  = 0,      // Nothing is read from the input parameter
+    .info.output_size = 1,      // command_ack
+};
+
+static void prepare_dsp_coeffs(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.dsp_module.dsp_class = (dsp_class_t) p_cmd->data.u16[0];
+    g_ipc_mtoc.dsp_module.id = p_cmd->data.u16[1];
+}
+
 /**
  * @brief
  *
@@ -1205,7 +1109,6 @@ uint8_t bsmp_set_dsp_coeffs(uint8_t *input, uint8_t *output)
 {
     u_uint16_t dsp_class, id;
 
-    ulTimeout = 0;
     dsp_class.u8[0] = input[0];
     dsp_class.u8[1] = input[1];
     id.u8[0] = input[2];
@@ -1216,32 +1119,14 @@ uint8_t bsmp_set_dsp_coeffs(uint8_t *input, uint8_t *output)
     if( set_dsp_coeffs( &g_controller_mtoc, (dsp_class_t) dsp_class.u16, id.u16,
                        (float *) &input[4]) )
     {
-        if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_DSP_Coeffs)))
+        if(post_ipc_lowpriority_cmd(0, Set_DSP_Coeffs, prepare_dsp_coeffs, NULL,
+                                    input, 4))
         {
-            *output = 6;
+            *output = 0;
         }
-
         else
         {
-            g_ipc_mtoc.dsp_module.dsp_class = (dsp_class_t) dsp_class.u16;
-            g_ipc_mtoc.dsp_module.id = id.u16;
-            send_ipc_lowpriority_msg(0, Set_DSP_Coeffs);
-            while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-            low_priority_msg_to_reg(Set_DSP_Coeffs)) &&
-            (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-            {
-                ulTimeout++;
-            }
-
-            if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-            {
-                *output = 5;
-            }
-
-            else
-            {
-                *output = 0;
-            }
+            *output = 6;
         }
     }
     else
@@ -1311,7 +1196,11 @@ uint8_t bsmp_save_dsp_coeffs_eeprom(uint8_t *input, uint8_t *output)
     id.u8[0] = input[2];
     id.u8[1] = input[3];
 
-    if( save_dsp_coeffs_eeprom( (dsp_class_t) dsp_class.u16, id.u16) )
+    if(!available_eeprom_queue())
+    {
+        *output = 6;
+    }
+    else if( post_save_dsp_coeffs_eeprom( (dsp_class_t) dsp_class.u16, id.u16) )
     {
         *output = 0;
     }
@@ -1335,131 +1224,380 @@ static struct bsmp_func bsmp_func_save_dsp_coeffs_eeprom = {
  * @param uint8_t* Pointer to input packet of data
  * @param uint8_t* Pointer to output packet of data
  */
-uint8_t bsmp_load_dsp_coeffs_eeprom(uint8_t *input, uint8_t *output)
+uint8_t bsmp_load_dsp_coeffs_eeprom(uint8_t *input, uint8_t *output)
+{
+    u_uint16_t dsp_class, id;
+
+    dsp_class.u8[0] = input[0];
+    dsp_class.u8[1] = input[1];
+    id.u8[0] = input[2];
+    id.u8[1] = input[3];
+
+    if(eeprom_queue_busy())
+    {
+        *output = 6;
+    }
+    else if( load_dsp_coeffs_eeprom( (dsp_class_t) dsp_class.u16, id.u16) )
+    {
+        if(post_ipc_lowpriority_cmd(0, Set_DSP_Coeffs, prepare_dsp_coeffs, NULL,
+                                    input, 4))
+        {
+            *output = 0;
+        }
+        else
+        {
+            *output = 6;
+        }
+    }
+    else
+    {
+        *output = 8;
+    }
+
+    return *output;
+}
+
+static struct bsmp_func bsmp_func_load_dsp_coeffs_eeprom = {
+    .func_p           = bsmp_load_dsp_coeffs_eeprom,
+    .info.input_size  = 4,
+    .info.output_size = 1,
+};
+
+/**
+ * @brief
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_save_dsp_modules_eeprom(uint8_t *input, uint8_t *output)
+{
+    if(post_save_dsp_modules_eeprom())
+    {
+        *output = 0;
+    }
+    else
+    {
+        *output = 6;
+    }
+
+    return *output;
+}
+
+static struct bsmp_func bsmp_func_save_dsp_modules_eeprom = {
+    .func_p           = bsmp_save_dsp_modules_eeprom,
+    .info.input_size  = 0,
+    .info.output_size = 1,
+};
+
+/**
+ * @brief
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_load_dsp_modules_eeprom(uint8_t *input, uint8_t *output)
+{
+    if(eeprom_queue_busy())
+    {
+        *output = 6;
+    }
+    else
+    {
+        load_dsp_modules_eeprom();
+        *output = 0;
+    }
+
+    return *output;
+}
+
+static struct bsmp_func bsmp_func_load_dsp_modules_eeprom = {
+    .func_p           = bsmp_load_dsp_modules_eeprom,
+    .info.input_size  = 0,
+    .info.output_size = 1,
+};
+
+/**
+ * @brief
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_reset_udc(uint8_t *input, uint8_t *output)
+{
+    uint8_t i, reset;
+
+    reset = 1;
+
+    for(i = 0; i < NUM_MAX_PS_MODULES; i++)
+    {
+        if(g_ipc_ctom.ps_module[i].ps_status.bit.state > Interlock)
+        {
+            reset = 0;
+        }
+    }
+
+    if(reset)
+    {
+        SysCtlHoldSubSystemInReset(SYSCTL_CONTROL_SYSTEM_RES_CNF);
+        SysCtlReset();
+    }
+
+    *output = 7;
+    return *output;
+}
+
+static struct bsmp_func bsmp_func_reset_udc = {
+    .func_p           = bsmp_reset_udc,
+    .info.input_size  = 0,
+    .info.output_size = 1,
+};
+
+/**
+ * Batched BSMP functions are only built and registered once C28 firmware
+ * handles Batch_Command.
+ */
+#if IPC_BATCH_CMD_SUPPORTED
+
+/**
+ * @brief Copy payload of batched command into g_ipc_mtoc
+ *
+ * Command data is organized as: message (2), PS modules mask (2) and, for
+ * Operating_Mode, new state for each PS module (2 * NUM_MAX_PS_MODULES).
+ */
+static void prepare_batch_cmd(ipc_cmd_t *p_cmd)
+{
+    uint8_t i;
+    uint16_t ps_mask = p_cmd->data.u16[1];
+
+    for(i = 0; i < NUM_MAX_PS_MODULES; i++)
+    {
+        if(ps_mask & (1 << i))
+        {
+            switch(p_cmd->data.u16[0])
+            {
+                case Turn_On:
+                {
+                    g_ipc_mtoc.ps_module[i].ps_status.bit.state = SlowRef;
+                    break;
+                }
+
+                case Turn_Off:
+                {
+                    g_ipc_mtoc.ps_module[i].ps_status.bit.state = Off;
+                    break;
+                }
+
+                case Operating_Mode:
+                {
+                    g_ipc_mtoc.ps_module[i].ps_status.bit.state =
+                            (ps_state_t) p_cmd->data.u16[2+i];
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    g_ipc_mtoc.batch_cmd.msg = p_cmd->data.u16[0];
+    g_ipc_mtoc.batch_cmd.ps_mask = ps_mask;
+}
+
+/**
+ * @brief Execute side effects of batched command after C28 acknowledge
+ */
+static void complete_batch_cmd(ipc_cmd_t *p_cmd)
+{
+    switch(p_cmd->data.u16[0])
+    {
+        case Turn_On:
+        {
+            if( (p_cmd->data.u16[1] & 0x0001) &&
+                (g_ipc_ctom.ps_module[0].ps_status.bit.model == FBP_DCLink) )
+            {
+                g_ipc_mtoc.ps_module[0].ps_setpoint.f =
+                        get_digital_potentiometer();
+            }
+            break;
+        }
+
+        case Reset_Interlocks:
+        {
+            TaskSetNew(CLEAR_ITLK_ALARM);
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Post batched command
+ *
+ * Post a single low priority IPC message to be executed by all PS modules
+ * specified in mask.
+ *
+ * @param msg Low priority message to be executed by each PS module
+ * @param input Pointer to input packet of data, starting with PS modules mask
+ * @param size_payload Size of per-module payload in input, after mask
+ *
+ * @return command_ack
+ */
+static uint8_t post_batch_cmd(ipc_mtoc_lowpriority_msg_t msg, uint8_t *input,
+                              uint16_t size_payload)
 {
-    u_uint16_t dsp_class, id;
+    u_uint16_t data[2 + NUM_MAX_PS_MODULES];
 
-    dsp_class.u8[0] = input[0];
-    dsp_class.u8[1] = input[1];
-    id.u8[0] = input[2];
-    id.u8[1] = input[3];
+    data[0].u16 = msg;
+    data[1].u8[0] = input[0];
+    data[1].u8[1] = input[1];
 
-    if( load_dsp_coeffs_eeprom( (dsp_class_t) dsp_class.u16, id.u16) )
+    if( (data[1].u16 == 0) || (data[1].u16 >> NUM_MAX_PS_MODULES) )
     {
-        if(ipc_mtoc_busy(low_priority_msg_to_reg(Set_DSP_Coeffs)))
-        {
-            *output = 6;
-        }
-
-        else
-        {
-            g_ipc_mtoc.dsp_module.dsp_class = (dsp_class_t) dsp_class.u16;
-            g_ipc_mtoc.dsp_module.id = id.u16;
-            send_ipc_lowpriority_msg(0, Set_DSP_Coeffs);
-            while ((HWREG(MTOCIPC_BASE + IPC_O_MTOCIPCFLG) &
-            low_priority_msg_to_reg(Set_DSP_Coeffs)) &&
-            (ulTimeout<TIMEOUT_DSP_IPC_ACK))
-            {
-                ulTimeout++;
-            }
+        return FUNC_RET_INVALID;
+    }
 
-            if(ulTimeout==TIMEOUT_DSP_IPC_ACK)
-            {
-                *output = 5;
-            }
+    memcpy(&data[2], &input[2], size_payload);
 
-            else
-            {
-                *output = 0;
-            }
-        }
+    if(post_ipc_lowpriority_cmd(0, Batch_Command, prepare_batch_cmd,
+                                complete_batch_cmd, &data[0].u8[0],
+                                4 + size_payload))
+    {
+        return 0;
     }
     else
     {
-        *output = 8;
+        return 6;
     }
+}
 
+/**
+ * @brief Turn on batch BSMP Function
+ *
+ * Turn on all power supplies specified in mask, with a single IPC message.
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_turn_on_batch(uint8_t *input, uint8_t *output)
+{
+    *output = post_batch_cmd(Turn_On, input, 0);
     return *output;
 }
 
-static struct bsmp_func bsmp_func_load_dsp_coeffs_eeprom = {
-    .func_p           = bsmp_load_dsp_coeffs_eeprom,
-    .info.input_size  = 4,
-    .info.output_size = 1,
+static struct bsmp_func bsmp_func_turn_on_batch = {
+    .func_p           = bsmp_turn_on_batch,
+    .info.input_size  = 2,      // Uint16 ps_mask
+    .info.output_size = 1,      // command_ack
 };
 
 /**
- * @brief
+ * @brief Turn off batch BSMP Function
+ *
+ * Turn off all power supplies specified in mask, with a single IPC message.
  *
  * @param uint8_t* Pointer to input packet of data
  * @param uint8_t* Pointer to output packet of data
  */
-uint8_t bsmp_save_dsp_modules_eeprom(uint8_t *input, uint8_t *output)
+uint8_t bsmp_turn_off_batch(uint8_t *input, uint8_t *output)
 {
-    save_dsp_modules_eeprom();
-    *output = 0;
+    *output = post_batch_cmd(Turn_Off, input, 0);
     return *output;
 }
 
-static struct bsmp_func bsmp_func_save_dsp_modules_eeprom = {
-    .func_p           = bsmp_save_dsp_modules_eeprom,
-    .info.input_size  = 0,
-    .info.output_size = 1,
+static struct bsmp_func bsmp_func_turn_off_batch = {
+    .func_p           = bsmp_turn_off_batch,
+    .info.input_size  = 2,      // Uint16 ps_mask
+    .info.output_size = 1,      // command_ack
 };
 
 /**
- * @brief
+ * @brief Select operation mode batch BSMP Function
+ *
+ * Change operation mode for all power supplies specified in mask, with a
+ * single IPC message. Each power supply has its own operation mode.
  *
  * @param uint8_t* Pointer to input packet of data
  * @param uint8_t* Pointer to output packet of data
  */
-uint8_t bsmp_load_dsp_modules_eeprom(uint8_t *input, uint8_t *output)
+uint8_t bsmp_select_op_mode_batch(uint8_t *input, uint8_t *output)
 {
-    load_dsp_modules_eeprom();
-    *output = 0;
+    *output = post_batch_cmd(Operating_Mode, input, 2*NUM_MAX_PS_MODULES);
     return *output;
 }
 
-static struct bsmp_func bsmp_func_load_dsp_modules_eeprom = {
-    .func_p           = bsmp_load_dsp_modules_eeprom,
-    .info.input_size  = 0,
-    .info.output_size = 1,
+static struct bsmp_func bsmp_func_select_op_mode_batch = {
+    .func_p           = bsmp_select_op_mode_batch,
+    .info.input_size  = 2 + 2*NUM_MAX_PS_MODULES, // ps_mask + ps_opmode[4]
+    .info.output_size = 1,      // command_ack
 };
 
 /**
- * @brief
+ * @brief Reset interlocks batch BSMP Function
+ *
+ * Reset all interlocks for all power supplies specified in mask, with a
+ * single IPC message.
  *
  * @param uint8_t* Pointer to input packet of data
  * @param uint8_t* Pointer to output packet of data
  */
-uint8_t bsmp_reset_udc(uint8_t *input, uint8_t *output)
+uint8_t bsmp_reset_interlocks_batch(uint8_t *input, uint8_t *output)
 {
-    uint8_t i, reset;
+    *output = post_batch_cmd(Reset_Interlocks, input, 0);
+    return *output;
+}
 
-    reset = 1;
+static struct bsmp_func bsmp_func_reset_interlocks_batch = {
+    .func_p           = bsmp_reset_interlocks_batch,
+    .info.input_size  = 2,      // Uint16 ps_mask
+    .info.output_size = 1,      // command_ack
+};
 
-    for(i = 0; i < NUM_MAX_PS_MODULES; i++)
+#endif /* IPC_BATCH_CMD_SUPPORTED */
+
+/**
+ * @brief Set streaming of samples buffer BSMP Function
+ *
+ * When enabled, every completed capture of samples buffer is frozen for
+ * readout on curve 1 and the next capture is armed. Readout is never busy,
+ * and BSMP variable 21 counts frozen captures.
+ *
+ * @param uint8_t* Pointer to input packet of data
+ * @param uint8_t* Pointer to output packet of data
+ */
+uint8_t bsmp_set_buf_samples_stream(uint8_t *input, uint8_t *output)
+{
+    if(input[0] > 1)
     {
-        if(g_ipc_ctom.ps_module[i].ps_status.bit.state > Interlock)
+        *output = 8;
+    }
+    else
+    {
+        if(input[0])
         {
-            reset = 0;
+            enable_buf_samples_stream(g_current_ps_id);
+        }
+        else
+        {
+            disable_buf_samples_stream();
         }
-    }
 
-    if(reset)
-    {
-        SysCtlHoldSubSystemInReset(SYSCTL_CONTROL_SYSTEM_RES_CNF);
-        SysCtlReset();
+        *output = 0;
     }
 
-    *output = 7;
     return *output;
 }
 
-static struct bsmp_func bsmp_func_reset_udc = {
-    .func_p           = bsmp_reset_udc,
-    .info.input_size  = 0,
-    .info.output_size = 1,
+static struct bsmp_func bsmp_func_set_buf_samples_stream = {
+    .func_p           = bsmp_set_buf_samples_stream,
+    .info.input_size  = 1,      // 0: disable, 1: enable
+    .info.output_size = 1,      // command_ack
 };
 
 /**
@@ -1671,6 +1809,11 @@ static bool write_block_wfmref(struct bsmp_curve *curve, uint16_t block,
 }
 
 /**
+ * Curve 1 isn't a live view of C28 samples buffer: it's a copy of the last
+ * completed capture, refreshed by the idle task only. A new capture replaces
+ * it as soon as it completes, unless an answer is being transmitted. BSMP
+ * variable 21 counts frozen captures, so a client reads it before and after
+ * reading the curve to check that all blocks belong to the same capture.
  *
  * @param curve
  * @param block
@@ -1684,9 +1827,34 @@ static bool read_block_buf_samples_ctom(struct bsmp_curve *curve, uint16_t block
     uint8_t *block_data;
     uint16_t block_size = curve->info.block_size;
 
-    block_data = &(g_buf_samples_ctom[(block*block_size) >> 2].u8);
+    /**
+     * Last capture is frozen on readout buffer, so it can be read while C28
+     * acquires the next one
+     */
+    block_data = &(g_buf_samples_readout_data[(block*block_size) >> 2].u8);
+
+    memcpy(data, block_data, block_size);
+    *len = block_size;
+    return true;
+}
+
+/**
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool read_block_buf_samples_mtoc(struct bsmp_curve *curve, uint16_t block,
+                                        uint8_t *data, uint16_t *len)
+{
+    uint8_t *block_data;
+    uint16_t block_size = curve->info.block_size;
+
+    block_data = &(g_buf_samples_mtoc[(block*block_size) >> 2].u8);
 
-    if(g_ipc_ctom.buf_samples[0].status == Idle)
+    if(g_ipc_mtoc.buf_samples[0].status == Idle)
     {
         memcpy(data, block_data, block_size);
         *len = block_size;
@@ -1699,6 +1867,8 @@ static bool read_block_buf_samples_ctom(struct bsmp_curve *curve, uint16_t block
 }
 
 /**
+ * Map functions return the address of curve blocks in shared RAM, so block
+ * reads are sent from there without being copied into the answer.
  *
  * @param curve
  * @param block
@@ -1706,17 +1876,57 @@ static bool read_block_buf_samples_ctom(struct bsmp_curve *curve, uint16_t block
  * @param len
  * @return
  */
-static bool read_block_buf_samples_mtoc(struct bsmp_curve *curve, uint16_t block,
-                                        uint8_t *data, uint16_t *len)
+static bool map_block_wfmref(struct bsmp_curve *curve, uint16_t block,
+                             uint8_t **data, uint16_t *len)
 {
-    uint8_t *block_data;
     uint16_t block_size = curve->info.block_size;
 
-    block_data = &(g_buf_samples_mtoc[(block*block_size) >> 2].u8);
+    if(g_ipc_ctom.wfmref.wfmref_data.status == Idle)
+    {
+        *data = (uint8_t *) &(g_wfmref[(block*block_size) >> 2].u8);
+        *len = block_size;
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+/**
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool map_block_buf_samples_ctom(struct bsmp_curve *curve, uint16_t block,
+                                       uint8_t **data, uint16_t *len)
+{
+    uint16_t block_size = curve->info.block_size;
+
+    *data = (uint8_t *) &(g_buf_samples_readout_data[(block*block_size) >> 2].u8);
+    *len = block_size;
+    return true;
+}
+
+/**
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool map_block_buf_samples_mtoc(struct bsmp_curve *curve, uint16_t block,
+                                       uint8_t **data, uint16_t *len)
+{
+    uint16_t block_size = curve->info.block_size;
 
     if(g_ipc_mtoc.buf_samples[0].status == Idle)
     {
-        memcpy(data, block_data, block_size);
+        *data = (uint8_t *) &(g_buf_samples_mtoc[(block*block_size) >> 2].u8);
         *len = block_size;
         return true;
     }
@@ -1726,6 +1936,85 @@ static bool read_block_buf_samples_mtoc(struct bsmp_curve *curve, uint16_t block
     }
 }
 
+/**
+ * Parameters bank is seen as a flat array of float elements, so a whole
+ * configuration is read in a few block requests instead of one get_param
+ * per element.
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool read_block_param_bank(struct bsmp_curve *curve, uint16_t block,
+                                  uint8_t *data, uint16_t *len)
+{
+    uint16_t num_elements = curve->info.block_size >> 2;
+
+    *len = get_param_bank(block*num_elements, num_elements, data) << 2;
+    return true;
+}
+
+/**
+ * Block is validated as a whole and then applied atomically. It may be
+ * shorter than block size, to set only the first elements of block.
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool write_block_param_bank(struct bsmp_curve *curve, uint16_t block,
+                                   uint8_t *data, uint16_t len)
+{
+    uint16_t num_elements = curve->info.block_size >> 2;
+
+    if(len & 0x3)
+    {
+        return false;
+    }
+
+    return set_param_bank(block*num_elements, len >> 2, data);
+}
+
+/**
+ * Profiler entries, as an array of prof_entry_t indexed by prof_id_t
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool read_block_profiler(struct bsmp_curve *curve, uint16_t block,
+                                uint8_t *data, uint16_t *len)
+{
+    *len = get_profiler_entries(block*PROF_ENTRIES_PER_BLOCK,
+                                PROF_ENTRIES_PER_BLOCK, data) *
+           sizeof(prof_entry_t);
+    return true;
+}
+
+/**
+ * Per command statistics of server, as an array of bsmp_cmd_stats_t indexed
+ * by bsmp_cmd_stats_id_t
+ *
+ * @param curve
+ * @param block
+ * @param data
+ * @param len
+ * @return
+ */
+static bool read_block_bsmp_stats(struct bsmp_curve *curve, uint16_t block,
+                                  uint8_t *data, uint16_t *len)
+{
+    memcpy(data, curve->user, curve->info.block_size);
+    *len = curve->info.block_size;
+    return true;
+}
+
 /**
  *
  * @param curve
@@ -1755,6 +2044,7 @@ void bsmp_init(uint8_t server)
      */
     bsmp_server_init(&bsmp[server]);
     //bsmp_register_hook(&bsmp, hook);
+    bsmp_register_func_hook(&bsmp[server], profile_bsmp_func);
 
     /**
      * BSMP Function Register
@@ -1801,6 +2091,15 @@ void bsmp_init(uint8_t server)
     bsmp_register_function(&bsmp[server], &bsmp_func_save_dsp_modules_eeprom);  // ID 39
     bsmp_register_function(&bsmp[server], &bsmp_func_load_dsp_modules_eeprom);  // ID 40
     bsmp_register_function(&bsmp[server], &bsmp_func_reset_udc);                // ID 41
+    bsmp_register_function(&bsmp[server], &bsmp_func_set_buf_samples_stream);   // ID 42
+    bsmp_register_function(&bsmp[server], &bsmp_func_save_param_bank_changed);  // ID 43
+    bsmp_register_function(&bsmp[server], &bsmp_func_reset_profiler);           // ID 44
+#if IPC_BATCH_CMD_SUPPORTED
+    bsmp_register_function(&bsmp[server], &bsmp_func_turn_on_batch);            // ID 45
+    bsmp_register_function(&bsmp[server], &bsmp_func_turn_off_batch);           // ID 46
+    bsmp_register_function(&bsmp[server], &bsmp_func_select_op_mode_batch);     // ID 47
+    bsmp_register_function(&bsmp[server], &bsmp_func_reset_interlocks_batch);   // ID 48
+#endif
 
     /**
      * BSMP Variable Register
@@ -1828,13 +2127,13 @@ void bsmp_init(uint8_t server)
     create_bsmp_var(20, server, 4, false, g_ipc_ctom.wfmref.wfmref_data.p_buf_idx.u8);
 
     /**
-     * Dummy variables to fulfill common variables
+     * Sequence number of capture frozen on curve 1
      */
-    uint8_t i;
-    for(i = 21; i < 25; i++)
-    {
-        create_bsmp_var(i, server, 1, false, &dummy_u8);
-    }
+    create_bsmp_var(21, server, 4, false, g_buf_samples_readout.generation.u8);
+    create_bsmp_var(22, server, 1, false, &g_eeprom_queue_stats.status);
+    create_bsmp_var(23, server, 4, false, g_eeprom_queue_stats.pending_bytes.u8);
+    create_bsmp_var(24, server, sizeof(bsmp_stats_summary_t), false,
+                    (volatile uint8_t *) &bsmp_stats[server].summary);
 
     /**
      * BSMP Curves Register
@@ -1845,6 +2144,84 @@ void bsmp_init(uint8_t server)
                       write_block_dummy);
     create_bsmp_curve(2, server, 16, 1024, false, read_block_buf_samples_mtoc,
                       write_block_dummy);
+    create_bsmp_curve(3, server,
+                      (4*get_param_bank_size() + PARAM_BANK_BLOCK_SIZE - 1) /
+                      PARAM_BANK_BLOCK_SIZE, PARAM_BANK_BLOCK_SIZE, true,
+                      read_block_param_bank, write_block_param_bank);
+    create_bsmp_curve(4, server,
+                      (PROF_NUM_ENTRIES + PROF_ENTRIES_PER_BLOCK - 1) /
+                      PROF_ENTRIES_PER_BLOCK,
+                      PROF_ENTRIES_PER_BLOCK * sizeof(prof_entry_t), false,
+                      read_block_profiler, write_block_dummy);
+    create_bsmp_curve(5, server, 1,
+                      NUM_BSMP_CMD_STATS * sizeof(bsmp_cmd_stats_t), false,
+                      read_block_bsmp_stats, write_block_dummy);
+
+    bsmp_curves[server][0].map_block = map_block_wfmref;
+    bsmp_curves[server][1].map_block = map_block_buf_samples_ctom;
+    bsmp_curves[server][2].map_block = map_block_buf_samples_mtoc;
+
+    bsmp_curves[server][5].user = bsmp_stats[server].cmd;
+}
+
+/**
+ * @brief Update BSMP statistics
+ *
+ * Account processed request on its command code statistics and on server
+ * summary. Latency is the processing time of request, excluding reception
+ * and transmission of messages.
+ *
+ * @param server ID of BSMP server
+ * @param recv_packet Pointer to processed request
+ * @param send_packet Pointer to answer
+ * @param cycles Processing time in M3 clock cycles
+ */
+static void update_bsmp_stats(uint8_t server,
+                              struct bsmp_raw_packet *recv_packet,
+                              struct bsmp_raw_packet *send_packet,
+                              uint32_t cycles)
+{
+    uint8_t answer;
+    uint16_t bin;
+    uint32_t latency_us;
+    bsmp_stats_summary_t *p_summary = &bsmp_stats[server].summary;
+    bsmp_cmd_stats_t *p_cmd = &bsmp_stats[server].cmd[BSMP_STATS_OTHER];
+
+    if(recv_packet->len)
+    {
+        p_cmd = &bsmp_stats[server].cmd[bsmp_cmd_stats_id[recv_packet->data[0]]];
+    }
+
+    answer = send_packet->data[0];
+
+    p_cmd->count++;
+    p_summary->requests++;
+
+    if( (answer >= CMD_ERR_MALFORMED_MESSAGE) || (answer == CMD_FUNC_ERROR) )
+    {
+        p_cmd->errors++;
+        p_summary->errors++;
+
+        if( (answer == CMD_ERR_RESOURCE_BUSY) ||
+            ( (answer == CMD_FUNC_ERROR) &&
+              (send_packet->data[BSMP_HEADER_SIZE] == FUNC_RET_BUSY) ) )
+        {
+            p_cmd->busy++;
+            p_summary->busy++;
+        }
+    }
+
+    bin = 0;
+    latency_us = (cycles / CYCLES_PER_US) >> 1;
+
+    while(latency_us && (bin < BSMP_LATENCY_BINS - 1))
+    {
+        latency_us >>= 1;
+        bin++;
+    }
+
+    p_cmd->hist[bin]++;
+    p_summary->hist[bin]++;
 }
 
 /**
@@ -1860,7 +2237,58 @@ void bsmp_init(uint8_t server)
 void BSMPprocess(struct bsmp_raw_packet *recv_packet,
                  struct bsmp_raw_packet *send_packet, uint8_t server)
 {
+    uint32_t t_start = get_cycle_counter();
+
+    bsmp_stats[server].summary.ipc_timeouts = g_ipc_cmd_queue_stats.timeouts;
+    bsmp_stats[server].summary.ipc_last_error =
+            g_ipc_cmd_queue_stats.last_error;
+    bsmp_stats[server].summary.ipc_last_error_msg =
+            g_ipc_cmd_queue_stats.last_error_msg;
+    bsmp_stats[server].summary.ipc_last_error_ps_id =
+            g_ipc_cmd_queue_stats.last_error_ps_id;
+    bsmp_stats[server].summary.ipc_pending = size_ipc_cmd_queue();
+
     bsmp_process_packet(&bsmp[server], recv_packet, send_packet);
+
+    update_bsmp_stats(server, recv_packet, send_packet,
+                      get_cycle_counter() - t_start);
+}
+
+/**
+ * @brief Update checksum of BSMP curves
+ *
+ * Hash next block of the first writable curve whose checksum is outdated,
+ * so CMD_CURVE_QUERY_CSUM answers with an up to date checksum without
+ * hashing the whole curve on request. To be called on background.
+ */
+void bsmp_update_curves_csum(void)
+{
+    static uint32_t param_bank_generation = 0;
+    uint8_t server;
+
+    /**
+     * Parameters may be modified without going through BSMP
+     */
+    if(param_bank_generation != g_param_bank_generation)
+    {
+        param_bank_generation = g_param_bank_generation;
+
+        for(server = 0; server < NUMBER_OF_BSMP_SERVERS; server++)
+        {
+            if(bsmp[server].curves.count > 3)
+            {
+                bsmp_invalidate_csum(&bsmp_curves[server][3]);
+            }
+        }
+    }
+
+    for(server = 0; server < NUMBER_OF_BSMP_SERVERS; server++)
+    {
+        if(bsmp_update_csum(&bsmp[server]))
+        {
+            return;
+        }
+    }
 }
 
 /**
@@ -1899,6 +2327,9 @@ void create_bsmp_var(uint8_t var_id, uint8_t server, uint8_t size,
  *      1. Both new and old variables have the same size
  *      2. Both new and old variables are either R/W or R
  *
+ * Read plans of groups hold variable addresses, so they're compiled again on
+ * next group read.
+ *
  * TODO: include protection for invalid variables
  *
  * @param var_id ID for BSMP variable to be modified
@@ -1908,6 +2339,7 @@ void create_bsmp_var(uint8_t var_id, uint8_t server, uint8_t size,
 void modify_bsmp_var(uint8_t var_id, uint8_t server, volatile uint8_t *p_var)
 {
     bsmp_vars[server][var_id].data = p_var;
+    bsmp[server].group_plans_ok = false;
 }
 
 /**
@@ -10,9 +10,86 @@
 
 #include "bsmp/include/server.h"
 
+/**
+ * Latency histogram bins: bin n counts requests processed in [2^n, 2^(n+1))
+ * us. First bin includes faster requests and last bin includes slower ones.
+ */
+#define BSMP_LATENCY_BINS   16
+
+/**
+ * Command codes with their own statistics. Other codes, including invalid
+ * ones, are accounted as BSMP_STATS_OTHER.
+ */
+typedef enum
+{
+    BSMP_STATS_OTHER,
+    BSMP_STATS_QUERY_VERSION,
+    BSMP_STATS_VAR_QUERY_LIST,
+    BSMP_STATS_GROUP_QUERY_LIST,
+    BSMP_STATS_GROUP_QUERY,
+    BSMP_STATS_CURVE_QUERY_LIST,
+    BSMP_STATS_CURVE_QUERY_CSUM,
+    BSMP_STATS_FUNC_QUERY_LIST,
+    BSMP_STATS_VAR_READ,
+    BSMP_STATS_GROUP_READ,
+    BSMP_STATS_VAR_WRITE,
+    BSMP_STATS_GROUP_WRITE,
+    BSMP_STATS_VAR_BIN_OP,
+    BSMP_STATS_GROUP_BIN_OP,
+    BSMP_STATS_VAR_WRITE_READ,
+    BSMP_STATS_GROUP_CREATE,
+    BSMP_STATS_GROUP_REMOVE_ALL,
+    BSMP_STATS_CURVE_BLOCK_REQUEST,
+    BSMP_STATS_CURVE_BLOCK,
+    BSMP_STATS_CURVE_RECALC_CSUM,
+    BSMP_STATS_FUNC_EXECUTE,
+    NUM_BSMP_CMD_STATS
+} bsmp_cmd_stats_id_t;
+
+/**
+ * Statistics of a command code. Errors are error answers and function
+ * errors, and busy are CMD_ERR_RESOURCE_BUSY answers and functions which
+ * returned 6 (busy). All counters wrap around, so the client is expected to
+ * compute differences between readings.
+ */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    errors;
+    uint32_t    busy;
+    uint16_t    hist[BSMP_LATENCY_BINS];
+} bsmp_cmd_stats_t;
+
+/**
+ * Summary of all commands of a server, plus status of IPC command queue,
+ * which is shared by all servers. BSMP functions return as soon as their IPC
+ * command is queued, so C28 acknowledge timeouts are only reported here, by
+ * ```ipc_timeouts``` and by last IPC error (```ipc_cmd_error_t```, message
+ * and PS module of the failed command).
+ */
+typedef struct
+{
+    uint32_t    requests;
+    uint32_t    errors;
+    uint32_t    busy;
+    uint32_t    ipc_timeouts;
+    uint16_t    ipc_last_error;
+    uint16_t    ipc_last_error_msg;
+    uint16_t    ipc_last_error_ps_id;
+    uint16_t    ipc_pending;
+    uint32_t    hist[BSMP_LATENCY_BINS];
+} bsmp_stats_summary_t;
+
+typedef struct
+{
+    bsmp_stats_summary_t    summary;
+    bsmp_cmd_stats_t        cmd[NUM_BSMP_CMD_STATS];
+} bsmp_stats_t;
+
 extern void BSMPprocess(struct bsmp_raw_packet *recv_packet,
                         struct bsmp_raw_packet *send_packet, uint8_t server);
 extern void bsmp_init(uint8_t server);
+extern void bsmp_update_curves_csum(void);
 extern void create_bsmp_var(uint8_t var_id, uint8_t server, uint8_t size,
                             bool writable, volatile uint8_t *p_var);
 extern void modify_bsmp_var(uint8_t var_id, uint8_t server,
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file crc32.c
+ * @brief CRC-32 module.
+ *
+ * Reflected CRC-32, polynomial 0x04C11DB7, computed one nibble at a time
+ * with a 16 entries table, which is small enough to stay in flash without
+ * noticeable cost for the few kilobytes it's used on.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include "crc32.h"
+
+static const uint32_t crc32_table[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/**
+ * Update CRC-32 with new data. Start with ```crc``` equal to 0, and use the
+ * result as ```crc``` to continue the calculation over more data.
+ *
+ * @param crc CRC-32 of previous data
+ * @param p_data pointer to data
+ * @param size number of bytes
+ * @return CRC-32 of previous and new data
+ */
+uint32_t crc32(uint32_t crc, const uint8_t *p_data, uint32_t size)
+{
+    crc = ~crc;
+
+    while(size--)
+    {
+        crc ^= *(p_data++);
+        crc = (crc >> 4) ^ crc32_table[crc & 0x0F];
+        crc = (crc >> 4) ^ crc32_table[crc & 0x0F];
+    }
+
+    return ~crc;
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file crc32.h
+ * @brief CRC-32 module.
+ *
+ * CRC-32 (IEEE 802.3) calculation, used to protect data stored on
+ * non-volatile memories.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#include <stdint.h>
+
+extern uint32_t crc32(uint32_t crc, const uint8_t *p_data, uint32_t size);
+
+#endif /* CRC32_H_ */
@@ -36,6 +36,21 @@ void init_buffer(buf_t *p_buf, volatile float *p_buf_start, uint16_t size)
     reset_buffer(p_buf);
 }
 
+/**
+ * Initialization for an instance of ```buf_t```, without clearing its values.
+ * Intended for buffers sharing an array already cleared by ```init_buffer```.
+ *
+ * @param p_buf pointer to buffer structure
+ * @param p_buf_start pointer to the first element of the pre-defined array
+ * @param size number of elements on the array used by the buffer
+ */
+void init_buffer_lazy(buf_t *p_buf, volatile float *p_buf_start, uint16_t size)
+{
+    p_buf->p_buf_start.f = p_buf_start;
+    p_buf->p_buf_end.f = p_buf_start + size - 1;
+    rewind_buffer(p_buf);
+}
+
 /**
  * Set values from buffer to 0 and reset index pointer
  *
@@ -54,6 +69,17 @@ void reset_buffer(buf_t *p_buf)
     p_buf->p_buf_idx = p_buf->p_buf_start;
 }
 
+/**
+ * Reset index pointer, without clearing values from buffer
+ *
+ * @param p_buf pointer to buffer structure
+ */
+void rewind_buffer(buf_t *p_buf)
+{
+    p_buf->status = Idle;
+    p_buf->p_buf_idx = p_buf->p_buf_start;
+}
+
 /**
  * Enable specified buffer
  *
@@ -191,6 +217,56 @@ uint16_t test_buffer_limits(buf_t *p_buf, float value, float tol)
     return 0;
 }
 
+/**
+ * Initialization for an instance of ```buf_readout_t```
+ *
+ * @param p_readout pointer to readout structure
+ * @param p_buf pointer to source buffer
+ * @param p_src pointer to the first element of the source array
+ * @param p_data pointer to the first element of the readout array
+ * @param size number of elements on the readout array
+ */
+void init_buffer_readout(buf_readout_t *p_readout, buf_t *p_buf,
+                         volatile float *p_src, volatile float *p_data,
+                         uint16_t size)
+{
+    p_readout->p_buf = p_buf;
+    p_readout->p_src = p_src;
+    p_readout->p_data = p_data;
+    p_readout->size = size;
+    p_readout->last_status = Idle;
+    p_readout->generation.u32 = 0;
+}
+
+/**
+ * Check whether source buffer completed a capture, and freeze it into the
+ * readout array if so
+ *
+ * @param p_readout pointer to readout structure
+ * @return indicate whether a new capture was frozen
+ */
+uint16_t update_buffer_readout(buf_readout_t *p_readout)
+{
+    uint16_t i;
+    buf_status_t status;
+
+    status = p_readout->p_buf->status;
+
+    if( (status == Idle) && (p_readout->last_status != Idle) )
+    {
+        for(i = 0; i < p_readout->size; i++)
+        {
+            p_readout->p_data[i] = p_readout->p_src[i];
+        }
+
+        p_readout->generation.u32++;
+        p_readout->last_status = Idle;
+        return 1;
+    }
+
+    p_readout->last_status = status;
+    return 0;
+}
 
 /**
  * TODO: Put here the implementation for your private functions.
@@ -63,6 +63,26 @@ typedef struct
     u_p_float_t     p_buf_idx;
 } buf_t;
 
+/**
+ * Readout copy of a buffer filled by the other core. Every completed capture
+ * (transition from ```Buffering``` or ```Postmortem``` to ```Idle```) is
+ * frozen on a separate array, so it can be read while the next capture is
+ * acquired on the original buffer. ```generation``` counts frozen captures,
+ * so readers can tell which capture they got.
+ *
+ * Pointers on source buffer may belong to the other core memory map, so
+ * captured data is copied from ```p_src``` instead.
+ */
+typedef struct
+{
+    buf_t           *p_buf;
+    volatile float  *p_src;
+    volatile float  *p_data;
+    uint16_t        size;
+    buf_status_t    last_status;
+    u_uint32_t      generation;
+} buf_readout_t;
+
 /**
  * Initialization for an instance of ```buf_t```. It requires a pre-defined
  * ```float``` array, addressed by ```p_buf_start```
@@ -74,6 +94,17 @@ typedef struct
 extern void init_buffer(buf_t *p_buf, volatile float *p_buf_start,
                         uint16_t size);
 
+/**
+ * Initialization for an instance of ```buf_t```, without clearing its values.
+ * Intended for buffers sharing an array already cleared by ```init_buffer```.
+ *
+ * @param p_buf pointer to buffer structure
+ * @param p_buf_start pointer to the first element of the pre-defined array
+ * @param size number of elements on the array used by the buffer
+ */
+extern void init_buffer_lazy(buf_t *p_buf, volatile float *p_buf_start,
+                             uint16_t size);
+
 /**
  * Set values from buffer to 0 and reset index pointer
  *
@@ -81,6 +112,13 @@ extern void init_buffer(buf_t *p_buf, volatile float *p_buf_start,
  */
 extern void reset_buffer(buf_t *p_buf);
 
+/**
+ * Reset index pointer, without clearing values from buffer
+ *
+ * @param p_buf pointer to buffer structure
+ */
+extern void rewind_buffer(buf_t *p_buf);
+
 /**
  * Enable specified buffer
  *
@@ -132,4 +170,26 @@ extern uint16_t insert_buffer(buf_t *p_buf, float data);
  */
 extern uint16_t test_buffer_limits(buf_t *p_buf, float value, float tol);
 
+/**
+ * Initialization for an instance of ```buf_readout_t```
+ *
+ * @param p_readout pointer to readout structure
+ * @param p_buf pointer to source buffer
+ * @param p_src pointer to the first element of the source array
+ * @param p_data pointer to the first element of the readout array
+ * @param size number of elements on the readout array
+ */
+extern void init_buffer_readout(buf_readout_t *p_readout, buf_t *p_buf,
+                                volatile float *p_src, volatile float *p_data,
+                                uint16_t size);
+
+/**
+ * Check whether source buffer completed a capture, and freeze it into the
+ * readout array if so
+ *
+ * @param p_readout pointer to readout structure
+ * @return indicate whether a new capture was frozen
+ */
+extern uint16_t update_buffer_readout(buf_readout_t *p_readout);
+
 #endif /* STRUCTS_H_ */
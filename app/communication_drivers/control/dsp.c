@@ -568,7 +568,7 @@ void init_dsp_vect_product(dsp_vect_product_t *p_vect_product, uint16_t num_rows
         {
             for(c = 0; c < p_vect_product->matrix.coeffs.s.num_cols; c++)
             {
-                p_vect_product->matrix.coeffs.s.data[r][c] = matrix[num_rows][num_cols];
+                p_vect_product->matrix.coeffs.s.data[r][c] = matrix[r][c];
 
             }
         }
@@ -594,16 +594,22 @@ void reset_dsp_vect_product(dsp_vect_product_t *p_vect_product)
  */
 void run_dsp_vect_product(dsp_vect_product_t *p_vect_product)
 {
-    uint16_t r, c;
+    uint16_t r, c, num_rows, num_cols;
+    float acc;
 
-    for(r = 0; r < p_vect_product->matrix.coeffs.s.num_rows; r++)
+    num_rows = (uint16_t) p_vect_product->matrix.coeffs.s.num_rows;
+    num_cols = (uint16_t) p_vect_product->matrix.coeffs.s.num_cols;
+
+    for(r = 0; r < num_rows; r++)
     {
-        p_vect_product->out[r] = 0.0;
+        acc = 0.0;
 
-        for(c = 0; c < p_vect_product->matrix.coeffs.s.num_cols; c++)
+        for(c = 0; c < num_cols; c++)
         {
-            p_vect_product->out[r] += p_vect_product->matrix.coeffs.s.data[r][c]*
-                                      p_vect_product->in[c];
+            acc += p_vect_product->matrix.coeffs.s.data[r][c] *
+                   p_vect_product->in[c];
         }
+
+        p_vect_product->out[r] = acc;
     }
 }
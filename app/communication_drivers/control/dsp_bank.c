@@ -0,0 +1,427 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_bank.c
+ * @brief Banks of DSP modules
+ *
+ * Batch kernels over banks of DSP modules stored as structure of arrays.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include "dsp_bank.h"
+
+/**
+ * Load bank of 1st-order digital low-pass filters from array of modules,
+ * including coefficients, states and signals. It must be called again
+ * whenever modules are reconfigured.
+ *
+ * @param p_bank
+ * @param p_lpf
+ * @param num
+ * @return Number of modules loaded
+ */
+uint16_t load_dsp_lpf_bank(dsp_lpf_bank_t *p_bank, dsp_lpf_t *p_lpf,
+                           uint16_t num)
+{
+    uint16_t i;
+
+    if(num > DSP_BANK_SIZE)
+    {
+        num = DSP_BANK_SIZE;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+        p_bank->k[i] = p_lpf[i].k;
+        p_bank->a[i] = p_lpf[i].a;
+        p_bank->in_old[i] = p_lpf[i].in_old;
+        p_bank->in[i] = p_lpf[i].in;
+        p_bank->out[i] = p_lpf[i].out;
+    }
+
+    p_bank->num = num;
+
+    return num;
+}
+
+/**
+ * Store states of bank of 1st-order digital low-pass filters back to array
+ * of modules.
+ *
+ * @param p_bank
+ * @param p_lpf
+ */
+void store_dsp_lpf_bank(dsp_lpf_bank_t *p_bank, dsp_lpf_t *p_lpf)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_lpf[i].in_old = p_bank->in_old[i];
+    }
+}
+
+/**
+ * Reset bank of 1st-order digital low-pass filters.
+ *
+ * @param p_bank
+ */
+void reset_dsp_lpf_bank(dsp_lpf_bank_t *p_bank)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_bank->in_old[i] = 0.0;
+        *(p_bank->out[i]) = 0.0;
+    }
+}
+
+/**
+ * Run bank of 1st-order digital low-pass filters. Each filter gives the
+ * same result as run_dsp_lpf().
+ *
+ * @param p_bank
+ */
+void run_dsp_lpf_bank(dsp_lpf_bank_t *p_bank)
+{
+    uint16_t i;
+    float in, yacc;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        in = *(p_bank->in[i]);
+
+        yacc = *(p_bank->out[i]) * p_bank->a[i];
+        yacc += p_bank->k[i] * (p_bank->in_old[i] + in);
+        p_bank->in_old[i] = in;
+        *(p_bank->out[i]) = yacc;
+    }
+}
+
+/**
+ * Load bank of PI controllers from array of modules, including
+ * coefficients, states and signals. It must be called again whenever
+ * modules are reconfigured.
+ *
+ * @param p_bank
+ * @param p_pi
+ * @param num
+ * @return Number of modules loaded
+ */
+uint16_t load_dsp_pi_bank(dsp_pi_bank_t *p_bank, dsp_pi_t *p_pi, uint16_t num)
+{
+    uint16_t i;
+
+    if(num > DSP_BANK_SIZE)
+    {
+        num = DSP_BANK_SIZE;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+        p_bank->kp[i] = p_pi[i].coeffs.s.kp;
+        p_bank->ki[i] = p_pi[i].coeffs.s.ki;
+        p_bank->u_max[i] = p_pi[i].coeffs.s.u_max;
+        p_bank->u_min[i] = p_pi[i].coeffs.s.u_min;
+        p_bank->u_prop[i] = p_pi[i].u_prop;
+        p_bank->u_int[i] = p_pi[i].u_int;
+        p_bank->in[i] = p_pi[i].in;
+        p_bank->out[i] = p_pi[i].out;
+    }
+
+    p_bank->num = num;
+
+    return num;
+}
+
+/**
+ * Store states of bank of PI controllers back to array of modules.
+ *
+ * @param p_bank
+ * @param p_pi
+ */
+void store_dsp_pi_bank(dsp_pi_bank_t *p_bank, dsp_pi_t *p_pi)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_pi[i].u_prop = p_bank->u_prop[i];
+        p_pi[i].u_int = p_bank->u_int[i];
+    }
+}
+
+/**
+ * Reset bank of PI controllers.
+ *
+ * @param p_bank
+ */
+void reset_dsp_pi_bank(dsp_pi_bank_t *p_bank)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_bank->u_prop[i] = 0.0;
+        p_bank->u_int[i] = 0.0;
+        *(p_bank->out[i]) = 0.0;
+    }
+}
+
+/**
+ * Run bank of PI controllers. Each controller gives the same result as
+ * run_dsp_pi().
+ *
+ * @param p_bank
+ */
+void run_dsp_pi_bank(dsp_pi_bank_t *p_bank)
+{
+    uint16_t i;
+    float in, dyn_max, dyn_min, u_prop, u_int;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        in = *(p_bank->in[i]);
+
+        u_prop = in * p_bank->kp[i];
+        SATURATE(u_prop, p_bank->u_max[i], p_bank->u_min[i]);
+        p_bank->u_prop[i] = u_prop;
+
+        dyn_max = (p_bank->u_max[i] - u_prop);
+        dyn_min = (p_bank->u_min[i] - u_prop);
+
+        u_int = p_bank->u_int[i] + in * p_bank->ki[i];
+        SATURATE(u_int, dyn_max, dyn_min);
+        p_bank->u_int[i] = u_int;
+
+        *(p_bank->out[i]) = u_int + u_prop;
+    }
+}
+
+/**
+ * Load bank of 2nd-order digital IIR filters from array of modules,
+ * including coefficients, states and signals. It must be called again
+ * whenever modules are reconfigured.
+ *
+ * @param p_bank
+ * @param p_iir
+ * @param num
+ * @return Number of modules loaded
+ */
+uint16_t load_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank,
+                                dsp_iir_2p2z_t *p_iir, uint16_t num)
+{
+    uint16_t i;
+
+    if(num > DSP_BANK_SIZE)
+    {
+        num = DSP_BANK_SIZE;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+        p_bank->b0[i] = p_iir[i].coeffs.s.b0;
+        p_bank->b1[i] = p_iir[i].coeffs.s.b1;
+        p_bank->b2[i] = p_iir[i].coeffs.s.b2;
+        p_bank->a1[i] = p_iir[i].coeffs.s.a1;
+        p_bank->a2[i] = p_iir[i].coeffs.s.a2;
+        p_bank->u_max[i] = p_iir[i].coeffs.s.u_max;
+        p_bank->u_min[i] = p_iir[i].coeffs.s.u_min;
+        p_bank->w1[i] = p_iir[i].w1;
+        p_bank->w2[i] = p_iir[i].w2;
+        p_bank->in[i] = p_iir[i].in;
+        p_bank->out[i] = p_iir[i].out;
+    }
+
+    p_bank->num = num;
+
+    return num;
+}
+
+/**
+ * Store states of bank of 2nd-order digital IIR filters back to array of
+ * modules.
+ *
+ * @param p_bank
+ * @param p_iir
+ */
+void store_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank,
+                             dsp_iir_2p2z_t *p_iir)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_iir[i].w1 = p_bank->w1[i];
+        p_iir[i].w2 = p_bank->w2[i];
+    }
+}
+
+/**
+ * Reset bank of 2nd-order digital IIR filters.
+ *
+ * @param p_bank
+ */
+void reset_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_bank->w1[i] = 0.0;
+        p_bank->w2[i] = 0.0;
+        *(p_bank->out[i]) = 0.0;
+    }
+}
+
+/**
+ * Run bank of 2nd-order digital IIR filters. Each filter gives the same
+ * result as run_dsp_iir_2p2z().
+ *
+ * @param p_bank
+ */
+void run_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank)
+{
+    uint16_t i;
+    float in, yacc;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        in = *(p_bank->in[i]);
+
+        yacc = in * p_bank->b0[i];
+        yacc += p_bank->w1[i];
+
+        SATURATE(yacc, p_bank->u_max[i], p_bank->u_min[i]);
+
+        p_bank->w1[i] = in * p_bank->b1[i] + p_bank->w2[i] -
+                        yacc * p_bank->a1[i];
+        p_bank->w2[i] = in * p_bank->b2[i] - yacc * p_bank->a2[i];
+
+        *(p_bank->out[i]) = yacc;
+    }
+}
+
+/**
+ * Load bank of 3rd-order digital IIR filters from array of modules,
+ * including coefficients, states and signals. It must be called again
+ * whenever modules are reconfigured.
+ *
+ * @param p_bank
+ * @param p_iir
+ * @param num
+ * @return Number of modules loaded
+ */
+uint16_t load_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank,
+                                dsp_iir_3p3z_t *p_iir, uint16_t num)
+{
+    uint16_t i;
+
+    if(num > DSP_BANK_SIZE)
+    {
+        num = DSP_BANK_SIZE;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+        p_bank->b0[i] = p_iir[i].coeffs.s.b0;
+        p_bank->b1[i] = p_iir[i].coeffs.s.b1;
+        p_bank->b2[i] = p_iir[i].coeffs.s.b2;
+        p_bank->b3[i] = p_iir[i].coeffs.s.b3;
+        p_bank->a1[i] = p_iir[i].coeffs.s.a1;
+        p_bank->a2[i] = p_iir[i].coeffs.s.a2;
+        p_bank->a3[i] = p_iir[i].coeffs.s.a3;
+        p_bank->u_max[i] = p_iir[i].coeffs.s.u_max;
+        p_bank->u_min[i] = p_iir[i].coeffs.s.u_min;
+        p_bank->w1[i] = p_iir[i].w1;
+        p_bank->w2[i] = p_iir[i].w2;
+        p_bank->w3[i] = p_iir[i].w3;
+        p_bank->in[i] = p_iir[i].in;
+        p_bank->out[i] = p_iir[i].out;
+    }
+
+    p_bank->num = num;
+
+    return num;
+}
+
+/**
+ * Store states of bank of 3rd-order digital IIR filters back to array of
+ * modules.
+ *
+ * @param p_bank
+ * @param p_iir
+ */
+void store_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank,
+                             dsp_iir_3p3z_t *p_iir)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_iir[i].w1 = p_bank->w1[i];
+        p_iir[i].w2 = p_bank->w2[i];
+        p_iir[i].w3 = p_bank->w3[i];
+    }
+}
+
+/**
+ * Reset bank of 3rd-order digital IIR filters.
+ *
+ * @param p_bank
+ */
+void reset_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank)
+{
+    uint16_t i;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        p_bank->w1[i] = 0.0;
+        p_bank->w2[i] = 0.0;
+        p_bank->w3[i] = 0.0;
+        *(p_bank->out[i]) = 0.0;
+    }
+}
+
+/**
+ * Run bank of 3rd-order digital IIR filters. Each filter gives the same
+ * result as run_dsp_iir_3p3z().
+ *
+ * @param p_bank
+ */
+void run_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank)
+{
+    uint16_t i;
+    float in, yacc;
+
+    for(i = 0; i < p_bank->num; i++)
+    {
+        in = *(p_bank->in[i]);
+
+        yacc = in * p_bank->b0[i];
+        yacc += p_bank->w1[i];
+
+        SATURATE(yacc, p_bank->u_max[i], p_bank->u_min[i]);
+
+        p_bank->w1[i] = in * p_bank->b1[i] + p_bank->w2[i] -
+                        yacc * p_bank->a1[i];
+        p_bank->w2[i] = in * p_bank->b2[i] + p_bank->w3[i] -
+                        yacc * p_bank->a2[i];
+        p_bank->w3[i] = in * p_bank->b3[i] - yacc * p_bank->a3[i];
+
+        *(p_bank->out[i]) = yacc;
+    }
+}
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_bank.h
+ * @brief Banks of DSP modules
+ *
+ * Batch versions of DSP modules, which run several modules of the same class
+ * in a single call. They aren't used by ARM firmware, so this module is kept
+ * out of its build and its functions aren't placed in RAM. Results match the
+ * scalar modules from dsp.h.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef DSP_BANK_H_
+#define DSP_BANK_H_
+
+#include <stdint.h>
+#include "dsp.h"
+
+/**
+ * Banks of DSP modules of the same class, stored as structure of arrays, to
+ * run all modules in a single call. Coefficients and states aren't volatile,
+ * so they are loaded once per module and kept in registers along the
+ * kernel. Banks are loaded from arrays of modules, as used by the Control
+ * Framework, and states may be stored back to them.
+ */
+#define DSP_BANK_SIZE           8
+
+typedef struct
+{
+    uint16_t        num;
+    float           k[DSP_BANK_SIZE];
+    float           a[DSP_BANK_SIZE];
+    float           in_old[DSP_BANK_SIZE];
+    volatile float  *in[DSP_BANK_SIZE];
+    volatile float  *out[DSP_BANK_SIZE];
+} dsp_lpf_bank_t;
+
+typedef struct
+{
+    uint16_t        num;
+    float           kp[DSP_BANK_SIZE];
+    float           ki[DSP_BANK_SIZE];
+    float           u_max[DSP_BANK_SIZE];
+    float           u_min[DSP_BANK_SIZE];
+    float           u_prop[DSP_BANK_SIZE];
+    float           u_int[DSP_BANK_SIZE];
+    volatile float  *in[DSP_BANK_SIZE];
+    volatile float  *out[DSP_BANK_SIZE];
+} dsp_pi_bank_t;
+
+typedef struct
+{
+    uint16_t        num;
+    float           b0[DSP_BANK_SIZE];
+    float           b1[DSP_BANK_SIZE];
+    float           b2[DSP_BANK_SIZE];
+    float           a1[DSP_BANK_SIZE];
+    float           a2[DSP_BANK_SIZE];
+    float           u_max[DSP_BANK_SIZE];
+    float           u_min[DSP_BANK_SIZE];
+    float           w1[DSP_BANK_SIZE];
+    float           w2[DSP_BANK_SIZE];
+    volatile float  *in[DSP_BANK_SIZE];
+    volatile float  *out[DSP_BANK_SIZE];
+} dsp_iir_2p2z_bank_t;
+
+typedef struct
+{
+    uint16_t        num;
+    float           b0[DSP_BANK_SIZE];
+    float           b1[DSP_BANK_SIZE];
+    float           b2[DSP_BANK_SIZE];
+    float           b3[DSP_BANK_SIZE];
+    float           a1[DSP_BANK_SIZE];
+    float           a2[DSP_BANK_SIZE];
+    float           a3[DSP_BANK_SIZE];
+    float           u_max[DSP_BANK_SIZE];
+    float           u_min[DSP_BANK_SIZE];
+    float           w1[DSP_BANK_SIZE];
+    float           w2[DSP_BANK_SIZE];
+    float           w3[DSP_BANK_SIZE];
+    volatile float  *in[DSP_BANK_SIZE];
+    volatile float  *out[DSP_BANK_SIZE];
+} dsp_iir_3p3z_bank_t;
+
+extern uint16_t load_dsp_lpf_bank(dsp_lpf_bank_t *p_bank, dsp_lpf_t *p_lpf,
+                                  uint16_t num);
+extern void store_dsp_lpf_bank(dsp_lpf_bank_t *p_bank, dsp_lpf_t *p_lpf);
+extern void reset_dsp_lpf_bank(dsp_lpf_bank_t *p_bank);
+extern void run_dsp_lpf_bank(dsp_lpf_bank_t *p_bank);
+
+
+extern uint16_t load_dsp_pi_bank(dsp_pi_bank_t *p_bank, dsp_pi_t *p_pi,
+                                 uint16_t num);
+extern void store_dsp_pi_bank(dsp_pi_bank_t *p_bank, dsp_pi_t *p_pi);
+extern void reset_dsp_pi_bank(dsp_pi_bank_t *p_bank);
+extern void run_dsp_pi_bank(dsp_pi_bank_t *p_bank);
+
+
+extern uint16_t load_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank,
+                                       dsp_iir_2p2z_t *p_iir, uint16_t num);
+extern void store_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank,
+                                    dsp_iir_2p2z_t *p_iir);
+extern void reset_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank);
+extern void run_dsp_iir_2p2z_bank(dsp_iir_2p2z_bank_t *p_bank);
+
+
+extern uint16_t load_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank,
+                                       dsp_iir_3p3z_t *p_iir, uint16_t num);
+extern void store_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank,
+                                    dsp_iir_3p3z_t *p_iir);
+extern void reset_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank);
+extern void run_dsp_iir_3p3z_bank(dsp_iir_3p3z_bank_t *p_bank);
+
+#endif /* DSP_BANK_H_ */
@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_pipeline.c
+ * @brief Fused pipeline of DSP modules
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "dsp_pipeline.h"
+
+/**
+ * Initialization of empty DSP pipeline.
+ *
+ * @param p_pipeline
+ */
+void init_dsp_pipeline(dsp_pipeline_t *p_pipeline)
+{
+    p_pipeline->num_stages = 0;
+    p_pipeline->in = 0;
+    p_pipeline->out = 0;
+}
+
+/**
+ * Append DSP module to pipeline. Module input must be the output of previous
+ * stage, so pipeline gives the same results as running each module in the
+ * same order. For DSP_Error, the positive input is the pipeline signal. A
+ * bypassed SRLim is accepted but not added as a stage.
+ *
+ * @param p_pipeline
+ * @param dsp_class
+ * @param p_module
+ * @return 1 if module was appended, 0 otherwise
+ */
+uint16_t add_dsp_pipeline_stage(dsp_pipeline_t *p_pipeline,
+                                dsp_class_t dsp_class,
+                                volatile void *p_module)
+{
+    volatile float *in;
+    volatile float *out;
+
+    switch(dsp_class)
+    {
+        case DSP_Error:
+        {
+            in  = ((dsp_error_t *) p_module)->pos;
+            out = ((dsp_error_t *) p_module)->error;
+            break;
+        }
+
+        case DSP_SRLim:
+        {
+            in  = ((dsp_srlim_t *) p_module)->in;
+            out = ((dsp_srlim_t *) p_module)->out;
+            break;
+        }
+
+        case DSP_LPF:
+        {
+            in  = ((dsp_lpf_t *) p_module)->in;
+            out = ((dsp_lpf_t *) p_module)->out;
+            break;
+        }
+
+        case DSP_PI:
+        {
+            in  = ((dsp_pi_t *) p_module)->in;
+            out = ((dsp_pi_t *) p_module)->out;
+            break;
+        }
+
+        case DSP_IIR_2P2Z:
+        {
+            in  = ((dsp_iir_2p2z_t *) p_module)->in;
+            out = ((dsp_iir_2p2z_t *) p_module)->out;
+            break;
+        }
+
+        case DSP_IIR_3P3Z:
+        {
+            in  = ((dsp_iir_3p3z_t *) p_module)->in;
+            out = ((dsp_iir_3p3z_t *) p_module)->out;
+            break;
+        }
+
+        case DSP_VdcLink_FeedForward:
+        {
+            in  = ((dsp_vdclink_ff_t *) p_module)->in;
+            out = ((dsp_vdclink_ff_t *) p_module)->out;
+            break;
+        }
+
+        default:
+        {
+            return 0;
+        }
+    }
+
+    if( (p_pipeline->in != 0) && (in != p_pipeline->out) )
+    {
+        return 0;
+    }
+
+    if( (dsp_class == DSP_SRLim) && ((dsp_srlim_t *) p_module)->bypass )
+    {
+        /**
+         * Bypassed SRLim is resolved here: it's a copy of its input, which is
+         * kept as the pipeline signal
+         */
+        *out = *in;
+    }
+    else
+    {
+        if(p_pipeline->num_stages >= DSP_PIPELINE_MAX_STAGES)
+        {
+            return 0;
+        }
+
+        p_pipeline->stages[p_pipeline->num_stages].dsp_class = dsp_class;
+        p_pipeline->stages[p_pipeline->num_stages].p_module = p_module;
+        p_pipeline->num_stages++;
+    }
+
+    if(p_pipeline->in == 0)
+    {
+        p_pipeline->in = in;
+    }
+    p_pipeline->out = out;
+
+    return 1;
+}
+
+/**
+ * Run all stages of DSP pipeline. Arithmetic of each stage follows its
+ * respective run_dsp_* function, with module input replaced by the value
+ * computed by previous stage.
+ *
+ * @param p_pipeline
+ */
+void run_dsp_pipeline(dsp_pipeline_t *p_pipeline)
+{
+    uint16_t i;
+    float value;
+    float temp;
+    float yacc;
+    float w0;
+    float dyn_max;
+    float dyn_min;
+    volatile void *p_module;
+
+    if(p_pipeline->in == 0)
+    {
+        return;
+    }
+
+    value = *(p_pipeline->in);
+
+    for(i = 0; i < p_pipeline->num_stages; i++)
+    {
+        p_module = p_pipeline->stages[i].p_module;
+
+        switch(p_pipeline->stages[i].dsp_class)
+        {
+            case DSP_Error:
+            {
+                dsp_error_t *p_error = (dsp_error_t *) p_module;
+
+                value = value - *p_error->neg;
+                break;
+            }
+
+            case DSP_SRLim:
+            {
+                dsp_srlim_t *p_srlim = (dsp_srlim_t *) p_module;
+
+                yacc = *(p_srlim->out);
+                temp = value - yacc;
+                SATURATE(temp, p_srlim->delta_max, -p_srlim->delta_max);
+                value = yacc + temp;
+                *(p_srlim->out) = value;
+                break;
+            }
+
+            case DSP_LPF:
+            {
+                dsp_lpf_t *p_lpf = (dsp_lpf_t *) p_module;
+
+                yacc = *(p_lpf->out) * p_lpf->a;
+                yacc += p_lpf->k * (p_lpf->in_old + value);
+                p_lpf->in_old = value;
+                *(p_lpf->out) = yacc;
+                value = yacc;
+                break;
+            }
+
+            case DSP_PI:
+            {
+                dsp_pi_t *p_pi = (dsp_pi_t *) p_module;
+
+                temp = value * p_pi->coeffs.s.kp;
+                SATURATE(temp, p_pi->coeffs.s.u_max, p_pi->coeffs.s.u_min);
+                p_pi->u_prop = temp;
+
+                dyn_max = (p_pi->coeffs.s.u_max - temp);
+                dyn_min = (p_pi->coeffs.s.u_min - temp);
+
+                temp = p_pi->u_int + value * p_pi->coeffs.s.ki;
+                SATURATE(temp, dyn_max, dyn_min);
+                p_pi->u_int = temp;
+
+                value = temp + p_pi->u_prop;
+                break;
+            }
+
+            case DSP_IIR_2P2Z:
+            {
+                dsp_iir_2p2z_t *p_iir = (dsp_iir_2p2z_t *) p_module;
+
+                yacc = value * p_iir->coeffs.s.b0;
+                yacc += p_iir->w1;
+
+                SATURATE(yacc, p_iir->coeffs.s.u_max, p_iir->coeffs.s.u_min);
+
+                w0 = value * p_iir->coeffs.s.b1;
+                w0 += p_iir->w2;
+                w0 -= yacc * p_iir->coeffs.s.a1;
+                p_iir->w1 = w0;
+
+                w0 = value * p_iir->coeffs.s.b2;
+                w0 -= yacc * p_iir->coeffs.s.a2;
+                p_iir->w2 = w0;
+
+                value = yacc;
+                break;
+            }
+
+            case DSP_IIR_3P3Z:
+            {
+                dsp_iir_3p3z_t *p_iir = (dsp_iir_3p3z_t *) p_module;
+
+                yacc = value * p_iir->coeffs.s.b0;
+                yacc += p_iir->w1;
+
+                SATURATE(yacc, p_iir->coeffs.s.u_max, p_iir->coeffs.s.u_min);
+
+                w0 = value * p_iir->coeffs.s.b1;
+                w0 += p_iir->w2;
+                w0 -= yacc * p_iir->coeffs.s.a1;
+                p_iir->w1 = w0;
+
+                w0 = value * p_iir->coeffs.s.b2;
+                w0 += p_iir->w3;
+                w0 -= yacc * p_iir->coeffs.s.a2;
+                p_iir->w2 = w0;
+
+                w0 = value * p_iir->coeffs.s.b3;
+                w0 -= yacc * p_iir->coeffs.s.a3;
+                p_iir->w3 = w0;
+
+                value = yacc;
+                break;
+            }
+
+            case DSP_VdcLink_FeedForward:
+            {
+                dsp_vdclink_ff_t *p_ff = (dsp_vdclink_ff_t *) p_module;
+
+                temp = *(p_ff->vdc_meas);
+
+                if( !(temp < p_ff->coeffs.s.vdc_min) )
+                {
+                    value = value * p_ff->coeffs.s.vdc_nom / temp;
+                }
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+    }
+
+    *(p_pipeline->out) = value;
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_pipeline.h
+ * @brief Fused pipeline of DSP modules
+ *
+ * Chain of DSP modules run in a single call. It isn't used by ARM firmware,
+ * so this module is kept out of its build and its functions aren't placed in
+ * RAM.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef DSP_PIPELINE_H_
+#define DSP_PIPELINE_H_
+
+#include <stdint.h>
+#include "dsp.h"
+
+/**
+ * Fused pipeline of DSP modules, wired as a chain: each stage input is the
+ * output of previous stage. Pipeline runs all stages in a single call,
+ * keeping intermediate values in registers, and gives the same results as
+ * running each module separately. Intermediate signals aren't updated,
+ * except the outputs of SRLim and LPF, which are also their states.
+ * Bypassed SRLim stages are removed when added to pipeline, so pipeline
+ * must be built again whenever bypass is changed, and SRLim should be reset
+ * before leaving bypass.
+ */
+#define DSP_PIPELINE_MAX_STAGES     8
+
+typedef struct
+{
+    dsp_class_t     dsp_class;
+    volatile void   *p_module;
+} dsp_pipeline_stage_t;
+
+typedef struct
+{
+    uint16_t                num_stages;
+    dsp_pipeline_stage_t    stages[DSP_PIPELINE_MAX_STAGES];
+    volatile float          *in;
+    volatile float          *out;
+} dsp_pipeline_t;
+
+extern void init_dsp_pipeline(dsp_pipeline_t *p_pipeline);
+extern uint16_t add_dsp_pipeline_stage(dsp_pipeline_t *p_pipeline,
+                                       dsp_class_t dsp_class,
+                                       volatile void *p_module);
+extern void run_dsp_pipeline(dsp_pipeline_t *p_pipeline);
+
+#endif /* DSP_PIPELINE_H_ */
@@ -0,0 +1,950 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_q.c
+ * @brief Fixed-point Digital Signal Processing Module
+ *
+ * Q15 versions accumulate in 32-bit integers and Q31 versions in 64-bit
+ * integers, which M3 computes with SMULL/SMLAL instructions. Each product
+ * is shifted back to signal format before being accumulated, so sums never
+ * overflow the accumulator and only need to be saturated to signal range.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include "dsp_q.h"
+
+#define MUL_Q15(x, coeff)   ( ((int32_t) (x) * (coeff)) >> DSP_Q15_COEFF_FRAC )
+#define MUL_Q31(x, coeff)   ( ((int64_t) (x) * (coeff)) >> DSP_Q31_COEFF_FRAC )
+
+static q15_t sat_q15(int32_t value)
+{
+    SATURATE(value, Q15_MAX, Q15_MIN);
+    return (q15_t) value;
+}
+
+static q31_t sat_q31(int64_t value)
+{
+    SATURATE(value, Q31_MAX, Q31_MIN);
+    return (q31_t) value;
+}
+
+static int32_t double_to_sat_int(double value, double max, double min)
+{
+    value = (value >= 0.0) ? (value + 0.5) : (value - 0.5);
+    SATURATE(value, max, min);
+    return (int32_t) value;
+}
+
+/**
+ * Convert float coefficient to Q15 coefficient format. Coefficients out of
+ * its range are saturated and counted on p_num_sat.
+ *
+ * @param coeff
+ * @param p_num_sat
+ * @return Coefficient with DSP_Q15_COEFF_FRAC fractional bits
+ */
+static q15_t coeff_to_q15(float coeff, uint16_t *p_num_sat)
+{
+    double value;
+
+    value = coeff * (double) (1UL << DSP_Q15_COEFF_FRAC);
+
+    if( !( (value < (Q15_MAX + 0.5)) && (value > (Q15_MIN - 0.5)) ) )
+    {
+        (*p_num_sat)++;
+    }
+
+    return (q15_t) double_to_sat_int(value, Q15_MAX, Q15_MIN);
+}
+
+/**
+ * Convert float coefficient to Q31 coefficient format. Coefficients out of
+ * its range are saturated and counted on p_num_sat.
+ *
+ * @param coeff
+ * @param p_num_sat
+ * @return Coefficient with DSP_Q31_COEFF_FRAC fractional bits
+ */
+static q31_t coeff_to_q31(float coeff, uint16_t *p_num_sat)
+{
+    double value;
+
+    value = coeff * (double) (1UL << DSP_Q31_COEFF_FRAC);
+
+    if( !( (value < (Q31_MAX + 0.5)) && (value > (Q31_MIN - 0.5)) ) )
+    {
+        (*p_num_sat)++;
+    }
+
+    return double_to_sat_int(value, Q31_MAX, Q31_MIN);
+}
+
+/**
+ * Convert float signal to Q15, saturating it to full scale.
+ *
+ * @param value
+ * @param full_scale
+ * @return Q15 signal
+ */
+q15_t float_to_q15(float value, float full_scale)
+{
+    return (q15_t) double_to_sat_int(value * (32768.0 / full_scale),
+                                     Q15_MAX, Q15_MIN);
+}
+
+/**
+ * Convert Q15 signal to float.
+ *
+ * @param value
+ * @param full_scale
+ * @return Float signal
+ */
+float q15_to_float(q15_t value, float full_scale)
+{
+    return ((float) value) * (full_scale / 32768.0);
+}
+
+/**
+ * Initialization of Q15 slew-rate limiter from float module.
+ *
+ * @param p_srlim
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ */
+void init_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim, dsp_srlim_t *p_src,
+                        float full_scale, volatile q15_t *in,
+                        volatile q15_t *out)
+{
+    p_srlim->in = in;
+    p_srlim->out = out;
+
+    load_dsp_srlim_q15(p_srlim, p_src, full_scale);
+    reset_dsp_srlim_q15(p_srlim);
+}
+
+/**
+ * Convert coefficients of float slew-rate limiter. It must be called again
+ * whenever float module is reconfigured.
+ *
+ * @param p_srlim
+ * @param p_src
+ * @param full_scale
+ */
+void load_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim, dsp_srlim_t *p_src,
+                        float full_scale)
+{
+    p_srlim->delta_max = float_to_q15(p_src->delta_max, full_scale);
+}
+
+/**
+ * Reset Q15 slew-rate limiter.
+ *
+ * @param p_srlim
+ */
+void reset_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim)
+{
+    *(p_srlim->out) = 0;
+}
+
+/**
+ * Run Q15 slew-rate limiter.
+ *
+ * @param p_srlim
+ */
+void run_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim)
+{
+    int32_t delta;
+
+    delta = (int32_t) *(p_srlim->in) - *(p_srlim->out);
+    SATURATE(delta, p_srlim->delta_max, -p_srlim->delta_max);
+    *(p_srlim->out) = *(p_srlim->out) + (q15_t) delta;
+}
+
+/**
+ * Initialization of Q15 1st-order low-pass filter from float module.
+ * Coefficients are independent of signals full scale.
+ *
+ * @param p_lpf
+ * @param p_src
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t init_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf, dsp_lpf_t *p_src,
+                          volatile q15_t *in, volatile q15_t *out)
+{
+    uint16_t num_sat;
+
+    p_lpf->in = in;
+    p_lpf->out = out;
+
+    num_sat = load_dsp_lpf_q15(p_lpf, p_src);
+    reset_dsp_lpf_q15(p_lpf);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float 1st-order low-pass filter. It must be called
+ * again whenever float module is reconfigured.
+ *
+ * @param p_lpf
+ * @param p_src
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t load_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf, dsp_lpf_t *p_src)
+{
+    uint16_t num_sat = 0;
+
+    p_lpf->k = coeff_to_q15(p_src->k, &num_sat);
+    p_lpf->a = coeff_to_q15(p_src->a, &num_sat);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q15 1st-order low-pass filter.
+ *
+ * @param p_lpf
+ */
+void reset_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf)
+{
+    p_lpf->in_old = 0;
+    *(p_lpf->out) = 0;
+}
+
+/**
+ * Run Q15 1st-order low-pass filter.
+ *
+ * @param p_lpf
+ */
+void run_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf)
+{
+    q15_t in;
+    int32_t yacc;
+
+    in = *(p_lpf->in);
+
+    yacc = MUL_Q15(*(p_lpf->out), p_lpf->a);
+    yacc += MUL_Q15((int32_t) p_lpf->in_old + in, p_lpf->k);
+    p_lpf->in_old = in;
+    *(p_lpf->out) = sat_q15(yacc);
+}
+
+/**
+ * Initialization of Q15 PI controller from float module.
+ *
+ * @param p_pi
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t init_dsp_pi_q15(dsp_pi_q15_t *p_pi, dsp_pi_t *p_src, float full_scale,
+                         volatile q15_t *in, volatile q15_t *out)
+{
+    uint16_t num_sat;
+
+    p_pi->in = in;
+    p_pi->out = out;
+
+    num_sat = load_dsp_pi_q15(p_pi, p_src, full_scale);
+    reset_dsp_pi_q15(p_pi);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float PI controller. It must be called again
+ * whenever float module is reconfigured.
+ *
+ * @param p_pi
+ * @param p_src
+ * @param full_scale
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t load_dsp_pi_q15(dsp_pi_q15_t *p_pi, dsp_pi_t *p_src, float full_scale)
+{
+    uint16_t num_sat = 0;
+
+    p_pi->kp = coeff_to_q15(p_src->coeffs.s.kp, &num_sat);
+    p_pi->ki = coeff_to_q15(p_src->coeffs.s.ki, &num_sat);
+    p_pi->u_max = float_to_q15(p_src->coeffs.s.u_max, full_scale);
+    p_pi->u_min = float_to_q15(p_src->coeffs.s.u_min, full_scale);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q15 PI controller.
+ *
+ * @param p_pi
+ */
+void reset_dsp_pi_q15(dsp_pi_q15_t *p_pi)
+{
+    p_pi->u_prop = 0;
+    p_pi->u_int = 0;
+    *(p_pi->out) = 0;
+}
+
+/**
+ * Run Q15 PI controller with dynamic anti-windup scheme.
+ *
+ * @param p_pi
+ */
+void run_dsp_pi_q15(dsp_pi_q15_t *p_pi)
+{
+    q15_t in;
+    int32_t dyn_max;
+    int32_t dyn_min;
+    int32_t temp;
+
+    in = *(p_pi->in);
+
+    temp = MUL_Q15(in, p_pi->kp);
+    SATURATE(temp, p_pi->u_max, p_pi->u_min);
+    p_pi->u_prop = (q15_t) temp;
+
+    dyn_max = ((int32_t) p_pi->u_max - temp);
+    dyn_min = ((int32_t) p_pi->u_min - temp);
+
+    temp = p_pi->u_int + MUL_Q15(in, p_pi->ki);
+    SATURATE(temp, dyn_max, dyn_min);
+    p_pi->u_int = sat_q15(temp);
+
+    *(p_pi->out) = p_pi->u_int + p_pi->u_prop;
+}
+
+/**
+ * Initialization of Q15 2nd-order IIR filter from float module.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t init_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir, dsp_iir_2p2z_t *p_src,
+                               float full_scale, volatile q15_t *in,
+                               volatile q15_t *out)
+{
+    uint16_t num_sat;
+
+    p_iir->in = in;
+    p_iir->out = out;
+
+    num_sat = load_dsp_iir_2p2z_q15(p_iir, p_src, full_scale);
+    reset_dsp_iir_2p2z_q15(p_iir);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float 2nd-order IIR filter. It must be called
+ * again whenever float module is reconfigured.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t load_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir, dsp_iir_2p2z_t *p_src,
+                               float full_scale)
+{
+    uint16_t num_sat = 0;
+
+    p_iir->b0 = coeff_to_q15(p_src->coeffs.s.b0, &num_sat);
+    p_iir->b1 = coeff_to_q15(p_src->coeffs.s.b1, &num_sat);
+    p_iir->b2 = coeff_to_q15(p_src->coeffs.s.b2, &num_sat);
+    p_iir->a1 = coeff_to_q15(p_src->coeffs.s.a1, &num_sat);
+    p_iir->a2 = coeff_to_q15(p_src->coeffs.s.a2, &num_sat);
+    p_iir->u_max = float_to_q15(p_src->coeffs.s.u_max, full_scale);
+    p_iir->u_min = float_to_q15(p_src->coeffs.s.u_min, full_scale);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q15 2nd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void reset_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir)
+{
+    p_iir->w1 = 0;
+    p_iir->w2 = 0;
+    *(p_iir->out) = 0;
+}
+
+/**
+ * Run Q15 2nd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void run_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir)
+{
+    q15_t in;
+    int32_t w0, yacc;
+
+    in = *(p_iir->in);
+
+    yacc = MUL_Q15(in, p_iir->b0);
+    yacc += p_iir->w1;
+
+    SATURATE(yacc, p_iir->u_max, p_iir->u_min);
+
+    w0 = MUL_Q15(in, p_iir->b1);
+    w0 += p_iir->w2;
+    w0 -= MUL_Q15(yacc, p_iir->a1);
+    p_iir->w1 = sat_q15(w0);
+
+    w0 = MUL_Q15(in, p_iir->b2);
+    w0 -= MUL_Q15(yacc, p_iir->a2);
+    p_iir->w2 = sat_q15(w0);
+
+    *(p_iir->out) = (q15_t) yacc;
+}
+
+/**
+ * Initialization of Q15 3rd-order IIR filter from float module.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t init_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir, dsp_iir_3p3z_t *p_src,
+                               float full_scale, volatile q15_t *in,
+                               volatile q15_t *out)
+{
+    uint16_t num_sat;
+
+    p_iir->in = in;
+    p_iir->out = out;
+
+    num_sat = load_dsp_iir_3p3z_q15(p_iir, p_src, full_scale);
+    reset_dsp_iir_3p3z_q15(p_iir);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float 3rd-order IIR filter. It must be called
+ * again whenever float module is reconfigured.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @return Number of coefficients saturated to Q15 coefficient range
+ */
+uint16_t load_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir, dsp_iir_3p3z_t *p_src,
+                               float full_scale)
+{
+    uint16_t num_sat = 0;
+
+    p_iir->b0 = coeff_to_q15(p_src->coeffs.s.b0, &num_sat);
+    p_iir->b1 = coeff_to_q15(p_src->coeffs.s.b1, &num_sat);
+    p_iir->b2 = coeff_to_q15(p_src->coeffs.s.b2, &num_sat);
+    p_iir->b3 = coeff_to_q15(p_src->coeffs.s.b3, &num_sat);
+    p_iir->a1 = coeff_to_q15(p_src->coeffs.s.a1, &num_sat);
+    p_iir->a2 = coeff_to_q15(p_src->coeffs.s.a2, &num_sat);
+    p_iir->a3 = coeff_to_q15(p_src->coeffs.s.a3, &num_sat);
+    p_iir->u_max = float_to_q15(p_src->coeffs.s.u_max, full_scale);
+    p_iir->u_min = float_to_q15(p_src->coeffs.s.u_min, full_scale);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q15 3rd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void reset_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir)
+{
+    p_iir->w1 = 0;
+    p_iir->w2 = 0;
+    p_iir->w3 = 0;
+    *(p_iir->out) = 0;
+}
+
+/**
+ * Run Q15 3rd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void run_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir)
+{
+    q15_t in;
+    int32_t w0, yacc;
+
+    in = *(p_iir->in);
+
+    yacc = MUL_Q15(in, p_iir->b0);
+    yacc += p_iir->w1;
+
+    SATURATE(yacc, p_iir->u_max, p_iir->u_min);
+
+    w0 = MUL_Q15(in, p_iir->b1);
+    w0 += p_iir->w2;
+    w0 -= MUL_Q15(yacc, p_iir->a1);
+    p_iir->w1 = sat_q15(w0);
+
+    w0 = MUL_Q15(in, p_iir->b2);
+    w0 += p_iir->w3;
+    w0 -= MUL_Q15(yacc, p_iir->a2);
+    p_iir->w2 = sat_q15(w0);
+
+    w0 = MUL_Q15(in, p_iir->b3);
+    w0 -= MUL_Q15(yacc, p_iir->a3);
+    p_iir->w3 = sat_q15(w0);
+
+    *(p_iir->out) = (q15_t) yacc;
+}
+
+/**
+ * Convert float signal to Q31, saturating it to full scale.
+ *
+ * @param value
+ * @param full_scale
+ * @return Q31 signal
+ */
+q31_t float_to_q31(float value, float full_scale)
+{
+    return (q31_t) double_to_sat_int(value * (2147483648.0 / full_scale),
+                                     Q31_MAX, Q31_MIN);
+}
+
+/**
+ * Convert Q31 signal to float.
+ *
+ * @param value
+ * @param full_scale
+ * @return Float signal
+ */
+float q31_to_float(q31_t value, float full_scale)
+{
+    return ((float) value) * (full_scale / 2147483648.0);
+}
+
+/**
+ * Initialization of Q31 slew-rate limiter from float module.
+ *
+ * @param p_srlim
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ */
+void init_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim, dsp_srlim_t *p_src,
+                        float full_scale, volatile q31_t *in,
+                        volatile q31_t *out)
+{
+    p_srlim->in = in;
+    p_srlim->out = out;
+
+    load_dsp_srlim_q31(p_srlim, p_src, full_scale);
+    reset_dsp_srlim_q31(p_srlim);
+}
+
+/**
+ * Convert coefficients of float slew-rate limiter. It must be called again
+ * whenever float module is reconfigured.
+ *
+ * @param p_srlim
+ * @param p_src
+ * @param full_scale
+ */
+void load_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim, dsp_srlim_t *p_src,
+                        float full_scale)
+{
+    p_srlim->delta_max = float_to_q31(p_src->delta_max, full_scale);
+}
+
+/**
+ * Reset Q31 slew-rate limiter.
+ *
+ * @param p_srlim
+ */
+void reset_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim)
+{
+    *(p_srlim->out) = 0;
+}
+
+/**
+ * Run Q31 slew-rate limiter.
+ *
+ * @param p_srlim
+ */
+void run_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim)
+{
+    int64_t delta;
+
+    delta = (int64_t) *(p_srlim->in) - *(p_srlim->out);
+    SATURATE(delta, p_srlim->delta_max, -p_srlim->delta_max);
+    *(p_srlim->out) = *(p_srlim->out) + (q31_t) delta;
+}
+
+/**
+ * Initialization of Q31 1st-order low-pass filter from float module.
+ * Coefficients are independent of signals full scale.
+ *
+ * @param p_lpf
+ * @param p_src
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t init_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf, dsp_lpf_t *p_src,
+                          volatile q31_t *in, volatile q31_t *out)
+{
+    uint16_t num_sat;
+
+    p_lpf->in = in;
+    p_lpf->out = out;
+
+    num_sat = load_dsp_lpf_q31(p_lpf, p_src);
+    reset_dsp_lpf_q31(p_lpf);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float 1st-order low-pass filter. It must be called
+ * again whenever float module is reconfigured.
+ *
+ * @param p_lpf
+ * @param p_src
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t load_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf, dsp_lpf_t *p_src)
+{
+    uint16_t num_sat = 0;
+
+    p_lpf->k = coeff_to_q31(p_src->k, &num_sat);
+    p_lpf->a = coeff_to_q31(p_src->a, &num_sat);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q31 1st-order low-pass filter.
+ *
+ * @param p_lpf
+ */
+void reset_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf)
+{
+    p_lpf->in_old = 0;
+    *(p_lpf->out) = 0;
+}
+
+/**
+ * Run Q31 1st-order low-pass filter.
+ *
+ * @param p_lpf
+ */
+void run_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf)
+{
+    q31_t in;
+    int64_t yacc;
+
+    in = *(p_lpf->in);
+
+    yacc = MUL_Q31(*(p_lpf->out), p_lpf->a);
+    yacc += MUL_Q31((int64_t) p_lpf->in_old + in, p_lpf->k);
+    p_lpf->in_old = in;
+    *(p_lpf->out) = sat_q31(yacc);
+}
+
+/**
+ * Initialization of Q31 PI controller from float module.
+ *
+ * @param p_pi
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t init_dsp_pi_q31(dsp_pi_q31_t *p_pi, dsp_pi_t *p_src, float full_scale,
+                         volatile q31_t *in, volatile q31_t *out)
+{
+    uint16_t num_sat;
+
+    p_pi->in = in;
+    p_pi->out = out;
+
+    num_sat = load_dsp_pi_q31(p_pi, p_src, full_scale);
+    reset_dsp_pi_q31(p_pi);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float PI controller. It must be called again
+ * whenever float module is reconfigured.
+ *
+ * @param p_pi
+ * @param p_src
+ * @param full_scale
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t load_dsp_pi_q31(dsp_pi_q31_t *p_pi, dsp_pi_t *p_src, float full_scale)
+{
+    uint16_t num_sat = 0;
+
+    p_pi->kp = coeff_to_q31(p_src->coeffs.s.kp, &num_sat);
+    p_pi->ki = coeff_to_q31(p_src->coeffs.s.ki, &num_sat);
+    p_pi->u_max = float_to_q31(p_src->coeffs.s.u_max, full_scale);
+    p_pi->u_min = float_to_q31(p_src->coeffs.s.u_min, full_scale);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q31 PI controller.
+ *
+ * @param p_pi
+ */
+void reset_dsp_pi_q31(dsp_pi_q31_t *p_pi)
+{
+    p_pi->u_prop = 0;
+    p_pi->u_int = 0;
+    *(p_pi->out) = 0;
+}
+
+/**
+ * Run Q31 PI controller with dynamic anti-windup scheme.
+ *
+ * @param p_pi
+ */
+void run_dsp_pi_q31(dsp_pi_q31_t *p_pi)
+{
+    q31_t in;
+    int64_t dyn_max;
+    int64_t dyn_min;
+    int64_t temp;
+
+    in = *(p_pi->in);
+
+    temp = MUL_Q31(in, p_pi->kp);
+    SATURATE(temp, p_pi->u_max, p_pi->u_min);
+    p_pi->u_prop = (q31_t) temp;
+
+    dyn_max = ((int64_t) p_pi->u_max - temp);
+    dyn_min = ((int64_t) p_pi->u_min - temp);
+
+    temp = p_pi->u_int + MUL_Q31(in, p_pi->ki);
+    SATURATE(temp, dyn_max, dyn_min);
+    p_pi->u_int = sat_q31(temp);
+
+    *(p_pi->out) = p_pi->u_int + p_pi->u_prop;
+}
+
+/**
+ * Initialization of Q31 2nd-order IIR filter from float module.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t init_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir, dsp_iir_2p2z_t *p_src,
+                               float full_scale, volatile q31_t *in,
+                               volatile q31_t *out)
+{
+    uint16_t num_sat;
+
+    p_iir->in = in;
+    p_iir->out = out;
+
+    num_sat = load_dsp_iir_2p2z_q31(p_iir, p_src, full_scale);
+    reset_dsp_iir_2p2z_q31(p_iir);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float 2nd-order IIR filter. It must be called
+ * again whenever float module is reconfigured.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t load_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir, dsp_iir_2p2z_t *p_src,
+                               float full_scale)
+{
+    uint16_t num_sat = 0;
+
+    p_iir->b0 = coeff_to_q31(p_src->coeffs.s.b0, &num_sat);
+    p_iir->b1 = coeff_to_q31(p_src->coeffs.s.b1, &num_sat);
+    p_iir->b2 = coeff_to_q31(p_src->coeffs.s.b2, &num_sat);
+    p_iir->a1 = coeff_to_q31(p_src->coeffs.s.a1, &num_sat);
+    p_iir->a2 = coeff_to_q31(p_src->coeffs.s.a2, &num_sat);
+    p_iir->u_max = float_to_q31(p_src->coeffs.s.u_max, full_scale);
+    p_iir->u_min = float_to_q31(p_src->coeffs.s.u_min, full_scale);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q31 2nd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void reset_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir)
+{
+    p_iir->w1 = 0;
+    p_iir->w2 = 0;
+    *(p_iir->out) = 0;
+}
+
+/**
+ * Run Q31 2nd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void run_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir)
+{
+    q31_t in;
+    int64_t w0, yacc;
+
+    in = *(p_iir->in);
+
+    yacc = MUL_Q31(in, p_iir->b0);
+    yacc += p_iir->w1;
+
+    SATURATE(yacc, p_iir->u_max, p_iir->u_min);
+
+    w0 = MUL_Q31(in, p_iir->b1);
+    w0 += p_iir->w2;
+    w0 -= MUL_Q31(yacc, p_iir->a1);
+    p_iir->w1 = sat_q31(w0);
+
+    w0 = MUL_Q31(in, p_iir->b2);
+    w0 -= MUL_Q31(yacc, p_iir->a2);
+    p_iir->w2 = sat_q31(w0);
+
+    *(p_iir->out) = (q31_t) yacc;
+}
+
+/**
+ * Initialization of Q31 3rd-order IIR filter from float module.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @param in
+ * @param out
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t init_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir, dsp_iir_3p3z_t *p_src,
+                               float full_scale, volatile q31_t *in,
+                               volatile q31_t *out)
+{
+    uint16_t num_sat;
+
+    p_iir->in = in;
+    p_iir->out = out;
+
+    num_sat = load_dsp_iir_3p3z_q31(p_iir, p_src, full_scale);
+    reset_dsp_iir_3p3z_q31(p_iir);
+
+    return num_sat;
+}
+
+/**
+ * Convert coefficients of float 3rd-order IIR filter. It must be called
+ * again whenever float module is reconfigured.
+ *
+ * @param p_iir
+ * @param p_src
+ * @param full_scale
+ * @return Number of coefficients saturated to Q31 coefficient range
+ */
+uint16_t load_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir, dsp_iir_3p3z_t *p_src,
+                               float full_scale)
+{
+    uint16_t num_sat = 0;
+
+    p_iir->b0 = coeff_to_q31(p_src->coeffs.s.b0, &num_sat);
+    p_iir->b1 = coeff_to_q31(p_src->coeffs.s.b1, &num_sat);
+    p_iir->b2 = coeff_to_q31(p_src->coeffs.s.b2, &num_sat);
+    p_iir->b3 = coeff_to_q31(p_src->coeffs.s.b3, &num_sat);
+    p_iir->a1 = coeff_to_q31(p_src->coeffs.s.a1, &num_sat);
+    p_iir->a2 = coeff_to_q31(p_src->coeffs.s.a2, &num_sat);
+    p_iir->a3 = coeff_to_q31(p_src->coeffs.s.a3, &num_sat);
+    p_iir->u_max = float_to_q31(p_src->coeffs.s.u_max, full_scale);
+    p_iir->u_min = float_to_q31(p_src->coeffs.s.u_min, full_scale);
+
+    return num_sat;
+}
+
+/**
+ * Reset Q31 3rd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void reset_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir)
+{
+    p_iir->w1 = 0;
+    p_iir->w2 = 0;
+    p_iir->w3 = 0;
+    *(p_iir->out) = 0;
+}
+
+/**
+ * Run Q31 3rd-order IIR filter.
+ *
+ * @param p_iir
+ */
+void run_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir)
+{
+    q31_t in;
+    int64_t w0, yacc;
+
+    in = *(p_iir->in);
+
+    yacc = MUL_Q31(in, p_iir->b0);
+    yacc += p_iir->w1;
+
+    SATURATE(yacc, p_iir->u_max, p_iir->u_min);
+
+    w0 = MUL_Q31(in, p_iir->b1);
+    w0 += p_iir->w2;
+    w0 -= MUL_Q31(yacc, p_iir->a1);
+    p_iir->w1 = sat_q31(w0);
+
+    w0 = MUL_Q31(in, p_iir->b2);
+    w0 += p_iir->w3;
+    w0 -= MUL_Q31(yacc, p_iir->a2);
+    p_iir->w2 = sat_q31(w0);
+
+    w0 = MUL_Q31(in, p_iir->b3);
+    w0 -= MUL_Q31(yacc, p_iir->a3);
+    p_iir->w3 = sat_q31(w0);
+
+    *(p_iir->out) = (q31_t) yacc;
+}
@@ -0,0 +1,262 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_q.h
+ * @brief Fixed-point Digital Signal Processing Module
+ *
+ * Q15 and Q31 versions of SRLim, LPF, PI, 2P2Z and 3P3Z modules, for signal
+ * processing on ARM core, which has no FPU. Coefficients are converted from
+ * the float modules of dsp.h, and each fixed-point module follows the same
+ * algorithm of its float counterpart, with saturation of all intermediate
+ * results.
+ *
+ * Signals are fractional numbers normalized by a full scale value given on
+ * conversion, so input, output and limits of a module share the same full
+ * scale. Coefficients use DSP_Q15_COEFF_FRAC and DSP_Q31_COEFF_FRAC
+ * fractional bits, which limits them to +/- 8. Q15 coefficients have a
+ * resolution of 2^-12, so Q31 versions should be used whenever coefficients
+ * are small, as LPF with cut-off frequency below ~1% of sampling frequency
+ * and PI with small integral gain, or for narrow notch filters.
+ *
+ * Coefficients out of range are saturated, and init and load functions
+ * return how many of them were, so a non-zero value means the fixed-point
+ * module doesn't match its float counterpart and mustn't be used.
+ *
+ * These modules run from flash, as they aren't placed in RAM, and unused
+ * ones are removed at link time.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef DSP_Q_H_
+#define DSP_Q_H_
+
+#include <stdint.h>
+#include "dsp.h"
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+#define Q15_MAX                 INT16_MAX
+#define Q15_MIN                 INT16_MIN
+#define Q31_MAX                 INT32_MAX
+#define Q31_MIN                 INT32_MIN
+
+#define DSP_Q15_COEFF_FRAC      12
+#define DSP_Q31_COEFF_FRAC      28
+
+typedef struct
+{
+    q15_t delta_max;
+    volatile q15_t *in;
+    volatile q15_t *out;
+} dsp_srlim_q15_t;
+
+typedef struct
+{
+    q15_t k;
+    q15_t a;
+    q15_t in_old;
+    volatile q15_t *in;
+    volatile q15_t *out;
+} dsp_lpf_q15_t;
+
+typedef struct
+{
+    q15_t kp;
+    q15_t ki;
+    q15_t u_max;
+    q15_t u_min;
+    q15_t u_prop;
+    q15_t u_int;
+    volatile q15_t *in;
+    volatile q15_t *out;
+} dsp_pi_q15_t;
+
+typedef struct
+{
+    q15_t b0;
+    q15_t b1;
+    q15_t b2;
+    q15_t a1;
+    q15_t a2;
+    q15_t u_max;
+    q15_t u_min;
+    q15_t w1;
+    q15_t w2;
+    volatile q15_t *in;
+    volatile q15_t *out;
+} dsp_iir_2p2z_q15_t;
+
+typedef struct
+{
+    q15_t b0;
+    q15_t b1;
+    q15_t b2;
+    q15_t b3;
+    q15_t a1;
+    q15_t a2;
+    q15_t a3;
+    q15_t u_max;
+    q15_t u_min;
+    q15_t w1;
+    q15_t w2;
+    q15_t w3;
+    volatile q15_t *in;
+    volatile q15_t *out;
+} dsp_iir_3p3z_q15_t;
+
+typedef struct
+{
+    q31_t delta_max;
+    volatile q31_t *in;
+    volatile q31_t *out;
+} dsp_srlim_q31_t;
+
+typedef struct
+{
+    q31_t k;
+    q31_t a;
+    q31_t in_old;
+    volatile q31_t *in;
+    volatile q31_t *out;
+} dsp_lpf_q31_t;
+
+typedef struct
+{
+    q31_t kp;
+    q31_t ki;
+    q31_t u_max;
+    q31_t u_min;
+    q31_t u_prop;
+    q31_t u_int;
+    volatile q31_t *in;
+    volatile q31_t *out;
+} dsp_pi_q31_t;
+
+typedef struct
+{
+    q31_t b0;
+    q31_t b1;
+    q31_t b2;
+    q31_t a1;
+    q31_t a2;
+    q31_t u_max;
+    q31_t u_min;
+    q31_t w1;
+    q31_t w2;
+    volatile q31_t *in;
+    volatile q31_t *out;
+} dsp_iir_2p2z_q31_t;
+
+typedef struct
+{
+    q31_t b0;
+    q31_t b1;
+    q31_t b2;
+    q31_t b3;
+    q31_t a1;
+    q31_t a2;
+    q31_t a3;
+    q31_t u_max;
+    q31_t u_min;
+    q31_t w1;
+    q31_t w2;
+    q31_t w3;
+    volatile q31_t *in;
+    volatile q31_t *out;
+} dsp_iir_3p3z_q31_t;
+
+extern q15_t float_to_q15(float value, float full_scale);
+extern float q15_to_float(q15_t value, float full_scale);
+
+extern void init_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim, dsp_srlim_t *p_src,
+                               float full_scale, volatile q15_t *in,
+                               volatile q15_t *out);
+extern void load_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim, dsp_srlim_t *p_src,
+                               float full_scale);
+extern void reset_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim);
+extern void run_dsp_srlim_q15(dsp_srlim_q15_t *p_srlim);
+
+extern uint16_t init_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf, dsp_lpf_t *p_src,
+                                 volatile q15_t *in, volatile q15_t *out);
+extern uint16_t load_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf, dsp_lpf_t *p_src);
+extern void reset_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf);
+extern void run_dsp_lpf_q15(dsp_lpf_q15_t *p_lpf);
+
+extern uint16_t init_dsp_pi_q15(dsp_pi_q15_t *p_pi, dsp_pi_t *p_src,
+                                float full_scale, volatile q15_t *in,
+                                volatile q15_t *out);
+extern uint16_t load_dsp_pi_q15(dsp_pi_q15_t *p_pi, dsp_pi_t *p_src,
+                                float full_scale);
+extern void reset_dsp_pi_q15(dsp_pi_q15_t *p_pi);
+extern void run_dsp_pi_q15(dsp_pi_q15_t *p_pi);
+
+extern uint16_t init_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir,
+                                      dsp_iir_2p2z_t *p_src, float full_scale,
+                                      volatile q15_t *in, volatile q15_t *out);
+extern uint16_t load_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir,
+                                      dsp_iir_2p2z_t *p_src, float full_scale);
+extern void reset_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir);
+extern void run_dsp_iir_2p2z_q15(dsp_iir_2p2z_q15_t *p_iir);
+
+extern uint16_t init_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir,
+                                      dsp_iir_3p3z_t *p_src, float full_scale,
+                                      volatile q15_t *in, volatile q15_t *out);
+extern uint16_t load_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir,
+                                      dsp_iir_3p3z_t *p_src, float full_scale);
+extern void reset_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir);
+extern void run_dsp_iir_3p3z_q15(dsp_iir_3p3z_q15_t *p_iir);
+
+extern q31_t float_to_q31(float value, float full_scale);
+extern float q31_to_float(q31_t value, float full_scale);
+
+extern void init_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim, dsp_srlim_t *p_src,
+                               float full_scale, volatile q31_t *in,
+                               volatile q31_t *out);
+extern void load_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim, dsp_srlim_t *p_src,
+                               float full_scale);
+extern void reset_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim);
+extern void run_dsp_srlim_q31(dsp_srlim_q31_t *p_srlim);
+
+extern uint16_t init_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf, dsp_lpf_t *p_src,
+                                 volatile q31_t *in, volatile q31_t *out);
+extern uint16_t load_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf, dsp_lpf_t *p_src);
+extern void reset_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf);
+extern void run_dsp_lpf_q31(dsp_lpf_q31_t *p_lpf);
+
+extern uint16_t init_dsp_pi_q31(dsp_pi_q31_t *p_pi, dsp_pi_t *p_src,
+                                float full_scale, volatile q31_t *in,
+                                volatile q31_t *out);
+extern uint16_t load_dsp_pi_q31(dsp_pi_q31_t *p_pi, dsp_pi_t *p_src,
+                                float full_scale);
+extern void reset_dsp_pi_q31(dsp_pi_q31_t *p_pi);
+extern void run_dsp_pi_q31(dsp_pi_q31_t *p_pi);
+
+extern uint16_t init_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir,
+                                      dsp_iir_2p2z_t *p_src, float full_scale,
+                                      volatile q31_t *in, volatile q31_t *out);
+extern uint16_t load_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir,
+                                      dsp_iir_2p2z_t *p_src, float full_scale);
+extern void reset_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir);
+extern void run_dsp_iir_2p2z_q31(dsp_iir_2p2z_q31_t *p_iir);
+
+extern uint16_t init_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir,
+                                      dsp_iir_3p3z_t *p_src, float full_scale,
+                                      volatile q31_t *in, volatile q31_t *out);
+extern uint16_t load_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir,
+                                      dsp_iir_3p3z_t *p_src, float full_scale);
+extern void reset_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir);
+extern void run_dsp_iir_3p3z_q31(dsp_iir_3p3z_q31_t *p_iir);
+
+#endif /* DSP_Q_H_ */
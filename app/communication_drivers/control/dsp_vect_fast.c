@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_vect_fast.c
+ * @brief Prepared matrix-vector product
+ *
+ * Kernels of prepared matrix-vector product, selected at configuration time.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_vect_fast.h"
+
+/**
+ * Prepare matrix-vector product for fast execution. Matrix is copied from
+ * module, so this must be called again whenever it's reconfigured.
+ *
+ * If allowed, CSR format is selected when at least half of matrix elements
+ * are zero. Otherwise, 2x2, 4x4 and 8x8 matrices use unrolled kernels.
+ *
+ * @param p_fast
+ * @param p_vect_product
+ * @param allow_sparse
+ */
+void load_dsp_vect_product_fast(dsp_vect_product_fast_t *p_fast,
+                                dsp_vect_product_t *p_vect_product,
+                                bool allow_sparse)
+{
+    uint16_t r, c, nnz, num_rows, num_cols;
+    float value;
+
+    num_rows = (uint16_t) p_vect_product->matrix.coeffs.s.num_rows;
+    num_cols = (uint16_t) p_vect_product->matrix.coeffs.s.num_cols;
+
+    if(num_rows > NUM_MAX_MATRIX_SIZE)
+    {
+        num_rows = NUM_MAX_MATRIX_SIZE;
+    }
+
+    if(num_cols > NUM_MAX_MATRIX_SIZE)
+    {
+        num_cols = NUM_MAX_MATRIX_SIZE;
+    }
+
+    p_fast->num_rows = num_rows;
+    p_fast->num_cols = num_cols;
+    p_fast->in = p_vect_product->in;
+    p_fast->out = p_vect_product->out;
+
+    nnz = 0;
+    for(r = 0; r < num_rows; r++)
+    {
+        for(c = 0; c < num_cols; c++)
+        {
+            if(p_vect_product->matrix.coeffs.s.data[r][c] != 0.0)
+            {
+                nnz++;
+            }
+        }
+    }
+
+    if( allow_sparse && (2*nnz <= num_rows*num_cols) )
+    {
+        p_fast->kernel = Vect_Product_CSR;
+
+        nnz = 0;
+        for(r = 0; r < num_rows; r++)
+        {
+            p_fast->row_ptr[r] = nnz;
+
+            for(c = 0; c < num_cols; c++)
+            {
+                value = p_vect_product->matrix.coeffs.s.data[r][c];
+
+                if(value != 0.0)
+                {
+                    p_fast->data[nnz] = value;
+                    p_fast->col_idx[nnz] = c;
+                    nnz++;
+                }
+            }
+        }
+
+        p_fast->row_ptr[num_rows] = nnz;
+    }
+
+    else
+    {
+        for(r = 0; r < num_rows; r++)
+        {
+            for(c = 0; c < num_cols; c++)
+            {
+                p_fast->data[r*num_cols + c] =
+                        p_vect_product->matrix.coeffs.s.data[r][c];
+            }
+        }
+
+        if( (num_rows == 2) && (num_cols == 2) )
+        {
+            p_fast->kernel = Vect_Product_2x2;
+        }
+        else if( (num_rows == 4) && (num_cols == 4) )
+        {
+            p_fast->kernel = Vect_Product_4x4;
+        }
+        else if( (num_rows == 8) && (num_cols == 8) )
+        {
+            p_fast->kernel = Vect_Product_8x8;
+        }
+        else
+        {
+            p_fast->kernel = Vect_Product_Dense;
+        }
+    }
+}
+
+static void run_vect_product_dense(dsp_vect_product_fast_t *p_fast)
+{
+    uint16_t r, c;
+    float acc;
+    float in[NUM_MAX_MATRIX_SIZE];
+    const float *p_row = p_fast->data;
+
+    for(c = 0; c < p_fast->num_cols; c++)
+    {
+        in[c] = p_fast->in[c];
+    }
+
+    for(r = 0; r < p_fast->num_rows; r++)
+    {
+        acc = 0.0;
+
+        for(c = 0; c < p_fast->num_cols; c++)
+        {
+            acc += p_row[c] * in[c];
+        }
+
+        p_fast->out[r] = acc;
+        p_row += p_fast->num_cols;
+    }
+}
+
+static void run_vect_product_2x2(dsp_vect_product_fast_t *p_fast)
+{
+    float in0 = p_fast->in[0];
+    float in1 = p_fast->in[1];
+    const float *m = p_fast->data;
+
+    p_fast->out[0] = m[0]*in0 + m[1]*in1;
+    p_fast->out[1] = m[2]*in0 + m[3]*in1;
+}
+
+static void run_vect_product_4x4(dsp_vect_product_fast_t *p_fast)
+{
+    uint16_t r;
+    float in0 = p_fast->in[0];
+    float in1 = p_fast->in[1];
+    float in2 = p_fast->in[2];
+    float in3 = p_fast->in[3];
+    const float *m = p_fast->data;
+
+    for(r = 0; r < 4; r++)
+    {
+        p_fast->out[r] = m[0]*in0 + m[1]*in1 + m[2]*in2 + m[3]*in3;
+        m += 4;
+    }
+}
+
+static void run_vect_product_8x8(dsp_vect_product_fast_t *p_fast)
+{
+    uint16_t r;
+    float in0 = p_fast->in[0];
+    float in1 = p_fast->in[1];
+    float in2 = p_fast->in[2];
+    float in3 = p_fast->in[3];
+    float in4 = p_fast->in[4];
+    float in5 = p_fast->in[5];
+    float in6 = p_fast->in[6];
+    float in7 = p_fast->in[7];
+    const float *m = p_fast->data;
+
+    for(r = 0; r < 8; r++)
+    {
+        p_fast->out[r] = m[0]*in0 + m[1]*in1 + m[2]*in2 + m[3]*in3 +
+                         m[4]*in4 + m[5]*in5 + m[6]*in6 + m[7]*in7;
+        m += 8;
+    }
+}
+
+static void run_vect_product_csr(dsp_vect_product_fast_t *p_fast)
+{
+    uint16_t r, i;
+    float acc;
+    float in[NUM_MAX_MATRIX_SIZE];
+
+    for(i = 0; i < p_fast->num_cols; i++)
+    {
+        in[i] = p_fast->in[i];
+    }
+
+    for(r = 0; r < p_fast->num_rows; r++)
+    {
+        acc = 0.0;
+
+        for(i = p_fast->row_ptr[r]; i < p_fast->row_ptr[r+1]; i++)
+        {
+            acc += p_fast->data[i] * in[p_fast->col_idx[i]];
+        }
+
+        p_fast->out[r] = acc;
+    }
+}
+
+/**
+ * Run matrix-vector product with kernel selected on configuration. Input
+ * vector is read once and each output element is written once.
+ *
+ * @param p_fast
+ */
+void run_dsp_vect_product_fast(dsp_vect_product_fast_t *p_fast)
+{
+    switch(p_fast->kernel)
+    {
+        case Vect_Product_2x2:
+        {
+            run_vect_product_2x2(p_fast);
+            break;
+        }
+
+        case Vect_Product_4x4:
+        {
+            run_vect_product_4x4(p_fast);
+            break;
+        }
+
+        case Vect_Product_8x8:
+        {
+            run_vect_product_8x8(p_fast);
+            break;
+        }
+
+        case Vect_Product_CSR:
+        {
+            run_vect_product_csr(p_fast);
+            break;
+        }
+
+        default:
+        {
+            run_vect_product_dense(p_fast);
+            break;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_vect_fast.h
+ * @brief Prepared matrix-vector product
+ *
+ * Matrix-vector product of dsp_vect_product_t prepared for execution, with
+ * unrolled kernels for small square matrices and CSR kernel for sparse ones.
+ * It isn't used by ARM firmware, so this module is kept out of its build and
+ * its functions aren't placed in RAM.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef DSP_VECT_FAST_H_
+#define DSP_VECT_FAST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp.h"
+
+/**
+ * Matrix-vector product prepared for execution: dimensions are integers,
+ * matrix is packed row by row and a kernel is selected at configuration
+ * time. Small square matrices use unrolled kernels and sparse matrices may
+ * be stored in CSR format (Compressed Sparse Row), so only non-zero
+ * elements are multiplied.
+ */
+typedef enum
+{
+    Vect_Product_Dense,
+    Vect_Product_2x2,
+    Vect_Product_4x4,
+    Vect_Product_8x8,
+    Vect_Product_CSR
+} dsp_vect_product_kernel_t;
+
+typedef struct
+{
+    dsp_vect_product_kernel_t   kernel;
+    uint16_t                    num_rows;
+    uint16_t                    num_cols;
+    float                       data[NUM_MAX_MATRIX_SIZE*NUM_MAX_MATRIX_SIZE];
+    uint8_t                     col_idx[NUM_MAX_MATRIX_SIZE*NUM_MAX_MATRIX_SIZE];
+    uint8_t                     row_ptr[NUM_MAX_MATRIX_SIZE + 1];
+    volatile float              *in;
+    volatile float              *out;
+} dsp_vect_product_fast_t;
+
+extern void load_dsp_vect_product_fast(dsp_vect_product_fast_t *p_fast,
+                                       dsp_vect_product_t *p_vect_product,
+                                       bool allow_sparse);
+extern void run_dsp_vect_product_fast(dsp_vect_product_fast_t *p_fast);
+
+#endif /* DSP_VECT_FAST_H_ */
@@ -46,6 +46,8 @@
 #include "communication_drivers/i2c_onboard/eeprom.h"
 #include "communication_drivers/flash/flash_mem.h"
 #include "communication_drivers/bsmp/bsmp_lib.h"
+#include "communication_drivers/profiler/profiler.h"
+#include "communication_drivers/timer/timer.h"
 
 #include "uip/uip.h"
 #include "uip/uip_arp.h"
@@ -425,6 +427,7 @@ clock_time_t clock_time(void)
 void isr_ethernet(void)
 {
     unsigned long ulTemp;
+    uint32_t t_start = get_cycle_counter();
 
     // Read and Clear the interrupt.
     ulTemp = EthernetIntStatus(ETH_BASE, false);
@@ -464,6 +467,8 @@ void isr_ethernet(void)
             HWREGBITW(&g_ulFlags, FLAG_TXPKT) = 0;
         }
     }
+
+    prof_record(PROF_ISR_ETHERNET, get_cycle_counter() - t_start);
 }
 
 //*****************************************************************************
@@ -19,6 +19,7 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
@@ -29,9 +30,11 @@
 #include "i2c_onboard.h"
 #include "hardware_def.h"
 #include "eeprom.h"
+#include "eeprom_queue.h"
 
 #include "communication_drivers/common/structs.h"
 #include "communication_drivers/control/dsp.h"
+#include "communication_drivers/timer/timer.h"
 
 //***********************************************************************************
 //  The memory address is compose of 13bits (2 bytes)
@@ -81,153 +84,245 @@ const uint16_t num_dsp_modules[NUM_DSP_CLASSES] =
 static uint8_t data_eeprom[64];
 volatile unsigned long ulLoop;
 
+/**
+ * Write-back buffer: consecutive bytes on the same EEPROM page are coalesced
+ * into a single page write. It holds address (2 bytes) followed by data.
+ */
+static uint8_t wb_data[2 + EEPROM_PAGE_SIZE];
+static uint16_t wb_add;
+static uint16_t wb_len = 0;
+
 //***********************************************************************************
 
-uint8_t save_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id)
+/**
+ * @brief Wait for EEPROM internal write cycle
+ *
+ * Poll EEPROM acknowledge, instead of waiting for the worst case write cycle.
+ *
+ * @return 1 if EEPROM is ready, 0 if it timed out
+ */
+uint8_t eeprom_wait_write_cycle(void)
 {
-    static u_uint16_t u_add;
-    static uint8_t *p_val, size_coeffs;
+    uint32_t t_start;
 
-    size_coeffs = 4*num_coeffs_dsp_module[dsp_class];
+    t_start = get_cycle_counter();
 
-    // Increment element position on parameter address and prepare for EEPROM
-    u_add.u16 = dsp_modules_eeprom_add[dsp_class] + id*size_coeffs;
-    data_eeprom[0] = u_add.u8[1];
-    data_eeprom[1] = u_add.u8[0];
-
-    // Perform typecast of pointer to coefficients avoid local copy of them
-    switch(dsp_class)
+    while(!ack_poll_i2c(I2C_SLV_ADDR_EEPROM))
     {
-        case DSP_SRLim:
+        if( (get_cycle_counter() - t_start) >
+            (EEPROM_WRITE_TIMEOUT_US * CYCLES_PER_US) )
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_srlim[id].coeffs.f;
-            break;
+            return 0;
         }
+    }
 
-        case DSP_LPF:
-        {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_lpf[id].coeffs.f;
-            break;
-        }
+    return 1;
+}
 
-        case DSP_PI:
-        {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_pi[id].coeffs.f;
-            break;
-        }
-        case DSP_IIR_2P2Z:
-        {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_iir_2p2z[id].coeffs.f;
-            break;
-        }
+/**
+ * @brief Write pending data from write-back buffer into EEPROM
+ *
+ * @return 1 if successful, 0 if EEPROM write cycle timed out
+ */
+uint8_t eeprom_flush(void)
+{
+    uint8_t ok;
+    u_uint16_t u_add;
 
-        case DSP_IIR_3P3Z:
+    if(!wb_len)
+    {
+        return 1;
+    }
+
+    u_add.u16 = wb_add;
+    wb_data[0] = u_add.u8[1];
+    wb_data[1] = u_add.u8[0];
+
+    GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
+    write_i2c(I2C_SLV_ADDR_EEPROM, 2 + wb_len, wb_data);
+    ok = eeprom_wait_write_cycle();
+    GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
+
+    wb_len = 0;
+
+    return ok;
+}
+
+/**
+ * @brief Buffered write into EEPROM
+ *
+ * Data is appended to write-back buffer, which is flushed into EEPROM when
+ * a page boundary is reached or when data isn't consecutive to the pending
+ * one. ```eeprom_flush()``` must be called after the last write.
+ *
+ * @param add EEPROM address
+ * @param data pointer to data
+ * @param size number of bytes
+ * @return 1 if successful, 0 if EEPROM write cycle timed out
+ */
+uint8_t eeprom_write_buffered(uint16_t add, uint8_t *data, uint16_t size)
+{
+    uint8_t ok = 1;
+
+    while(size--)
+    {
+        if(wb_len && (add != wb_add + wb_len))
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_iir_3p3z[id].coeffs.f;
-            break;
+            ok &= eeprom_flush();
         }
 
-        case DSP_VdcLink_FeedForward:
+        if(!wb_len)
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_ff[id].coeffs.f;
-            break;
+            wb_add = add;
         }
 
-        default:
+        wb_data[2 + wb_len++] = *(data++);
+        add++;
+
+        if( !(add % EEPROM_PAGE_SIZE) )
         {
-            return 0;
+            ok &= eeprom_flush();
         }
     }
 
-    // Prepare EEPROM data
-    memcpy(&data_eeprom[2], p_val, size_coeffs);
-
-    if( size_coeffs > 32 )
-    {
-        // Send new parameter to EEPROM
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
-        write_i2c(I2C_SLV_ADDR_EEPROM, 2+32, data_eeprom);
-        for (ulLoop=0;ulLoop<100000;ulLoop++){};
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
+    return ok;
+}
 
-        u_add.u16 += 32;
-        data_eeprom[0] = u_add.u8[1];
-        data_eeprom[1] = u_add.u8[0];
-        memcpy(&data_eeprom[2], &data_eeprom[34], size_coeffs-32);
+/**
+ * @brief Write into EEPROM with page writes
+ *
+ * @param add EEPROM address
+ * @param data pointer to data
+ * @param size number of bytes
+ * @return 1 if successful, 0 if EEPROM write cycle timed out
+ */
+uint8_t eeprom_write(uint16_t add, uint8_t *data, uint16_t size)
+{
+    uint8_t ok;
 
-        // Send new parameter to EEPROM
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
-        write_i2c(I2C_SLV_ADDR_EEPROM, 2+(size_coeffs-32), data_eeprom);
-        for (ulLoop=0;ulLoop<100000;ulLoop++){};
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
-    }
-    else
-    {
-        // Send new parameter to EEPROM
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
-        write_i2c(I2C_SLV_ADDR_EEPROM, 2+size_coeffs, data_eeprom);
-        for (ulLoop=0;ulLoop<100000;ulLoop++){};
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
-    }
+    ok = eeprom_write_buffered(add, data, size);
+    ok &= eeprom_flush();
 
-    return 1;
+    return ok;
 }
 
-uint8_t load_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id)
+/**
+ * @brief Sequential read from EEPROM
+ *
+ * Whole data is read in a single I2C transaction. First two bytes of
+ * ```data``` are used to send EEPROM address, before being overwritten.
+ *
+ * @param add EEPROM address
+ * @param data pointer to destination, with at least 2 bytes
+ * @param size number of bytes
+ */
+void eeprom_read(uint16_t add, uint8_t *data, uint16_t size)
 {
-    static u_uint16_t u_add;
-    static uint8_t *p_val, size_coeffs;
+    u_uint16_t u_add;
 
-    size_coeffs = 4*num_coeffs_dsp_module[dsp_class];
+    u_add.u16 = add;
+    data[0] = u_add.u8[1];
+    data[1] = u_add.u8[0];
 
-    // Increment element position on parameter address and prepare for EEPROM
-    u_add.u16 = dsp_modules_eeprom_add[dsp_class] + id*size_coeffs;
-    data_eeprom[0] = u_add.u8[1];
-    data_eeprom[1] = u_add.u8[0];
+    read_i2c(I2C_SLV_ADDR_EEPROM, DOUBLE_ADDRESS, size, data);
+}
+
+//***********************************************************************************
+
+/**
+ * @brief Get pointer to coefficients of specified DSP module
+ *
+ * @param dsp_class DSP class
+ * @param id ID of DSP module
+ * @return pointer to coefficients, or NULL if module is invalid
+ */
+static uint8_t * get_dsp_coeffs_pointer(dsp_class_t dsp_class, uint16_t id)
+{
+    if( (dsp_class >= NUM_DSP_CLASSES) || (id >= num_dsp_modules[dsp_class]) )
+    {
+        return NULL;
+    }
 
-    // Perform typecast of pointer to coefficients avoid local copy of them
     switch(dsp_class)
     {
         case DSP_SRLim:
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_srlim[id].coeffs.f;
-            break;
+            return (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_srlim[id].coeffs.f;
         }
 
         case DSP_LPF:
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_lpf[id].coeffs.f;
-            break;
+            return (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_lpf[id].coeffs.f;
         }
 
         case DSP_PI:
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_pi[id].coeffs.f;
-            break;
+            return (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_pi[id].coeffs.f;
         }
+
         case DSP_IIR_2P2Z:
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_iir_2p2z[id].coeffs.f;
-            break;
+            return (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_iir_2p2z[id].coeffs.f;
         }
 
         case DSP_IIR_3P3Z:
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_iir_3p3z[id].coeffs.f;
-            break;
+            return (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_iir_3p3z[id].coeffs.f;
         }
 
         case DSP_VdcLink_FeedForward:
         {
-            p_val = (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_ff[id].coeffs.f;
-            break;
+            return (uint8_t *) &g_controller_mtoc.dsp_modules.dsp_ff[id].coeffs.f;
         }
 
         default:
         {
-            return 0;
+            return NULL;
         }
     }
+}
+
+uint8_t save_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id)
+{
+    static u_uint16_t u_add;
+    static uint8_t *p_val, size_coeffs;
+
+    size_coeffs = 4*num_coeffs_dsp_module[dsp_class];
+
+    // Increment element position on parameter address and prepare for EEPROM
+    u_add.u16 = dsp_modules_eeprom_add[dsp_class] + id*size_coeffs;
+    data_eeprom[0] = u_add.u8[1];
+    data_eeprom[1] = u_add.u8[0];
+
+    // Perform typecast of pointer to coefficients avoid local copy of them
+    p_val = get_dsp_coeffs_pointer(dsp_class, id);
+    if(p_val == NULL)
+    {
+        return 0;
+    }
+
+    // Send new coefficients to EEPROM, split on page boundaries
+    return eeprom_write(u_add.u16, p_val, size_coeffs);
+}
+
+uint8_t load_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id)
+{
+    static u_uint16_t u_add;
+    static uint8_t *p_val, size_coeffs;
+
+    size_coeffs = 4*num_coeffs_dsp_module[dsp_class];
+
+    // Increment element position on parameter address and prepare for EEPROM
+    u_add.u16 = dsp_modules_eeprom_add[dsp_class] + id*size_coeffs;
+    data_eeprom[0] = u_add.u8[1];
+    data_eeprom[1] = u_add.u8[0];
+
+    // Perform typecast of pointer to coefficients avoid local copy of them
+    p_val = get_dsp_coeffs_pointer(dsp_class, id);
+    if(p_val == NULL)
+    {
+        return 0;
+    }
 
     if( size_coeffs > 32 )
     {
@@ -274,6 +369,66 @@ void save_dsp_modules_eeprom(void)
     }
 }
 
+/**
+ * @brief Post coefficients of specified DSP module into EEPROM write queue
+ *
+ * @param dsp_class DSP class
+ * @param id ID of DSP module
+ * @return 1 if successful, 0 if module is invalid or queue is full
+ */
+uint8_t post_save_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id)
+{
+    uint8_t *p_val;
+    uint16_t size_coeffs;
+
+    p_val = get_dsp_coeffs_pointer(dsp_class, id);
+    if(p_val == NULL)
+    {
+        return 0;
+    }
+
+    size_coeffs = 4*num_coeffs_dsp_module[dsp_class];
+
+    return post_eeprom_write(dsp_modules_eeprom_add[dsp_class] + id*size_coeffs,
+                             p_val, size_coeffs, NULL);
+}
+
+/**
+ * @brief Post coefficients of all DSP modules into EEPROM write queue
+ *
+ * Modules are posted only if there's room for all of them.
+ *
+ * @return 1 if successful, 0 if queue doesn't have enough room
+ */
+uint8_t post_save_dsp_modules_eeprom(void)
+{
+    dsp_class_t dsp_class;
+    uint16_t    id, num_modules = 0;
+
+    for(dsp_class = 0; dsp_class < NUM_DSP_CLASSES; dsp_class++)
+    {
+        if(get_dsp_coeffs_pointer(dsp_class, 0) != NULL)
+        {
+            num_modules += num_dsp_modules[dsp_class];
+        }
+    }
+
+    if(available_eeprom_queue() < num_modules)
+    {
+        return 0;
+    }
+
+    for(dsp_class = 0; dsp_class < NUM_DSP_CLASSES; dsp_class++)
+    {
+        for(id = 0; id < num_dsp_modules[dsp_class]; id++)
+        {
+            post_save_dsp_coeffs_eeprom(dsp_class, id);
+        }
+    }
+
+    return 1;
+}
+
 void load_dsp_modules_eeprom(void)
 {
     dsp_class_t dsp_class;
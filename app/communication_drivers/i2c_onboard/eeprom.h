@@ -26,10 +26,23 @@
 
 #define I2C_SLV_ADDR_EEPROM 0x50        // 7 bits address
 
+#define EEPROM_PAGE_SIZE    32
+#define EEPROM_WRITE_TIMEOUT_US  10000   // Max write cycle is 5 ms
+
+extern uint8_t eeprom_wait_write_cycle(void);
+extern uint8_t eeprom_write_buffered(uint16_t add, uint8_t *data,
+                                     uint16_t size);
+extern uint8_t eeprom_flush(void);
+extern uint8_t eeprom_write(uint16_t add, uint8_t *data, uint16_t size);
+extern void eeprom_read(uint16_t add, uint8_t *data, uint16_t size);
+
 extern uint8_t save_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id);
 extern uint8_t load_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id);
 
 extern void save_dsp_modules_eeprom(void);
 extern void load_dsp_modules_eeprom(void);
 
+extern uint8_t post_save_dsp_coeffs_eeprom(dsp_class_t dsp_class, uint16_t id);
+extern uint8_t post_save_dsp_modules_eeprom(void);
+
 #endif /* EEPROM_H_ */
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file eeprom_queue.c
+ * @brief EEPROM write queue module.
+ *
+ * Source code for background EEPROM writer. Each call of
+ * ```process_eeprom_queue()``` either polls EEPROM acknowledge for the end
+ * of the last write cycle, or sends the next page of the job at the head of
+ * the queue. Write protection is released only while a page write is in
+ * progress.
+ *
+ * Jobs are posted from BSMP functions, which run on ```TaskCheck()``` as the
+ * queue processing, so no locking is required.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+
+#include "driverlib/gpio.h"
+
+#include "board_drivers/hardware_def.h"
+#include "communication_drivers/timer/timer.h"
+
+#include "i2c_onboard.h"
+#include "eeprom.h"
+#include "eeprom_queue.h"
+
+static eeprom_job_t eeprom_queue[EEPROM_QUEUE_SIZE];
+static uint16_t eeprom_queue_head;
+static uint16_t eeprom_queue_tail;
+static uint16_t eeprom_queue_count;
+
+static bool eeprom_write_cycle;
+static uint32_t t_write_cycle;
+
+/**
+ * Address (2 bytes) followed by page data
+ */
+static uint8_t page_data[2 + EEPROM_PAGE_SIZE];
+
+volatile eeprom_queue_stats_t g_eeprom_queue_stats;
+
+/**
+ * @brief Initialize EEPROM write queue
+ */
+void init_eeprom_queue(void)
+{
+    eeprom_queue_head = 0;
+    eeprom_queue_tail = 0;
+    eeprom_queue_count = 0;
+    eeprom_write_cycle = false;
+
+    memset((void *) &g_eeprom_queue_stats, 0, sizeof(eeprom_queue_stats_t));
+    g_eeprom_queue_stats.status = EEPROM_Idle;
+}
+
+/**
+ * @brief Post EEPROM write job
+ *
+ * @param add EEPROM address
+ * @param p_src Pointer to data, which must remain valid until it's written
+ * @param size Number of bytes
+ * @param complete Function to be called when job is finished
+ *
+ * @return 1 if job was queued, 0 if queue is full
+ */
+uint8_t post_eeprom_write(uint16_t add, uint8_t *p_src, uint16_t size,
+                          void (*complete)(uint8_t success))
+{
+    eeprom_job_t *p_job;
+
+    if(eeprom_queue_count >= EEPROM_QUEUE_SIZE)
+    {
+        return 0;
+    }
+
+    if(size)
+    {
+        p_job = &eeprom_queue[eeprom_queue_tail];
+
+        p_job->add    = add;
+        p_job->size   = size;
+        p_job->offset = 0;
+        p_job->p_src  = p_src;
+        p_job->complete = complete;
+        p_job->success  = 1;
+
+        if(!eeprom_queue_count)
+        {
+            g_eeprom_queue_stats.status = EEPROM_Busy;
+        }
+
+        eeprom_queue_tail = (eeprom_queue_tail + 1) % EEPROM_QUEUE_SIZE;
+        eeprom_queue_count++;
+
+        g_eeprom_queue_stats.pending_bytes.u32 += size;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Process EEPROM write queue
+ *
+ * Non-blocking, except for the I2C transfer of a single page.
+ */
+void process_eeprom_queue(void)
+{
+    uint16_t size;
+    u_uint16_t u_add;
+    eeprom_job_t *p_job;
+
+    if(eeprom_write_cycle)
+    {
+        p_job = &eeprom_queue[eeprom_queue_head];
+
+        if(!ack_poll_i2c(I2C_SLV_ADDR_EEPROM))
+        {
+            if( (get_cycle_counter() - t_write_cycle) <
+                (EEPROM_WRITE_TIMEOUT_US * CYCLES_PER_US) )
+            {
+                return;
+            }
+
+            g_eeprom_queue_stats.timeouts++;
+            g_eeprom_queue_stats.status = EEPROM_Error;
+            p_job->success = 0;
+        }
+
+        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
+        eeprom_write_cycle = false;
+
+        /**
+         * Job is finished only after write cycle of its last page
+         */
+        if(p_job->offset >= p_job->size)
+        {
+            eeprom_queue_head = (eeprom_queue_head + 1) % EEPROM_QUEUE_SIZE;
+            eeprom_queue_count--;
+            g_eeprom_queue_stats.completed++;
+
+            if(p_job->complete)
+            {
+                p_job->complete(p_job->success);
+            }
+        }
+    }
+
+    if(!eeprom_queue_count)
+    {
+        if(g_eeprom_queue_stats.status == EEPROM_Busy)
+        {
+            g_eeprom_queue_stats.status = EEPROM_Idle;
+        }
+        return;
+    }
+
+    p_job = &eeprom_queue[eeprom_queue_head];
+
+    /**
+     * Write until end of job or page boundary
+     */
+    u_add.u16 = p_job->add + p_job->offset;
+    size = EEPROM_PAGE_SIZE - (u_add.u16 % EEPROM_PAGE_SIZE);
+    if(size > p_job->size - p_job->offset)
+    {
+        size = p_job->size - p_job->offset;
+    }
+
+    page_data[0] = u_add.u8[1];
+    page_data[1] = u_add.u8[0];
+    memcpy(&page_data[2], p_job->p_src + p_job->offset, size);
+
+    GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
+    write_i2c(I2C_SLV_ADDR_EEPROM, 2 + size, page_data);
+
+    eeprom_write_cycle = true;
+    t_write_cycle = get_cycle_counter();
+
+    p_job->offset += size;
+    g_eeprom_queue_stats.pending_bytes.u32 -= size;
+}
+
+/**
+ * @brief Check whether EEPROM is being written by the queue
+ *
+ * Synchronous EEPROM access must not be performed while it's busy.
+ *
+ * @return 1 if there are pending jobs or a write cycle in progress
+ */
+uint8_t eeprom_queue_busy(void)
+{
+    return (eeprom_queue_count || eeprom_write_cycle);
+}
+
+/**
+ * @brief Get number of free job slots
+ *
+ * @return Number of jobs which may be posted
+ */
+uint16_t available_eeprom_queue(void)
+{
+    return EEPROM_QUEUE_SIZE - eeprom_queue_count;
+}
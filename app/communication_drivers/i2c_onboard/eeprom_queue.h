@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file eeprom_queue.h
+ * @brief EEPROM write queue module.
+ *
+ * Background writer for onboard EEPROM. Write jobs are posted by the
+ * communication interfaces and written from ```TaskCheck()```, one page at a
+ * time, so saving parameters never blocks serial communication.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef EEPROM_QUEUE_H_
+#define EEPROM_QUEUE_H_
+
+#include <stdint.h>
+#include "communication_drivers/common/structs.h"
+
+/**
+ * Enough to save parameters bank image and all DSP modules at once
+ */
+#define EEPROM_QUEUE_SIZE       32
+
+typedef enum
+{
+    EEPROM_Idle,
+    EEPROM_Busy,
+    EEPROM_Error
+} eeprom_queue_status_t;
+
+/**
+ * Write job. Data is read from ```p_src``` only when its page is written, so
+ * the latest value is saved. ```complete``` is called after the write cycle
+ * of its last page, with 0 if any write cycle of the job timed out. It's
+ * optional.
+ */
+typedef struct
+{
+    uint16_t    add;
+    uint16_t    size;
+    uint16_t    offset;
+    uint8_t     *p_src;
+    void        (*complete)(uint8_t success);
+    uint8_t     success;
+} eeprom_job_t;
+
+/**
+ * Queue status, mapped into BSMP variables. ```status``` is EEPROM_Error if
+ * any write cycle timed out since a job was posted into the empty queue.
+ */
+typedef struct
+{
+    uint8_t     status;
+    u_uint32_t  pending_bytes;
+    uint32_t    completed;
+    uint32_t    timeouts;
+} eeprom_queue_stats_t;
+
+extern volatile eeprom_queue_stats_t g_eeprom_queue_stats;
+
+extern void init_eeprom_queue(void);
+extern uint8_t post_eeprom_write(uint16_t add, uint8_t *p_src, uint16_t size,
+                                 void (*complete)(uint8_t success));
+extern void process_eeprom_queue(void);
+extern uint8_t eeprom_queue_busy(void);
+extern uint16_t available_eeprom_queue(void);
+
+#endif /* EEPROM_QUEUE_H_ */
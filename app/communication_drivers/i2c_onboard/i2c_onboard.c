@@ -42,7 +42,7 @@
 
 #define I2CWhileMasterBusy while (I2CMasterBusy(I2C_ONBOARD_MASTER_BASE)) {}
 
-void read_i2c(uint8_t SLAVE_ADDR, uint8_t TYPE_REGISTER_ADDR, uint8_t MESSAGE_SIZE, uint8_t *data)
+void read_i2c(uint8_t SLAVE_ADDR, uint8_t TYPE_REGISTER_ADDR, uint16_t MESSAGE_SIZE, uint8_t *data)
 {
     if(MESSAGE_SIZE < 2)
     {
@@ -102,6 +102,33 @@ void write_i2c(uint8_t SLAVE_ADDR, uint8_t MESSAGE_SIZE, uint8_t *data)
 	}
 }
 
+/**
+ * @brief Poll slave acknowledge
+ *
+ * Send slave address and check whether it's acknowledged. EEPROMs don't
+ * acknowledge while an internal write cycle is in progress.
+ *
+ * @param SLAVE_ADDR 7 bits address of slave
+ * @return 1 if slave acknowledged, 0 otherwise
+ */
+uint8_t ack_poll_i2c(uint8_t SLAVE_ADDR)
+{
+    uint32_t err;
+
+    I2CMasterSlaveAddrSet(I2C_ONBOARD_MASTER_BASE, SLAVE_ADDR, I2C_WRITE);
+
+    I2CMasterDataPut(I2C_ONBOARD_MASTER_BASE, 0);
+    I2CMasterControl(I2C_ONBOARD_MASTER_BASE, I2C_MASTER_CMD_BURST_SEND_START);
+    I2CWhileMasterBusy
+
+    err = I2CMasterErr(I2C_ONBOARD_MASTER_BASE);
+
+    I2CMasterControl(I2C_ONBOARD_MASTER_BASE, I2C_MASTER_CMD_BURST_SEND_ERROR_STOP);
+    I2CWhileMasterBusy
+
+    return (err == I2C_MASTER_ERR_NONE);
+}
+
 void init_i2c_onboard(void)
 {
 	// I2C0 configuration (EEPROM memory, IO expander e Temperature sensor.)
@@ -28,7 +28,8 @@
 
 extern void init_i2c_onboard(void);
 
-extern void read_i2c(uint8_t SLAVE_ADDR, uint8_t TYPE_REGISTER_ADDR, uint8_t MESSAGE_SIZE, uint8_t *data);
+extern void read_i2c(uint8_t SLAVE_ADDR, uint8_t TYPE_REGISTER_ADDR, uint16_t MESSAGE_SIZE, uint8_t *data);
 extern void write_i2c(uint8_t SLAVE_ADDR, uint8_t MESSAGE_SIZE, uint8_t *data);
+extern uint8_t ack_poll_i2c(uint8_t SLAVE_ADDR);
 
 #endif /* I2C_ONBOARD_H_ */
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file ipc_cmd_queue.c
+ * @brief IPC command queue module.
+ *
+ * Source code for non-blocking queue of low priority IPC messages. All low
+ * priority messages share the same MTOCIPCSET flag, so only one can be in
+ * flight at a time. Instead of spinning on this flag, commands are posted
+ * into a ring buffer and ```process_ipc_cmd_queue()``` dispatches the next
+ * one whenever C28 acknowledges the previous.
+ *
+ * C28 acknowledge clears the flag without generating an interrupt on ARM,
+ * so the queue is processed from ```TaskCheck()```, from the CtoM low
+ * priority ISR and whenever a new command is posted.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "driverlib/interrupt.h"
+
+#include "communication_drivers/timer/timer.h"
+
+#include "ipc_cmd_queue.h"
+
+#pragma CODE_SECTION(process_ipc_cmd_queue, "ramfuncs");
+
+static ipc_cmd_t ipc_cmd_queue[IPC_CMD_QUEUE_SIZE];
+static volatile uint16_t ipc_cmd_head;
+static volatile uint16_t ipc_cmd_tail;
+static volatile uint16_t ipc_cmd_count;
+static volatile bool ipc_cmd_lock;
+
+volatile ipc_cmd_queue_stats_t g_ipc_cmd_queue_stats;
+
+/**
+ * @brief Initialize IPC command queue
+ */
+void init_ipc_cmd_queue(void)
+{
+    uint16_t i;
+
+    for(i = 0; i < IPC_CMD_QUEUE_SIZE; i++)
+    {
+        ipc_cmd_queue[i].status = Cmd_Free;
+    }
+
+    ipc_cmd_head = 0;
+    ipc_cmd_tail = 0;
+    ipc_cmd_count = 0;
+    ipc_cmd_lock = false;
+
+    memset((void *) &g_ipc_cmd_queue_stats, 0, sizeof(ipc_cmd_queue_stats_t));
+}
+
+/**
+ * @brief Post low priority IPC command
+ *
+ * Copy command into queue and try to dispatch it immediately. Payload is
+ * stored in command, so it's safe to post several commands for the same
+ * power supply before they are sent.
+ *
+ * @param ps_id ID of power supply module. 0 - 3
+ * @param msg Low priority message type
+ * @param prepare Function to copy payload into g_ipc_mtoc before sending
+ * @param complete Function to be executed after C28 acknowledge
+ * @param p_data Pointer to payload
+ * @param size Size of payload in bytes, up to IPC_CMD_DATA_SIZE
+ *
+ * @return 1 if command was queued, 0 if queue is full
+ */
+uint16_t post_ipc_lowpriority_cmd(uint16_t ps_id,
+                                  ipc_mtoc_lowpriority_msg_t msg,
+                                  void (*prepare)(ipc_cmd_t *p_cmd),
+                                  void (*complete)(ipc_cmd_t *p_cmd),
+                                  uint8_t *p_data, uint16_t size)
+{
+    bool int_disabled;
+    ipc_cmd_t *p_cmd;
+
+    if(size > IPC_CMD_DATA_SIZE)
+    {
+        return 0;
+    }
+
+    int_disabled = IntMasterDisable();
+
+    if(ipc_cmd_count >= IPC_CMD_QUEUE_SIZE)
+    {
+        g_ipc_cmd_queue_stats.overflows++;
+        g_ipc_cmd_queue_stats.last_error = Cmd_Queue_Full;
+        g_ipc_cmd_queue_stats.last_error_msg = msg;
+        g_ipc_cmd_queue_stats.last_error_ps_id = ps_id;
+
+        if(!int_disabled)
+        {
+            IntMasterEnable();
+        }
+
+        return 0;
+    }
+
+    p_cmd = &ipc_cmd_queue[ipc_cmd_tail];
+
+    p_cmd->ps_id    = ps_id;
+    p_cmd->msg      = msg;
+    p_cmd->prepare  = prepare;
+    p_cmd->complete = complete;
+    p_cmd->t_post   = get_cycle_counter();
+
+    if(size)
+    {
+        memcpy(p_cmd->data.u8, p_data, size);
+    }
+
+    p_cmd->status = Cmd_Pending;
+
+    ipc_cmd_tail = (ipc_cmd_tail + 1) % IPC_CMD_QUEUE_SIZE;
+    ipc_cmd_count++;
+    g_ipc_cmd_queue_stats.posted++;
+
+    if(!int_disabled)
+    {
+        IntMasterEnable();
+    }
+
+    process_ipc_cmd_queue();
+
+    return 1;
+}
+
+/**
+ * @brief Process IPC command queue
+ *
+ * Check whether dispatched command was acknowledged or timed out, and
+ * dispatch next pending command when low priority flag is free. It may be
+ * called from any context: a nested call is ignored, since the outer call
+ * resumes the processing.
+ */
+void process_ipc_cmd_queue(void)
+{
+    bool int_disabled;
+    uint32_t latency;
+    ipc_cmd_t *p_cmd;
+
+    int_disabled = IntMasterDisable();
+
+    if(ipc_cmd_lock)
+    {
+        if(!int_disabled)
+        {
+            IntMasterEnable();
+        }
+        return;
+    }
+
+    ipc_cmd_lock = true;
+
+    if(!int_disabled)
+    {
+        IntMasterEnable();
+    }
+
+    while(ipc_cmd_count)
+    {
+        p_cmd = &ipc_cmd_queue[ipc_cmd_head];
+
+        if(p_cmd->status == Cmd_Dispatched)
+        {
+            if(ipc_mtoc_busy(low_priority_msg_to_reg(p_cmd->msg)))
+            {
+                if( (get_cycle_counter() - p_cmd->t_dispatch) <
+                    IPC_CMD_TIMEOUT_CYCLES )
+                {
+                    break;
+                }
+
+                g_ipc_cmd_queue_stats.timeouts++;
+                g_ipc_cmd_queue_stats.last_error = Cmd_Ack_Timeout;
+                g_ipc_cmd_queue_stats.last_error_msg = p_cmd->msg;
+                g_ipc_cmd_queue_stats.last_error_ps_id = p_cmd->ps_id;
+            }
+            else
+            {
+                latency = get_cycle_counter() - p_cmd->t_post;
+
+                g_ipc_cmd_queue_stats.completed++;
+                g_ipc_cmd_queue_stats.last_latency = latency;
+                if(latency > g_ipc_cmd_queue_stats.max_latency)
+                {
+                    g_ipc_cmd_queue_stats.max_latency = latency;
+                }
+
+                if(p_cmd->complete)
+                {
+                    p_cmd->complete(p_cmd);
+                }
+            }
+
+            int_disabled = IntMasterDisable();
+            p_cmd->status = Cmd_Free;
+            ipc_cmd_head = (ipc_cmd_head + 1) % IPC_CMD_QUEUE_SIZE;
+            ipc_cmd_count--;
+            if(!int_disabled)
+            {
+                IntMasterEnable();
+            }
+        }
+
+        else
+        {
+            /**
+             * Flag may still be set by a command which timed out
+             */
+            if(ipc_mtoc_busy(low_priority_msg_to_reg(p_cmd->msg)))
+            {
+                break;
+            }
+
+            if(p_cmd->prepare)
+            {
+                p_cmd->prepare(p_cmd);
+            }
+
+            p_cmd->t_dispatch = get_cycle_counter();
+            p_cmd->status = Cmd_Dispatched;
+            send_ipc_lowpriority_msg(p_cmd->ps_id, p_cmd->msg);
+        }
+    }
+
+    ipc_cmd_lock = false;
+}
+
+/**
+ * @brief Get number of commands in queue, including the dispatched one
+ *
+ * @return Number of commands in queue
+ */
+uint16_t size_ipc_cmd_queue(void)
+{
+    return ipc_cmd_count;
+}
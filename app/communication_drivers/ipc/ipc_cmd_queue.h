@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file ipc_cmd_queue.h
+ * @brief IPC command queue module.
+ *
+ * Non-blocking queue of low priority IPC messages from ARM to C28. Commands
+ * are posted by the communication interfaces and dispatched one at a time,
+ * as soon as the previous one is acknowledged by C28.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef IPC_CMD_QUEUE_H_
+#define IPC_CMD_QUEUE_H_
+
+#include <stdint.h>
+#include "ipc_lib.h"
+
+#define IPC_CMD_QUEUE_SIZE          16
+#define IPC_CMD_DATA_SIZE           32
+
+/**
+ * Timeout for C28 acknowledge, in M3 clock cycles (1 ms)
+ */
+#define IPC_CMD_TIMEOUT_CYCLES      75000
+
+typedef enum
+{
+    Cmd_Free,
+    Cmd_Pending,
+    Cmd_Dispatched
+} ipc_cmd_status_t;
+
+typedef enum
+{
+    Cmd_No_Error,
+    Cmd_Queue_Full,
+    Cmd_Ack_Timeout
+} ipc_cmd_error_t;
+
+typedef struct ipc_cmd ipc_cmd_t;
+
+/**
+ * Low priority IPC command. ```prepare``` is called just before the message
+ * is sent, to copy ```data``` into ```g_ipc_mtoc```. ```complete``` is called
+ * after C28 acknowledge. Both are optional.
+ */
+struct ipc_cmd
+{
+    uint16_t                    ps_id;
+    ipc_mtoc_lowpriority_msg_t  msg;
+    ipc_cmd_status_t            status;
+    void                        (*prepare)(ipc_cmd_t *p_cmd);
+    void                        (*complete)(ipc_cmd_t *p_cmd);
+    uint32_t                    t_post;
+    uint32_t                    t_dispatch;
+    union
+    {
+        uint8_t     u8[IPC_CMD_DATA_SIZE];
+        uint16_t    u16[IPC_CMD_DATA_SIZE/2];
+        uint32_t    u32[IPC_CMD_DATA_SIZE/4];
+        float       f[IPC_CMD_DATA_SIZE/4];
+    } data;
+};
+
+/**
+ * Queue statistics. Latencies are measured from post to C28 acknowledge,
+ * in M3 clock cycles. Last error keeps type, message and PS module of the
+ * last command rejected by a full queue or not acknowledged by C28, since
+ * commands are answered to host before being executed.
+ */
+typedef struct
+{
+    uint32_t    posted;
+    uint32_t    completed;
+    uint32_t    timeouts;
+    uint32_t    overflows;
+    uint32_t    last_latency;
+    uint32_t    max_latency;
+    uint16_t    last_error;
+    uint16_t    last_error_msg;
+    uint16_t    last_error_ps_id;
+} ipc_cmd_queue_stats_t;
+
+extern volatile ipc_cmd_queue_stats_t g_ipc_cmd_queue_stats;
+
+extern void init_ipc_cmd_queue(void);
+extern uint16_t post_ipc_lowpriority_cmd(uint16_t ps_id,
+                                         ipc_mtoc_lowpriority_msg_t msg,
+                                         void (*prepare)(ipc_cmd_t *p_cmd),
+                                         void (*complete)(ipc_cmd_t *p_cmd),
+                                         uint8_t *p_data, uint16_t size);
+extern void process_ipc_cmd_queue(void);
+extern uint16_t size_ipc_cmd_queue(void);
+
+#endif /* IPC_CMD_QUEUE_H_ */
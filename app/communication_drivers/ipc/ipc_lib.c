@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "inc/hw_memmap.h"
 #include "inc/hw_ipc.h"
@@ -32,8 +33,11 @@
 
 #include "communication_drivers/i2c_onboard/eeprom.h"
 #include "communication_drivers/i2c_onboard/exio.h"
+#include "communication_drivers/profiler/profiler.h"
+#include "communication_drivers/timer/timer.h"
 
 #include "ipc_lib.h"
+#include "ipc_cmd_queue.h"
 
 #define M3_CTOMMSGRAM_START         0x2007F000
 #define C28_CTOMMSGRAM_START        0x0003F800
@@ -47,6 +51,17 @@ volatile u_float_t g_buf_samples_ctom[SIZE_BUF_SAMPLES_CTOM];
 #pragma DATA_SECTION(g_buf_samples_mtoc,"SHARERAMS67")
 volatile u_float_t g_buf_samples_mtoc[SIZE_BUF_SAMPLES_MTOC];
 
+/**
+ * Readout copy of last capture on g_buf_samples_ctom
+ */
+#pragma DATA_SECTION(g_buf_samples_readout_data,"SAMPLESBUFFER")
+volatile u_float_t g_buf_samples_readout_data[SIZE_BUF_SAMPLES_CTOM];
+buf_readout_t g_buf_samples_readout;
+
+static bool buf_samples_stream = false;
+static bool buf_samples_rearm = false;
+static uint16_t buf_samples_stream_ps_id = 0;
+
 #pragma DATA_SECTION(g_ipc_ctom, "CTOM_MSG_RAM")
 #pragma DATA_SECTION(g_ipc_mtoc, "MTOC_MSG_RAM")
 volatile ipc_ctom_t g_ipc_ctom;
@@ -60,7 +75,8 @@ void init_parameters(void);
  */
 void init_ipc(void)
 {
-    volatile uint8_t uiloop, uiloop2;
+    volatile uint16_t uiloop, uiloop2;
+    uint16_t num_ps_modules;
 
     g_ipc_mtoc.msg_ctom = 0;
     g_ipc_mtoc.msg_id = 0;
@@ -72,17 +88,37 @@ void init_ipc(void)
     for (uiloop = 0; uiloop < NUM_MAX_PS_MODULES; uiloop++)
     {
         g_ipc_mtoc.ps_module[uiloop].ps_status.all = 0;
-        g_ipc_mtoc.ps_module[uiloop].ps_status.bit.model = get_param(PS_Model,0);
+        g_ipc_mtoc.ps_module[uiloop].ps_status.bit.model = get_param_u16(PS_Model, 0);
         g_ipc_mtoc.ps_module[uiloop].ps_setpoint.f = 0.0;
         g_ipc_mtoc.ps_module[uiloop].ps_reference.f = 0.0;
         g_ipc_mtoc.ps_module[uiloop].ps_soft_interlock.u32 = 0;
         g_ipc_mtoc.ps_module[uiloop].ps_hard_interlock.u32 = 0;
 
-        init_buffer(&g_ipc_mtoc.buf_samples[uiloop], &(g_buf_samples_mtoc[0].f),
-                    SIZE_BUF_SAMPLES_MTOC);
+        /**
+         * All samples buffers share the same array, so it's cleared only once
+         */
+        if(uiloop == 0)
+        {
+            init_buffer(&g_ipc_mtoc.buf_samples[uiloop],
+                        &(g_buf_samples_mtoc[0].f), SIZE_BUF_SAMPLES_MTOC);
+        }
+        else
+        {
+            init_buffer_lazy(&g_ipc_mtoc.buf_samples[uiloop],
+                             &(g_buf_samples_mtoc[0].f), SIZE_BUF_SAMPLES_MTOC);
+        }
+    }
+
+    /**
+     * Blank or corrupted EEPROM may give any number of modules
+     */
+    num_ps_modules = get_param_u16(Num_PS_Modules, 0);
+    if(num_ps_modules > NUM_MAX_PS_MODULES)
+    {
+        num_ps_modules = NUM_MAX_PS_MODULES;
     }
 
-    for (uiloop = 0; uiloop < (uint8_t) get_param(Num_PS_Modules,0); uiloop++)
+    for (uiloop = 0; uiloop < num_ps_modules; uiloop++)
     {
         g_ipc_mtoc.ps_module[uiloop].ps_status.bit.active = 1;
     }
@@ -97,6 +133,11 @@ void init_ipc(void)
      */
     init_buffer( &(WFMREF.wfmref_data), &(g_wfmref[0].f), SIZE_WFMREF);
 
+    init_buffer_readout(&g_buf_samples_readout, &g_ipc_ctom.buf_samples[0],
+                        &(g_buf_samples_ctom[0].f),
+                        &(g_buf_samples_readout_data[0].f),
+                        SIZE_BUF_SAMPLES_CTOM);
+
     /// Convert WfmRef pointers to DSP memory mapping
     WFMREF.wfmref_data.p_buf_idx.f =
             (float *) ipc_mtoc_translate((uint32_t) (WFMREF.wfmref_data.p_buf_end.f + 1));
@@ -113,6 +154,17 @@ void init_ipc(void)
     g_ipc_mtoc.dsp_module.dsp_class = 0;
     g_ipc_mtoc.dsp_module.id = 0;
 
+    /**
+     * Initialize batched commands
+     */
+    g_ipc_mtoc.batch_cmd.msg = 0;
+    g_ipc_mtoc.batch_cmd.ps_mask = 0;
+
+    /**
+     * Initialize queue of low priority messages
+     */
+    init_ipc_cmd_queue();
+
     /**
      * TODO: Initialize IPC Interrupts
      */
@@ -252,11 +304,97 @@ void get_firmwares_version(void)
 
 }
 
+static void prepare_enable_buf_samples(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.buf_samples[0].status = Buffering;
+}
+
+static void prepare_postmortem_buf_samples(ipc_cmd_t *p_cmd)
+{
+    g_ipc_mtoc.buf_samples[0].status = Postmortem;
+}
+
+/**
+ * @brief Arm a new capture of samples buffer
+ *
+ * Enable samples buffer and immediately request postmortem, so C28 fills the
+ * whole buffer once and then stops.
+ *
+ * @param ps_id ID of power supply module. 0 - 3
+ * @return 1 if capture was armed, 0 if IPC queue has no room for it
+ */
+uint16_t arm_buf_samples_capture(uint16_t ps_id)
+{
+    if(size_ipc_cmd_queue() > IPC_CMD_QUEUE_SIZE - 2)
+    {
+        return 0;
+    }
+
+    post_ipc_lowpriority_cmd(ps_id, Enable_Buf_Samples,
+                             prepare_enable_buf_samples, NULL, NULL, 0);
+    post_ipc_lowpriority_cmd(ps_id, Disable_Buf_Samples,
+                             prepare_postmortem_buf_samples, NULL, NULL, 0);
+
+    return 1;
+}
+
+/**
+ * @brief Enable streaming of samples buffer
+ *
+ * Every completed capture is frozen on readout buffer and a new one is armed.
+ * If there's a capture in progress, streaming starts as soon as it completes.
+ *
+ * @param ps_id ID of power supply module. 0 - 3
+ */
+void enable_buf_samples_stream(uint16_t ps_id)
+{
+    buf_samples_stream_ps_id = ps_id;
+    buf_samples_stream = true;
+
+    if(g_ipc_ctom.buf_samples[0].status == Idle)
+    {
+        buf_samples_rearm = true;
+    }
+}
+
+/**
+ * @brief Disable streaming of samples buffer
+ *
+ * A capture in progress is still frozen when completed.
+ */
+void disable_buf_samples_stream(void)
+{
+    buf_samples_stream = false;
+    buf_samples_rearm = false;
+}
+
+/**
+ * @brief Update readout of samples buffer
+ *
+ * Freeze samples buffer when a capture is completed and, if streaming is
+ * enabled, arm the next one. To be called on background.
+ */
+void update_buf_samples_readout(void)
+{
+    if(update_buffer_readout(&g_buf_samples_readout))
+    {
+        buf_samples_rearm = buf_samples_stream;
+    }
+
+    if(buf_samples_rearm &&
+       arm_buf_samples_capture(buf_samples_stream_ps_id))
+    {
+        buf_samples_rearm = false;
+    }
+}
+
 /******************************************************************************
  * TODO: CtoM IPC INT1 Interrupt Handler
  *****************************************************************************/
 void isr_ipc_lowpriority_msg(void)
 {
+    uint32_t t_start = get_cycle_counter();
+
     g_ipc_mtoc.msg_ctom = HWREG(MTOCIPC_BASE + IPC_O_CTOMIPCSTS);
     IPCCtoMFlagAcknowledge(g_ipc_mtoc.msg_ctom);
 
@@ -274,4 +412,8 @@ void isr_ipc_lowpriority_msg(void)
             break;
         }
     }
+
+    process_ipc_cmd_queue();
+
+    prof_record(PROF_ISR_IPC_LOWPRIORITY, get_cycle_counter() - t_start);
 }
@@ -75,9 +75,17 @@ typedef enum
     Reset_Counters,
     Set_Param,
     Set_DSP_Coeffs,
-    CtoM_Message_Error
+    CtoM_Message_Error,
+    Batch_Command
 } ipc_mtoc_lowpriority_msg_t;
 
+/**
+ * Batch_Command is appended after CtoM_Message_Error, so the codes shared
+ * with C28 firmware don't change. C28 doesn't handle it yet, so batched BSMP
+ * functions aren't built nor registered until this is set.
+ */
+#define IPC_BATCH_CMD_SUPPORTED     0
+
 typedef enum
 {
     Enable_HRADC_Boards,
@@ -105,6 +113,16 @@ typedef enum
     HRADC_Config_Error
 } error_mtoc_t;
 
+/**
+ * Batched command for multiple PS modules. C28 executes ```msg``` for each
+ * module set in ```ps_mask```, using its own payload in ```ps_module[]```.
+ */
+typedef volatile struct
+{
+    uint16_t    msg;
+    uint16_t    ps_mask;
+} batch_cmd_t;
+
 /**
  * IPC structures definitions
  */
@@ -148,12 +166,16 @@ typedef volatile struct
     param_hradc_t           hradc;
     param_analog_vars_t     analog_vars;
     param_communication_t   communication;
+    batch_cmd_t             batch_cmd;
 } ipc_mtoc_t;
 
 extern volatile u_float_t g_wfmref[SIZE_WFMREF];
 extern volatile u_float_t g_buf_samples_ctom[SIZE_BUF_SAMPLES_CTOM];
 extern volatile u_float_t g_buf_samples_mtoc[SIZE_BUF_SAMPLES_MTOC];
 
+extern volatile u_float_t g_buf_samples_readout_data[SIZE_BUF_SAMPLES_CTOM];
+extern buf_readout_t g_buf_samples_readout;
+
 extern volatile ipc_ctom_t g_ipc_ctom;
 extern volatile ipc_mtoc_t g_ipc_mtoc;
 
@@ -169,6 +191,11 @@ extern uint16_t ipc_mtoc_busy (uint32_t ulFlags);
 
 extern void get_firmwares_version(void);
 
+extern uint16_t arm_buf_samples_capture(uint16_t ps_id);
+extern void enable_buf_samples_stream(uint16_t ps_id);
+extern void disable_buf_samples_stream(void);
+extern void update_buf_samples_readout(void);
+
 extern void init_parameters_bank(void);
 
 #endif /* IPC_LIB_H_ */
@@ -21,6 +21,8 @@
  */
 
 #include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 #include "inc/hw_memmap.h"
 #include "inc/hw_memmap.h"
@@ -28,11 +30,14 @@
 #include "inc/hw_gpio.h"
 
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/sysctl.h"
 
 #include "board_drivers/hardware_def.h"
+#include "communication_drivers/common/crc32.h"
 #include "communication_drivers/ipc/ipc_lib.h"
 #include "communication_drivers/i2c_onboard/eeprom.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
 #include "communication_drivers/i2c_onboard/i2c_onboard.h"
 #include "communication_drivers/parameters/ps_parameters.h"
 
@@ -101,12 +106,152 @@ static uint8_t data_eeprom[32];
 //#pragma DATA_SECTION(ps_parameters_bank,"SHARERAMS0_1");
 volatile param_t g_parameters[NUM_MAX_PARAMETERS];
 
+/**
+ * Incremented whenever parameters are modified through this module
+ */
+volatile uint32_t g_param_bank_generation;
+
+/**
+ * Index of the first element of each parameter when the whole bank is seen
+ * as a flat array of elements. Last entry holds the total number of elements.
+ */
+static uint16_t param_flat_index[NUM_PARAMETERS + 1];
+
+typedef struct
+{
+    param_image_header_t    header;
+    uint8_t                 data[PARAM_IMAGE_MAX_SIZE];
+} param_image_t;
+
+/**
+ * Parameters bank images in RAM. ```param_image``` mirrors the newest image
+ * confirmed on EEPROM, while ```param_image_write``` holds the image being
+ * written, which replaces it only after a successful write.
+ * ```param_image_offset``` holds the offset of each parameter on image data,
+ * and ```param_image_slot``` and ```param_image_sequence``` the slot and
+ * sequence number of the newest image confirmed on EEPROM.
+ */
+static param_image_t param_image;
+static param_image_t param_image_write;
+
+static uint16_t param_image_offset[NUM_PARAMETERS + 1];
+static uint8_t param_image_slot;
+static uint32_t param_image_sequence;
+
+/**
+ * Elements copied into image being written. Their dirty bits are cleared
+ * when posted, and restored if write fails.
+ */
+static uint32_t param_image_saving[NUM_PARAMETERS][NUM_MAX_PARAM_ELEMENTS/32];
+
+/**
+ * Parameters table and NUM_PARAMETERS must agree
+ */
+#define PARAM_COUNT(id, type, num_elements, var)    + 1
+typedef char param_table_size_check[((0 PS_PARAMETERS_TABLE(PARAM_COUNT)) ==
+                                     NUM_PARAMETERS) ? 1 : -1];
+
+/**
+ * Whole parameters bank must fit in an image slot
+ */
+#define PARAM_BYTES(id, type, num_elements, var) \
+    + (num_elements) * ( ((type) == is_uint8_t) ? 1 : \
+                         ((type) == is_uint16_t) ? 2 : 4 )
+typedef char param_image_size_check[((0 PS_PARAMETERS_TABLE(PARAM_BYTES)) <=
+                                     PARAM_IMAGE_MAX_SIZE) ? 1 : -1];
+
+/**
+ * Dirty bits indicate elements modified by ```set_param()``` after last
+ * save or load from EEPROM.
+ */
+static void set_param_dirty(param_id_t id, uint16_t n)
+{
+    g_parameters[id].dirty[n >> 5] |= (1UL << (n & 0x1F));
+}
+
+static void clear_param_dirty(param_id_t id, uint16_t n)
+{
+    g_parameters[id].dirty[n >> 5] &= ~(1UL << (n & 0x1F));
+}
+
+static void clear_param_dirty_all(param_id_t id)
+{
+    uint16_t i;
+
+    for(i = 0; i < NUM_MAX_PARAM_ELEMENTS/32; i++)
+    {
+        g_parameters[id].dirty[i] = 0;
+    }
+}
+
+static uint8_t is_param_dirty(param_id_t id, uint16_t n)
+{
+    return (g_parameters[id].dirty[n >> 5] >> (n & 0x1F)) & 1;
+}
+
+/**
+ * Start a new image to be written from the newest image confirmed on EEPROM
+ */
+static void begin_param_image(void)
+{
+    memcpy(param_image_write.data, param_image.data,
+           param_image_offset[NUM_PARAMETERS]);
+    memset(param_image_saving, 0, sizeof(param_image_saving));
+}
+
+/**
+ * Copy elements from parameters bank into image being written. Dirty bits
+ * are moved into ```param_image_saving```, so elements modified after this
+ * are dirty again.
+ */
+static void update_param_image(param_id_t id, uint16_t n, uint16_t num)
+{
+    uint8_t size_type = g_parameters[id].size_type;
+
+    memcpy(&param_image_write.data[param_image_offset[id] + size_type*n],
+           g_parameters[id].p_val.u8 + size_type*n, size_type*num);
+
+    while(num--)
+    {
+        param_image_saving[id][n >> 5] |= (1UL << (n & 0x1F));
+        clear_param_dirty(id, n++);
+    }
+}
+
+/**
+ * Copy dirty elements into image being written
+ *
+ * @return 1 if any element was dirty
+ */
+static uint8_t update_param_image_dirty(void)
+{
+    param_id_t id;
+    uint16_t n;
+    uint8_t modified = 0;
+
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        for(n = 0; n < g_parameters[id].num_elements; n++)
+        {
+            if(is_param_dirty(id, n))
+            {
+                update_param_image(id, n, 1);
+                modified = 1;
+            }
+        }
+    }
+
+    return modified;
+}
+
 void init_param(param_id_t id, param_type_t type, uint16_t num_elements, uint8_t *p_param)
 {
     uint8_t n;
 
-    if(num_elements > 0)
+    if( (num_elements > 0) && (num_elements <= NUM_MAX_PARAM_ELEMENTS) )
     {
+        clear_param_dirty_all(id);
+
         g_parameters[id].id = id;
         g_parameters[id].type = type;
         g_parameters[id].num_elements = num_elements;
@@ -163,6 +308,16 @@ void init_param(param_id_t id, param_type_t type, uint16_t num_elements, uint8_t
     }
 }
 
+/**
+ * Mark parameter element as modified, after it's written by a typed
+ * accessor
+ */
+void set_param_modified(param_id_t id, uint16_t n)
+{
+    set_param_dirty(id, n);
+    g_param_bank_generation++;
+}
+
 uint8_t set_param(param_id_t id, uint16_t n, float val)
 {
     if(n < g_parameters[id].num_elements)
@@ -171,25 +326,25 @@ uint8_t set_param(param_id_t id, uint16_t n, float val)
         {
             case is_uint8_t:
             {
-                *(g_parameters[id].p_val.u8 + n) = (uint8_t) val;
+                PARAM_ELEMENT(id, n, u8) = (uint8_t) val;
                 break;
             }
 
             case is_uint16_t:
             {
-                *(g_parameters[id].p_val.u16 + n) = (uint16_t) val;
+                PARAM_ELEMENT(id, n, u16) = (uint16_t) val;
                 break;
             }
 
             case is_uint32_t:
             {
-                *(g_parameters[id].p_val.u32 + n) = (uint32_t) val;
+                PARAM_ELEMENT(id, n, u32) = (uint32_t) val;
                 break;
             }
 
             case is_float:
             {
-                *(g_parameters[id].p_val.f + n) = val;
+                PARAM_ELEMENT(id, n, f) = val;
                 break;
             }
 
@@ -199,6 +354,8 @@ uint8_t set_param(param_id_t id, uint16_t n, float val)
             }
         }
 
+        set_param_modified(id, n);
+
         return 1;
     }
     else
@@ -215,22 +372,22 @@ float get_param(param_id_t id, uint16_t n)
         {
             case is_uint8_t:
             {
-                return (float) *(g_parameters[id].p_val.u8 + n);
+                return (float) PARAM_ELEMENT(id, n, u8);
             }
 
             case is_uint16_t:
             {
-                return (float) *(g_parameters[id].p_val.u16 + n);
+                return (float) PARAM_ELEMENT(id, n, u16);
             }
 
             case is_uint32_t:
             {
-                return (float) *(g_parameters[id].p_val.u32 + n);
+                return (float) PARAM_ELEMENT(id, n, u32);
             }
 
             case is_float:
             {
-                return *(g_parameters[id].p_val.f + n);
+                return PARAM_ELEMENT(id, n, f);
             }
 
             default:
@@ -245,30 +402,29 @@ float get_param(param_id_t id, uint16_t n)
     }
 }
 
-uint8_t save_param_eeprom(param_id_t id, uint16_t n)
+/**
+ * Restore specified parameter element to its value saved on EEPROM. Image
+ * in RAM mirrors the EEPROM, so no EEPROM access is needed.
+ *
+ * @param id specified parameter
+ * @param n element position
+ * @return 1 if successful, 0 if element is invalid
+ */
+uint8_t load_param_eeprom(param_id_t id, uint16_t n)
 {
-    static uint8_t size_type;
-    static u_uint16_t u_add;
+    uint8_t size_type;
 
     // Check wheter index is inside parameter range
-    if(n < g_parameters[id].num_elements)
+    if( (id < NUM_PARAMETERS) && (n < g_parameters[id].num_elements) )
     {
         size_type = g_parameters[id].size_type;
 
-        // Increment element position on parameter address and prepare for EEPROM
-        u_add.u16 = g_parameters[id].eeprom_add.u16 + size_type*n;
-        data_eeprom[0] = u_add.u8[1];
-        data_eeprom[1] = u_add.u8[0];
-
-        // Prepare EEPROM data
-        memcpy(&data_eeprom[2], (g_parameters[id].p_val.u8 + size_type*n),
-               size_type);
+        memcpy( (g_parameters[id].p_val.u8 + size_type*n),
+                &param_image.data[param_image_offset[id] + size_type*n],
+                size_type);
 
-        // Send new parameter to EEPROM
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
-        write_i2c(I2C_SLV_ADDR_EEPROM, 2+size_type, data_eeprom);
-        SysCtlDelay(375000);                // Wait 5 ms for EEPROM write cycle
-        GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
+        clear_param_dirty(id, n);
+        g_param_bank_generation++;
 
         return 1;
     }
@@ -278,216 +434,612 @@ uint8_t save_param_eeprom(param_id_t id, uint16_t n)
     }
 }
 
-uint8_t load_param_eeprom(param_id_t id, uint16_t n)
+/**
+ * Compute flat index of parameters elements, used by bulk transfers, and
+ * their offset on parameters bank image
+ */
+static void init_param_flat_index(void)
 {
-    static uint8_t size_type;
-    static u_uint16_t u_add;
-
-    // Check wheter index is inside parameter range
-    if(n < g_parameters[id].num_elements)
-    {
-        size_type = g_parameters[id].size_type;
+    param_id_t id;
 
-        // Increment element position on parameter address and prepare for EEPROM
-        u_add.u16 = g_parameters[id].eeprom_add.u16 + size_type*n;
-        data_eeprom[0] = u_add.u8[1];
-        data_eeprom[1] = u_add.u8[0];
+    param_flat_index[0] = 0;
+    param_image_offset[0] = 0;
 
-        read_i2c(I2C_SLV_ADDR_EEPROM, DOUBLE_ADDRESS, size_type, data_eeprom);
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        param_flat_index[id+1] = param_flat_index[id] +
+                                 g_parameters[id].num_elements;
+        param_image_offset[id+1] = param_image_offset[id] +
+                                   g_parameters[id].size_type *
+                                   g_parameters[id].num_elements;
+    }
+}
 
-        memcpy( (g_parameters[id].p_val.u8 + size_type*n), &data_eeprom[0],
-                size_type);
+/**
+ * Find parameter which holds specified flat element
+ */
+static param_id_t find_param_flat_index(uint16_t index)
+{
+    param_id_t id = 0;
 
-        return 1;
-    }
-    else
+    while(param_flat_index[id+1] <= index)
     {
-        return 0;
+        id++;
     }
+
+    return id;
 }
 
+#define PARAM_INIT(id, type, num_elements, var) \
+    init_param(id, type, num_elements, (uint8_t *) &(var));
+
 void init_parameters_bank(void)
 {
-    init_param(PS_Name, is_uint8_t, SIZE_PS_NAME, &g_ipc_mtoc.ps_name);
+    PS_PARAMETERS_TABLE(PARAM_INIT)
 
-    init_param(PS_Model, is_uint16_t, 1, (uint8_t *) &g_ipc_mtoc.ps_model);
+    init_param_flat_index();
+}
 
-    init_param(Num_PS_Modules, is_uint16_t, 1,
-               (uint8_t *) &g_ipc_mtoc.num_ps_modules);
+/**
+ * Seal image being written for the slot which doesn't hold the newest image,
+ * so a torn write never corrupts the last valid image. Newest image, its slot
+ * and sequence number are only changed by ```commit_param_image()```, after
+ * a successful write, so the write after a failed one goes to the same slot
+ * with the same sequence number.
+ *
+ * @return EEPROM address of slot to be written
+ */
+static uint16_t seal_param_image(void)
+{
+    uint32_t crc;
 
-    /**
-     *  Communication parameters
-     */
-    init_param(RS485_Baudrate, is_float, 1,
-                &g_ipc_mtoc.communication.rs485_baud.u8[0]);
+    param_image_write.header.magic    = PARAM_IMAGE_MAGIC;
+    param_image_write.header.version  = PARAM_IMAGE_VERSION;
+    param_image_write.header.size     = param_image_offset[NUM_PARAMETERS];
+    param_image_write.header.sequence = param_image_sequence + 1;
 
-    init_param(RS485_Address, is_uint16_t, NUM_MAX_PS_MODULES,
-                &g_ipc_mtoc.communication.rs485_address[0].u8[0]);
+    crc = crc32(0, (uint8_t *) &param_image_write.header,
+                offsetof(param_image_header_t, crc));
+    param_image_write.header.crc = crc32(crc, param_image_write.data,
+                                         param_image_write.header.size);
 
-    init_param(RS485_Termination, is_uint16_t, 1,
-                &g_ipc_mtoc.communication.rs485_termination.u8[0]);
+    return param_image_slot ? PARAM_IMAGE_ADD_A : PARAM_IMAGE_ADD_B;
+}
 
-    init_param(UDCNet_Address, is_uint16_t, 1,
-                    &g_ipc_mtoc.communication.udcnet_address.u8[0]);
+/**
+ * Set image written as the newest one, once it's confirmed on EEPROM. If
+ * write failed, newest image is kept and elements which were being saved are
+ * set dirty again, so they are saved on next request.
+ *
+ * @param success 1 if image was written, 0 if any write cycle timed out
+ */
+static void commit_param_image(uint8_t success)
+{
+    param_id_t id;
+    uint16_t i;
+
+    if(success)
+    {
+        memcpy(&param_image, &param_image_write, sizeof(param_image_header_t) +
+                                                 param_image_write.header.size);
+        param_image_slot ^= 1;
+        param_image_sequence = param_image.header.sequence;
+    }
+    else
+    {
+        for(id = 0; id < NUM_PARAMETERS; id++)
+        {
+            for(i = 0; i < NUM_MAX_PARAM_ELEMENTS/32; i++)
+            {
+                g_parameters[id].dirty[i] |= param_image_saving[id][i];
+            }
+        }
+    }
 
-    init_param(Ethernet_IP, is_uint8_t, 4,
-                &g_ipc_mtoc.communication.ethernet_ip[0]);
+    memset(param_image_saving, 0, sizeof(param_image_saving));
+}
 
-    init_param(Ethernet_Subnet_Mask, is_uint8_t, 4,
-                &g_ipc_mtoc.communication.ethernet_mask[0]);
+/**
+ * Post image being written into EEPROM write queue. It must not be modified
+ * until it's written, so it's only started and posted if queue is idle.
+ *
+ * @return 1 if successful, 0 if EEPROM write queue is busy
+ */
+static uint8_t post_param_image(void)
+{
+    uint16_t add;
 
-    init_param(Command_Interface, is_uint16_t, 1,
-               (uint8_t *) &g_ipc_mtoc.communication.command_interface);
+    if(eeprom_queue_busy())
+    {
+        return 0;
+    }
 
-    init_param(Buzzer_Volume, is_uint16_t, 2,
-               &g_ipc_mtoc.communication.buzzer_volume.u8[0]);
+    add = seal_param_image();
 
-    /**
-     * Controller parameters
-     */
-    init_param(Freq_ISR_Controller, is_float, 1,
-                &g_ipc_mtoc.control.freq_isr_control.u8[0]);
+    if(!post_eeprom_write(add, (uint8_t *) &param_image_write,
+                          sizeof(param_image_header_t) +
+                          param_image_write.header.size, commit_param_image))
+    {
+        commit_param_image(0);
+        return 0;
+    }
 
-    init_param(Freq_TimeSlicer, is_float, NUM_MAX_TIMESLICERS,
-                &g_ipc_mtoc.control.freq_timeslicer[0].u8[0]);
+    return 1;
+}
 
-    init_param(Max_Ref, is_float, 1, &g_ipc_mtoc.control.max_ref.u8[0]);
+/**
+ * Check whether image header is consistent with current parameters table
+ */
+static uint8_t check_param_image_header(param_image_header_t *p_header)
+{
+    return ( (p_header->magic == PARAM_IMAGE_MAGIC) &&
+             (p_header->version == PARAM_IMAGE_VERSION) &&
+             (p_header->size == param_image_offset[NUM_PARAMETERS]) );
+}
 
-    init_param(Min_Ref, is_float, 1, &g_ipc_mtoc.control.min_ref.u8[0]);
+/**
+ * Read image from specified EEPROM slot into RAM, with a single sequential
+ * read, and check its CRC
+ *
+ * @return 1 if image is valid, 0 otherwise
+ */
+static uint8_t read_param_image(uint16_t add)
+{
+    uint32_t crc;
 
-    init_param(Max_Ref_OpenLoop, is_float, 1,
-                &g_ipc_mtoc.control.max_ref_openloop.u8[0]);
+    eeprom_read(add, (uint8_t *) &param_image,
+                sizeof(param_image_header_t) + param_image_offset[NUM_PARAMETERS]);
 
-    init_param(Min_Ref_OpenLoop, is_float, 1,
-                &g_ipc_mtoc.control.min_ref_openloop.u8[0]);
+    if(!check_param_image_header(&param_image.header))
+    {
+        return 0;
+    }
 
-    init_param(Max_SlewRate_SlowRef, is_float, 1,
-                &g_ipc_mtoc.control.slewrate_slowref.u8[0]);
+    crc = crc32(0, (uint8_t *) &param_image.header,
+                offsetof(param_image_header_t, crc));
+    crc = crc32(crc, param_image.data, param_image.header.size);
 
-    init_param(Max_SlewRate_SigGen_Amp, is_float, 1,
-                &g_ipc_mtoc.control.slewrate_siggen_amp.u8[0]);
+    return (crc == param_image.header.crc);
+}
 
-    init_param(Max_SlewRate_SigGen_Offset, is_float, 1,
-                &g_ipc_mtoc.control.slewrate_siggen_offset.u8[0]);
+/**
+ * Load parameters bank from legacy layout, one element per transaction. It's
+ * used only when EEPROM doesn't hold a valid image yet.
+ */
+static void load_param_bank_legacy(void)
+{
+    param_id_t id;
+    uint16_t n;
+    uint8_t size_type;
+    u_uint16_t u_add;
 
-    init_param(Max_SlewRate_WfmRef, is_float, 1,
-                &g_ipc_mtoc.control.slewrate_wfmref.u8[0]);
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        size_type = g_parameters[id].size_type;
 
-    /**
-     * PWM parameters
-     */
-    init_param(PWM_Freq, is_float, 1, &g_ipc_mtoc.pwm.freq_pwm.u8[0]);
+        for(n = 0; n < g_parameters[id].num_elements; n++)
+        {
+            u_add.u16 = g_parameters[id].eeprom_add.u16 + size_type*n;
+            data_eeprom[0] = u_add.u8[1];
+            data_eeprom[1] = u_add.u8[0];
 
-    init_param(PWM_DeadTime, is_float, 1, &g_ipc_mtoc.pwm.dead_time.u8[0]);
+            read_i2c(I2C_SLV_ADDR_EEPROM, DOUBLE_ADDRESS, size_type,
+                     data_eeprom);
 
-    init_param(PWM_Max_Duty, is_float, 1, &g_ipc_mtoc.pwm.max_duty.u8[0]);
+            memcpy( (g_parameters[id].p_val.u8 + size_type*n),
+                    &data_eeprom[0], size_type);
+        }
 
-    init_param(PWM_Min_Duty, is_float, 1, &g_ipc_mtoc.pwm.min_duty.u8[0]);
+        memcpy(&param_image.data[param_image_offset[id]],
+               g_parameters[id].p_val.u8,
+               param_image_offset[id+1] - param_image_offset[id]);
+        clear_param_dirty_all(id);
+    }
 
-    init_param(PWM_Max_Duty_OpenLoop, is_float, 1,
-                &g_ipc_mtoc.pwm.max_duty_openloop.u8[0]);
+    param_image_sequence = 0;
+    param_image_slot = 1;
+}
 
-    init_param(PWM_Min_Duty_OpenLoop, is_float, 1,
-                &g_ipc_mtoc.pwm.min_duty_openloop.u8[0]);
+/**
+ * Load parameters bank from newest valid image on EEPROM. If none is valid,
+ * it's loaded from legacy layout, which is converted into an image on next
+ * save.
+ */
+void load_param_bank(void)
+{
+    param_image_header_t header[2];
+    uint8_t slot, i;
+    param_id_t id;
 
-    init_param(PWM_Lim_Duty_Share, is_float, 1,
-                &g_ipc_mtoc.pwm.lim_duty_share.u8[0]);
+    eeprom_read(PARAM_IMAGE_ADD_A, (uint8_t *) &header[0],
+                sizeof(param_image_header_t));
+    eeprom_read(PARAM_IMAGE_ADD_B, (uint8_t *) &header[1],
+                sizeof(param_image_header_t));
 
     /**
-     * HRADC parameters
+     * Try newest slot first
      */
-    init_param(HRADC_Num_Boards, is_uint16_t, 1,
-                &g_ipc_mtoc.hradc.num_hradc.u8[0]);
+    slot = ( check_param_image_header(&header[1]) &&
+             ( !check_param_image_header(&header[0]) ||
+               (header[1].sequence > header[0].sequence) ) ) ? 1 : 0;
 
-    init_param(HRADC_Freq_SPICLK, is_uint16_t, 1,
-                &g_ipc_mtoc.hradc.freq_spiclk.u8[0]);
+    for(i = 0; i < 2; i++, slot ^= 1)
+    {
+        if( check_param_image_header(&header[slot]) &&
+            read_param_image(slot ? PARAM_IMAGE_ADD_B : PARAM_IMAGE_ADD_A) )
+        {
+            param_image_slot = slot;
+            param_image_sequence = header[slot].sequence;
 
-    init_param(HRADC_Freq_Sampling, is_float, 1,
-                &g_ipc_mtoc.hradc.freq_hradc_sampling.u8[0]);
+            for(id = 0; id < NUM_PARAMETERS; id++)
+            {
+                memcpy(g_parameters[id].p_val.u8,
+                       &param_image.data[param_image_offset[id]],
+                       param_image_offset[id+1] - param_image_offset[id]);
+                clear_param_dirty_all(id);
+            }
 
-    init_param(HRADC_Enable_Heater, is_uint16_t, NUM_MAX_HRADC,
-                &g_ipc_mtoc.hradc.enable_heater[0].u8[0]);
+            g_param_bank_generation++;
+            return;
+        }
+    }
 
-    init_param(HRADC_Enable_Monitor, is_uint16_t, NUM_MAX_HRADC,
-                &g_ipc_mtoc.hradc.enable_monitor[0].u8[0]);
+    load_param_bank_legacy();
+    g_param_bank_generation++;
+}
 
-    init_param(HRADC_Type_Transducer, is_uint16_t, NUM_MAX_HRADC,
-                &g_ipc_mtoc.hradc.type_transducer_output[0].u8[0]);
+/**
+ * Post all parameters into EEPROM write queue, only if any element differs
+ * from saved value. Image in RAM mirrors the EEPROM, so it's compared without
+ * reading EEPROM, including parameters modified by other means than
+ * ```set_param()```.
+ *
+ * @return 1 if successful, 0 if queue is busy
+ */
+uint8_t post_save_param_bank_diff(void)
+{
+    param_id_t id;
+    uint8_t modified = 0;
 
-    init_param(HRADC_Gain_Transducer, is_float, NUM_MAX_HRADC,
-                &g_ipc_mtoc.hradc.gain_transducer[0].u8[0]);
+    if(eeprom_queue_busy())
+    {
+        return 0;
+    }
 
-    init_param(HRADC_Offset_Transducer, is_float, NUM_MAX_HRADC,
-                &g_ipc_mtoc.hradc.offset_transducer[0].u8[0]);
+    begin_param_image();
 
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        if(memcmp(&param_image.data[param_image_offset[id]],
+                  g_parameters[id].p_val.u8,
+                  param_image_offset[id+1] - param_image_offset[id]))
+        {
+            update_param_image(id, 0, g_parameters[id].num_elements);
+            modified = 1;
+        }
+        else
+        {
+            clear_param_dirty_all(id);
+        }
+    }
 
-    /**
-     * SigGen parameters
-     */
-    init_param(SigGen_Type, is_uint16_t, 1, &g_ipc_mtoc.siggen.type.u8[0]);
+    if(modified)
+    {
+        return post_param_image();
+    }
 
-    init_param(SigGen_Num_Cycles, is_uint16_t, 1,
-                &g_ipc_mtoc.siggen.num_cycles.u8[0]);
+    return 1;
+}
 
-    init_param(SigGen_Freq, is_float, 1, &g_ipc_mtoc.siggen.freq.u8[0]);
+/**
+ * Post specified parameter element into EEPROM write queue. Only this element
+ * is updated on image, but the whole image is written, as any other save:
+ * it's slower than writing a single element, but a failed write never leaves
+ * the bank partially saved.
+ *
+ * @param id specified parameter
+ * @param n element position
+ * @return 1 if successful, 0 if parameter is invalid or queue is busy
+ */
+uint8_t post_save_param_eeprom(param_id_t id, uint16_t n)
+{
+    if( (id < NUM_PARAMETERS) && (n < g_parameters[id].num_elements) &&
+        !eeprom_queue_busy() )
+    {
+        begin_param_image();
+        update_param_image(id, n, 1);
+        return post_param_image();
+    }
 
-    init_param(SigGen_Amplitude, is_float, 1,
-                &g_ipc_mtoc.siggen.amplitude.u8[0]);
+    return 0;
+}
 
-    init_param(SigGen_Offset, is_float, 1, &g_ipc_mtoc.siggen.offset.u8[0]);
+/**
+ * Post whole parameters bank into EEPROM write queue
+ *
+ * @return 1 if successful, 0 if queue is busy
+ */
+uint8_t post_save_param_bank(void)
+{
+    param_id_t id;
 
-    init_param(SigGen_Aux_Param, is_float, NUM_SIGGEN_AUX_PARAM,
-                &g_ipc_mtoc.siggen.aux_param[0].u8[0]);
+    if(eeprom_queue_busy())
+    {
+        return 0;
+    }
 
+    begin_param_image();
 
-    /**
-     * WfmRef parameters
-     */
-    init_param(WfmRef_ID_WfmRef, is_uint16_t, 1,
-                &g_ipc_mtoc.wfmref.wfmref_selected.u8[0]);
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        update_param_image(id, 0, g_parameters[id].num_elements);
+    }
 
-    init_param(WfmRef_SyncMode, is_uint16_t, 1,
-                &g_ipc_mtoc.wfmref.sync_mode.u8[0]);
+    return post_param_image();
+}
 
-    init_param(WfmRef_Gain, is_float, 1, &g_ipc_mtoc.wfmref.gain.u8[0]);
+/**
+ * Post elements modified by ```set_param()``` into EEPROM write queue
+ *
+ * @return 1 if successful, 0 if queue is busy
+ */
+uint8_t post_save_param_bank_dirty(void)
+{
+    if(eeprom_queue_busy())
+    {
+        return 0;
+    }
 
-    init_param(WfmRef_Offset, is_float, 1, &g_ipc_mtoc.wfmref.offset.u8[0]);
+    begin_param_image();
 
+    if(update_param_image_dirty())
+    {
+        return post_param_image();
+    }
 
-    /**
-     * Analog variables parameters
-     */
-    init_param(Analog_Var_Max, is_float, NUM_MAX_ANALOG_VAR,
-                &g_ipc_mtoc.analog_vars.max[0].u8[0]);
+    return 1;
+}
 
-    init_param(Analog_Var_Min, is_float, NUM_MAX_ANALOG_VAR,
-                &g_ipc_mtoc.analog_vars.min[0].u8[0]);
+/**
+ * Get total number of elements of parameters bank
+ *
+ * @return number of elements
+ */
+uint16_t get_param_bank_size(void)
+{
+    return param_flat_index[NUM_PARAMETERS];
 }
 
-void save_param_bank(void)
+/**
+ * Get contiguous range of parameters elements, converted to float. Elements
+ * are numbered as in a flat array, in order of parameter ID and element
+ * position.
+ *
+ * @param first flat index of first element
+ * @param num number of elements
+ * @param p_dst pointer to destination, which holds 4 bytes per element
+ * @return number of elements copied
+ */
+uint16_t get_param_bank(uint16_t first, uint16_t num, uint8_t *p_dst)
 {
     param_id_t id;
-    uint16_t n;
+    uint16_t n, i, count, copied;
+    p_param_t p_val;
+    u_float_t u_val;
 
-    for(id = 0; id < NUM_PARAMETERS; id++)
+    if(first >= get_param_bank_size())
     {
-        for(n = 0; n < g_parameters[id].num_elements; n++)
+        return 0;
+    }
+
+    if(num > get_param_bank_size() - first)
+    {
+        num = get_param_bank_size() - first;
+    }
+
+    id = find_param_flat_index(first);
+    n = first - param_flat_index[id];
+
+    for(copied = 0; copied < num; copied += count)
+    {
+        p_val = g_parameters[id].p_val;
+
+        count = g_parameters[id].num_elements - n;
+        if(count > num - copied)
         {
-            save_param_eeprom(id, n);
+            count = num - copied;
         }
+
+        /**
+         * Switch on type once per parameter, instead of once per element
+         */
+        switch(g_parameters[id].type)
+        {
+            case is_uint8_t:
+            {
+                for(i = n; i < n + count; i++, p_dst += 4)
+                {
+                    u_val.f = (float) p_val.u8[i];
+                    memcpy(p_dst, &u_val.u8[0], 4);
+                }
+                break;
+            }
+
+            case is_uint16_t:
+            {
+                for(i = n; i < n + count; i++, p_dst += 4)
+                {
+                    u_val.f = (float) p_val.u16[i];
+                    memcpy(p_dst, &u_val.u8[0], 4);
+                }
+                break;
+            }
+
+            case is_uint32_t:
+            {
+                for(i = n; i < n + count; i++, p_dst += 4)
+                {
+                    u_val.f = (float) p_val.u32[i];
+                    memcpy(p_dst, &u_val.u8[0], 4);
+                }
+                break;
+            }
+
+            default:
+            {
+                memcpy(p_dst, &p_val.f[n], 4*count);
+                p_dst += 4*count;
+                break;
+            }
+        }
+
+        id++;
+        n = 0;
     }
+
+    return num;
 }
 
-void load_param_bank(void)
+/**
+ * Validate or apply contiguous range of parameters elements
+ */
+static uint8_t write_param_bank(uint16_t first, uint16_t num, uint8_t *p_src,
+                                bool apply)
 {
     param_id_t id;
-    uint16_t n;
+    uint16_t n, i, count, written;
+    p_param_t p_val;
+    u_float_t u_val;
+    float limit;
 
-    for(id = 0; id < NUM_PARAMETERS; id++)
+    id = find_param_flat_index(first);
+    n = first - param_flat_index[id];
+
+    for(written = 0; written < num; written += count)
     {
-        for(n = 0; n < g_parameters[id].num_elements; n++)
+        p_val = g_parameters[id].p_val;
+
+        count = g_parameters[id].num_elements - n;
+        if(count > num - written)
+        {
+            count = num - written;
+        }
+
+        switch(g_parameters[id].type)
+        {
+            case is_uint8_t:
+            {
+                limit = 256.0;
+                break;
+            }
+
+            case is_uint16_t:
+            {
+                limit = 65536.0;
+                break;
+            }
+
+            case is_uint32_t:
+            {
+                limit = 4294967296.0;
+                break;
+            }
+
+            default:
+            {
+                limit = INFINITY;
+                break;
+            }
+        }
+
+        for(i = n; i < n + count; i++)
         {
-            load_param_eeprom(id, n);
+            memcpy(&u_val.u8[0], p_src, 4);
+            p_src += 4;
+
+            if(!apply)
+            {
+                if( isnan(u_val.f) ||
+                    ( (limit != INFINITY) &&
+                      ((u_val.f < 0.0) || (u_val.f >= limit)) ) )
+                {
+                    return 0;
+                }
+                continue;
+            }
+
+            switch(g_parameters[id].type)
+            {
+                case is_uint8_t:
+                {
+                    p_val.u8[i] = (uint8_t) u_val.f;
+                    break;
+                }
+
+                case is_uint16_t:
+                {
+                    p_val.u16[i] = (uint16_t) u_val.f;
+                    break;
+                }
+
+                case is_uint32_t:
+                {
+                    p_val.u32[i] = (uint32_t) u_val.f;
+                    break;
+                }
+
+                default:
+                {
+                    p_val.f[i] = u_val.f;
+                    break;
+                }
+            }
+
+            set_param_dirty(id, i);
         }
+
+        id++;
+        n = 0;
+    }
+
+    return 1;
+}
+
+/**
+ * Set contiguous range of parameters elements. Whole range is validated
+ * before any element is modified, and it's applied with interrupts disabled,
+ * so it's never seen partially written by ARM.
+ *
+ * @param first flat index of first element
+ * @param num number of elements
+ * @param p_src pointer to new values, as 4 bytes floats
+ * @return 1 if successful, 0 if range is invalid or any value is out of the
+ * range of its parameter type
+ */
+uint8_t set_param_bank(uint16_t first, uint16_t num, uint8_t *p_src)
+{
+    bool int_disabled;
+
+    if( (first >= get_param_bank_size()) ||
+        (num > get_param_bank_size() - first) )
+    {
+        return 0;
+    }
+
+    if(!write_param_bank(first, num, p_src, false))
+    {
+        return 0;
     }
+
+    int_disabled = IntMasterDisable();
+
+    write_param_bank(first, num, p_src, true);
+    g_param_bank_generation++;
+
+    if(!int_disabled)
+    {
+        IntMasterEnable();
+    }
+
+    return 1;
 }
@@ -40,65 +40,7 @@
 #define NUM_PARAMETERS          48
 #define NUM_MAX_PARAMETERS      64
 #define NUM_MAX_FLOATS          200
-
-typedef enum
-{
-    PS_Name,
-    PS_Model,
-    Num_PS_Modules,
-
-    Command_Interface,
-    RS485_Baudrate,
-    RS485_Address,
-    RS485_Termination,
-    UDCNet_Address,
-    Ethernet_IP,
-    Ethernet_Subnet_Mask,
-    Buzzer_Volume,
-
-    Freq_ISR_Controller,
-    Freq_TimeSlicer,
-    Max_Ref,
-    Min_Ref,
-    Max_Ref_OpenLoop,
-    Min_Ref_OpenLoop,
-    Max_SlewRate_SlowRef,
-    Max_SlewRate_SigGen_Amp,
-    Max_SlewRate_SigGen_Offset,
-    Max_SlewRate_WfmRef,
-
-    PWM_Freq,
-    PWM_DeadTime,
-    PWM_Max_Duty,
-    PWM_Min_Duty,
-    PWM_Max_Duty_OpenLoop,
-    PWM_Min_Duty_OpenLoop,
-    PWM_Lim_Duty_Share,
-
-    HRADC_Num_Boards,
-    HRADC_Freq_SPICLK,
-    HRADC_Freq_Sampling,
-    HRADC_Enable_Heater,
-    HRADC_Enable_Monitor,
-    HRADC_Type_Transducer,
-    HRADC_Gain_Transducer,
-    HRADC_Offset_Transducer,
-
-    SigGen_Type,
-    SigGen_Num_Cycles,
-    SigGen_Freq,
-    SigGen_Amplitude,
-    SigGen_Offset,
-    SigGen_Aux_Param,
-
-    WfmRef_ID_WfmRef,
-    WfmRef_SyncMode,
-    WfmRef_Gain,
-    WfmRef_Offset,
-
-    Analog_Var_Max,
-    Analog_Var_Min,
-} param_id_t;
+#define NUM_MAX_PARAM_ELEMENTS  64
 
 typedef enum
 {
@@ -108,6 +50,84 @@ typedef enum
     is_float
 } param_type_t;
 
+/**
+ * Parameters table: ID, type, number of elements and storage. It defines
+ * ```param_id_t```, the type of each ID used by the typed accessors, and the
+ * initialization of parameters bank. IDs are in the same order as their
+ * EEPROM addresses.
+ */
+#define PS_PARAMETERS_TABLE(X) \
+    X(PS_Name,                    is_uint8_t,  SIZE_PS_NAME,          g_ipc_mtoc.ps_name) \
+    X(PS_Model,                   is_uint16_t, 1,                     g_ipc_mtoc.ps_model) \
+    X(Num_PS_Modules,             is_uint16_t, 1,                     g_ipc_mtoc.num_ps_modules) \
+                                                                                              \
+    /* Communication parameters */                                                            \
+    X(Command_Interface,          is_uint16_t, 1,                     g_ipc_mtoc.communication.command_interface) \
+    X(RS485_Baudrate,             is_float,    1,                     g_ipc_mtoc.communication.rs485_baud) \
+    X(RS485_Address,              is_uint16_t, NUM_MAX_PS_MODULES,    g_ipc_mtoc.communication.rs485_address) \
+    X(RS485_Termination,          is_uint16_t, 1,                     g_ipc_mtoc.communication.rs485_termination) \
+    X(UDCNet_Address,             is_uint16_t, 1,                     g_ipc_mtoc.communication.udcnet_address) \
+    X(Ethernet_IP,                is_uint8_t,  4,                     g_ipc_mtoc.communication.ethernet_ip) \
+    X(Ethernet_Subnet_Mask,       is_uint8_t,  4,                     g_ipc_mtoc.communication.ethernet_mask) \
+    X(Buzzer_Volume,              is_uint16_t, 2,                     g_ipc_mtoc.communication.buzzer_volume) \
+                                                                                              \
+    /* Controller parameters */                                                               \
+    X(Freq_ISR_Controller,        is_float,    1,                     g_ipc_mtoc.control.freq_isr_control) \
+    X(Freq_TimeSlicer,            is_float,    NUM_MAX_TIMESLICERS,   g_ipc_mtoc.control.freq_timeslicer) \
+    X(Max_Ref,                    is_float,    1,                     g_ipc_mtoc.control.max_ref) \
+    X(Min_Ref,                    is_float,    1,                     g_ipc_mtoc.control.min_ref) \
+    X(Max_Ref_OpenLoop,           is_float,    1,                     g_ipc_mtoc.control.max_ref_openloop) \
+    X(Min_Ref_OpenLoop,           is_float,    1,                     g_ipc_mtoc.control.min_ref_openloop) \
+    X(Max_SlewRate_SlowRef,       is_float,    1,                     g_ipc_mtoc.control.slewrate_slowref) \
+    X(Max_SlewRate_SigGen_Amp,    is_float,    1,                     g_ipc_mtoc.control.slewrate_siggen_amp) \
+    X(Max_SlewRate_SigGen_Offset, is_float,    1,                     g_ipc_mtoc.control.slewrate_siggen_offset) \
+    X(Max_SlewRate_WfmRef,        is_float,    1,                     g_ipc_mtoc.control.slewrate_wfmref) \
+                                                                                              \
+    /* PWM parameters */                                                                      \
+    X(PWM_Freq,                   is_float,    1,                     g_ipc_mtoc.pwm.freq_pwm) \
+    X(PWM_DeadTime,               is_float,    1,                     g_ipc_mtoc.pwm.dead_time) \
+    X(PWM_Max_Duty,               is_float,    1,                     g_ipc_mtoc.pwm.max_duty) \
+    X(PWM_Min_Duty,               is_float,    1,                     g_ipc_mtoc.pwm.min_duty) \
+    X(PWM_Max_Duty_OpenLoop,      is_float,    1,                     g_ipc_mtoc.pwm.max_duty_openloop) \
+    X(PWM_Min_Duty_OpenLoop,      is_float,    1,                     g_ipc_mtoc.pwm.min_duty_openloop) \
+    X(PWM_Lim_Duty_Share,         is_float,    1,                     g_ipc_mtoc.pwm.lim_duty_share) \
+                                                                                              \
+    /* HRADC parameters */                                                                    \
+    X(HRADC_Num_Boards,           is_uint16_t, 1,                     g_ipc_mtoc.hradc.num_hradc) \
+    X(HRADC_Freq_SPICLK,          is_uint16_t, 1,                     g_ipc_mtoc.hradc.freq_spiclk) \
+    X(HRADC_Freq_Sampling,        is_float,    1,                     g_ipc_mtoc.hradc.freq_hradc_sampling) \
+    X(HRADC_Enable_Heater,        is_uint16_t, NUM_MAX_HRADC,         g_ipc_mtoc.hradc.enable_heater) \
+    X(HRADC_Enable_Monitor,       is_uint16_t, NUM_MAX_HRADC,         g_ipc_mtoc.hradc.enable_monitor) \
+    X(HRADC_Type_Transducer,      is_uint16_t, NUM_MAX_HRADC,         g_ipc_mtoc.hradc.type_transducer_output) \
+    X(HRADC_Gain_Transducer,      is_float,    NUM_MAX_HRADC,         g_ipc_mtoc.hradc.gain_transducer) \
+    X(HRADC_Offset_Transducer,    is_float,    NUM_MAX_HRADC,         g_ipc_mtoc.hradc.offset_transducer) \
+                                                                                              \
+    /* SigGen parameters */                                                                   \
+    X(SigGen_Type,                is_uint16_t, 1,                     g_ipc_mtoc.siggen.type) \
+    X(SigGen_Num_Cycles,          is_uint16_t, 1,                     g_ipc_mtoc.siggen.num_cycles) \
+    X(SigGen_Freq,                is_float,    1,                     g_ipc_mtoc.siggen.freq) \
+    X(SigGen_Amplitude,           is_float,    1,                     g_ipc_mtoc.siggen.amplitude) \
+    X(SigGen_Offset,              is_float,    1,                     g_ipc_mtoc.siggen.offset) \
+    X(SigGen_Aux_Param,           is_float,    NUM_SIGGEN_AUX_PARAM,  g_ipc_mtoc.siggen.aux_param) \
+                                                                                              \
+    /* WfmRef parameters */                                                                   \
+    X(WfmRef_ID_WfmRef,           is_uint16_t, 1,                     g_ipc_mtoc.wfmref.wfmref_selected) \
+    X(WfmRef_SyncMode,            is_uint16_t, 1,                     g_ipc_mtoc.wfmref.sync_mode) \
+    X(WfmRef_Gain,                is_float,    1,                     g_ipc_mtoc.wfmref.gain) \
+    X(WfmRef_Offset,              is_float,    1,                     g_ipc_mtoc.wfmref.offset) \
+                                                                                              \
+    /* Analog variables parameters */                                                         \
+    X(Analog_Var_Max,             is_float,    NUM_MAX_ANALOG_VAR,    g_ipc_mtoc.analog_vars.max) \
+    X(Analog_Var_Min,             is_float,    NUM_MAX_ANALOG_VAR,    g_ipc_mtoc.analog_vars.min)
+
+#define PARAM_ID_ENUM(id, type, num_elements, var)      id,
+#define PARAM_TYPE_ENUM(id, type, num_elements, var)    param_type_##id = type,
+
+typedef enum
+{
+    PS_PARAMETERS_TABLE(PARAM_ID_ENUM)
+} param_id_t;
+
 typedef union
 {
     uint8_t     *u8;
@@ -116,6 +136,14 @@ typedef union
     float       *f;
 } p_param_t;
 
+/**
+ * Type of each parameter ID, known at compile time
+ */
+typedef enum
+{
+    PS_PARAMETERS_TABLE(PARAM_TYPE_ENUM)
+} param_id_type_t;
+
 typedef struct
 {
     param_id_t      id;
@@ -124,8 +152,31 @@ typedef struct
     uint16_t        num_elements;
     u_uint16_t      eeprom_add;
     p_param_t       p_val;
+    uint32_t        dirty[NUM_MAX_PARAM_ELEMENTS/32];  // Not saved on EEPROM
 } param_t;
 
+/**
+ * Parameters bank is saved on EEPROM as a contiguous image, alternating
+ * between slots A and B. Header holds a sequence number, so the newest image
+ * whose CRC-32 is valid is loaded. Every save writes the whole image, even
+ * for a single element, through EEPROM write queue.
+ */
+#define PARAM_IMAGE_MAGIC       0x4B4E4250      // "PBNK"
+#define PARAM_IMAGE_VERSION     1
+#define PARAM_IMAGE_ADD_A       0x1000
+#define PARAM_IMAGE_ADD_B       0x1400
+#define PARAM_IMAGE_SLOT_SIZE   0x0400
+#define PARAM_IMAGE_MAX_SIZE    (PARAM_IMAGE_SLOT_SIZE - 16)
+
+typedef struct
+{
+    uint32_t        magic;
+    uint16_t        version;
+    uint16_t        size;
+    uint32_t        sequence;
+    uint32_t        crc;        // Header fields above and image data
+} param_image_header_t;
+
 typedef struct
 {
     u_float_t       rs485_baud;
@@ -182,15 +233,55 @@ typedef struct
 } param_analog_vars_t;
 
 extern volatile param_t g_parameters[NUM_MAX_PARAMETERS];
+extern volatile uint32_t g_param_bank_generation;
+
+/**
+ * Typed accessors. ID must be a ```param_id_t``` constant, whose type is
+ * checked at build time: a wrong-type access fails to compile. Element
+ * position isn't checked, and no float conversion is performed.
+ */
+#define PARAM_CHECK_TYPE(id, type) \
+    ((void) sizeof(char[(param_type_##id == (type)) ? 1 : -1]))
+
+#define PARAM_ELEMENT(id, n, field)     (g_parameters[id].p_val.field[n])
+
+#define get_param_u8(id, n) \
+    (PARAM_CHECK_TYPE(id, is_uint8_t), PARAM_ELEMENT(id, n, u8))
+#define get_param_u16(id, n) \
+    (PARAM_CHECK_TYPE(id, is_uint16_t), PARAM_ELEMENT(id, n, u16))
+#define get_param_u32(id, n) \
+    (PARAM_CHECK_TYPE(id, is_uint32_t), PARAM_ELEMENT(id, n, u32))
+#define get_param_float(id, n) \
+    (PARAM_CHECK_TYPE(id, is_float), PARAM_ELEMENT(id, n, f))
+
+#define set_param_u8(id, n, val) \
+    (PARAM_CHECK_TYPE(id, is_uint8_t), PARAM_ELEMENT(id, n, u8) = (val), \
+     set_param_modified(id, n))
+#define set_param_u16(id, n, val) \
+    (PARAM_CHECK_TYPE(id, is_uint16_t), PARAM_ELEMENT(id, n, u16) = (val), \
+     set_param_modified(id, n))
+#define set_param_u32(id, n, val) \
+    (PARAM_CHECK_TYPE(id, is_uint32_t), PARAM_ELEMENT(id, n, u32) = (val), \
+     set_param_modified(id, n))
+#define set_param_float(id, n, val) \
+    (PARAM_CHECK_TYPE(id, is_float), PARAM_ELEMENT(id, n, f) = (val), \
+     set_param_modified(id, n))
 
 extern void init_param(param_id_t id, param_type_t type, uint16_t num_elements, uint8_t *p_param);
 extern uint8_t set_param(param_id_t id, uint16_t n, float val);
-extern uint8_t save_param_eeprom(param_id_t id, uint16_t n);
+extern void set_param_modified(param_id_t id, uint16_t n);
 extern float get_param(param_id_t id, uint16_t n);
 extern uint8_t load_param_eeprom(param_id_t id, uint16_t n);
 
 extern void init_parameters_bank(void);
-extern void save_param_bank(void);
+extern uint8_t post_save_param_eeprom(param_id_t id, uint16_t n);
+extern uint8_t post_save_param_bank(void);
+extern uint8_t post_save_param_bank_dirty(void);
+extern uint8_t post_save_param_bank_diff(void);
+
+extern uint16_t get_param_bank_size(void);
+extern uint16_t get_param_bank(uint16_t first, uint16_t num, uint8_t *p_dst);
+extern uint8_t set_param_bank(uint16_t first, uint16_t num, uint8_t *p_src);
 extern void load_param_bank(void);
 
 #endif /* PS_PARAMETERS_H_ */
@@ -45,6 +45,8 @@
 #include "communication_drivers/epi/sdram_mem.h"
 #include "communication_drivers/control/control.h"
 #include "communication_drivers/parameters/ps_parameters.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
+#include "communication_drivers/profiler/profiler.h"
 
 #include "ethernet_uip.h"
 
@@ -54,6 +56,8 @@ void init_system(void)
 {
     init_i2c_onboard();
 
+    init_eeprom_queue();
+
 	init_extern_io();
 
 	if(HARDWARE_VERSION == 0x21)
@@ -73,6 +77,10 @@ void init_system(void)
 
 	load_param_bank();
 
+	init_cycle_counter();
+
+	init_profiler();
+
 	init_ipc();
 
 	init_control_framework(&g_controller_mtoc);
@@ -85,14 +93,17 @@ void init_system(void)
 
 	dcdc_pwr_ctrl(true);
 
-	init_rs485();
-
 	init_rs485_bkp();
 
 	bsmp_init(0);
 
 	ethernet_init();
 
+	/**
+	 * RS-485 uses uDMA, enabled on ethernet_init()
+	 */
+	init_rs485();
+
 	display_pwr_ctrl(true);
 
 	rtc_init();
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file profiler.c
+ * @brief Execution time profiler module.
+ *
+ * Each entry is updated from a single context (an ISR, or TaskCheck for
+ * tasks and BSMP functions), so ```prof_record()``` doesn't need to disable
+ * interrupts. Reset and read are done entry by entry with interrupts
+ * disabled, so they never see an entry half updated by an ISR.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "driverlib/interrupt.h"
+
+#include "profiler.h"
+
+#pragma CODE_SECTION(prof_record, "ramfuncs");
+
+static prof_entry_t prof_entries[PROF_NUM_ENTRIES];
+
+static void clear_entry(prof_entry_t *p_entry)
+{
+    memset(p_entry, 0, sizeof(prof_entry_t));
+    p_entry->min = 0xFFFFFFFF;
+}
+
+/**
+ * @brief Initialize profiler
+ */
+void init_profiler(void)
+{
+    reset_profiler();
+}
+
+/**
+ * @brief Reset statistics of all entries
+ */
+void reset_profiler(void)
+{
+    bool int_disabled;
+    uint16_t i;
+
+    for(i = 0; i < PROF_NUM_ENTRIES; i++)
+    {
+        int_disabled = IntMasterDisable();
+        clear_entry(&prof_entries[i]);
+        if(!int_disabled)
+        {
+            IntMasterEnable();
+        }
+    }
+}
+
+/**
+ * @brief Record execution time of profiled code section
+ *
+ * @param id Entry ID, as defined in prof_id_t
+ * @param cycles Execution time in M3 clock cycles
+ */
+void prof_record(uint16_t id, uint32_t cycles)
+{
+    uint16_t bin;
+    uint32_t scaled;
+    prof_entry_t *p_entry;
+
+    if(id >= PROF_NUM_ENTRIES)
+    {
+        return;
+    }
+
+    p_entry = &prof_entries[id];
+
+    p_entry->count++;
+    p_entry->last = cycles;
+    p_entry->sum += cycles;
+
+    if(cycles < p_entry->min)
+    {
+        p_entry->min = cycles;
+    }
+
+    if(cycles > p_entry->max)
+    {
+        p_entry->max = cycles;
+    }
+
+    bin = 0;
+    scaled = cycles >> PROF_HIST_SHIFT;
+
+    while(scaled && (bin < PROF_HIST_BINS - 1))
+    {
+        scaled >>= 2;
+        bin++;
+    }
+
+    p_entry->hist[bin]++;
+}
+
+/**
+ * @brief Copy profiler entries
+ *
+ * @param first Index of first entry
+ * @param num Number of entries
+ * @param p_dst Pointer to destination
+ *
+ * @return Number of copied entries
+ */
+uint16_t get_profiler_entries(uint16_t first, uint16_t num, uint8_t *p_dst)
+{
+    bool int_disabled;
+    uint16_t i;
+
+    if(first >= PROF_NUM_ENTRIES)
+    {
+        return 0;
+    }
+
+    if(num > PROF_NUM_ENTRIES - first)
+    {
+        num = PROF_NUM_ENTRIES - first;
+    }
+
+    for(i = 0; i < num; i++)
+    {
+        int_disabled = IntMasterDisable();
+        memcpy(p_dst, &prof_entries[first + i], sizeof(prof_entry_t));
+        if(!int_disabled)
+        {
+            IntMasterEnable();
+        }
+
+        p_dst += sizeof(prof_entry_t);
+    }
+
+    return num;
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file profiler.h
+ * @brief Execution time profiler module.
+ *
+ * Execution time statistics of ISRs, system tasks and BSMP functions,
+ * measured with DWT cycle counter. Each profiled code section records its
+ * duration with ```prof_record()```:
+ *
+ *      uint32_t t_start = get_cycle_counter();
+ *      ...
+ *      prof_record(PROF_ISR_TIMER, get_cycle_counter() - t_start);
+ *
+ * Entries are exposed through BSMP curve 4, as an array of prof_entry_t
+ * indexed by prof_id_t. Durations of ISRs include nested ISRs of higher
+ * priority.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include <stdint.h>
+
+#define PROF_NUM_TASKS          16
+#define PROF_NUM_BSMP_FUNCS     56
+
+/**
+ * Histogram bins are spaced by a factor of 4. Bin 0 holds durations up to
+ * 2^PROF_HIST_SHIFT cycles and the last bin holds everything beyond 2^20
+ * cycles (~14 ms).
+ */
+#define PROF_HIST_BINS          8
+#define PROF_HIST_SHIFT         8
+
+#define PROF_ENTRIES_PER_BLOCK  16
+
+typedef enum
+{
+    PROF_ISR_TIMER,
+    PROF_ISR_ADCP,
+    PROF_ISR_RS485,
+    PROF_ISR_IPC_LOWPRIORITY,
+    PROF_ISR_ETHERNET,
+    PROF_FIRST_TASK,
+    PROF_FIRST_BSMP_FUNC = PROF_FIRST_TASK + PROF_NUM_TASKS,
+    PROF_NUM_ENTRIES = PROF_FIRST_BSMP_FUNC + PROF_NUM_BSMP_FUNCS
+} prof_id_t;
+
+#define PROF_TASK(task)         (PROF_FIRST_TASK + (task))
+#define PROF_BSMP_FUNC(id)      (PROF_FIRST_BSMP_FUNC + (id))
+
+/**
+ * Statistics of a profiled code section, in M3 clock cycles. Mean is given
+ * by sum/count.
+ */
+typedef struct
+{
+    uint32_t    count;
+    uint32_t    min;
+    uint32_t    max;
+    uint32_t    last;
+    uint64_t    sum;
+    uint32_t    hist[PROF_HIST_BINS];
+} prof_entry_t;
+
+extern void init_profiler(void);
+extern void reset_profiler(void);
+extern void prof_record(uint16_t id, uint32_t cycles);
+extern uint16_t get_profiler_entries(uint16_t first, uint16_t num,
+                                     uint8_t *p_dst);
+
+#endif /* PROFILER_H_ */
@@ -30,6 +30,8 @@
 #include "communication_drivers/adcp/adcp.h"
 #include "communication_drivers/bsmp/bsmp_lib.h"
 #include "communication_drivers/control/control.h"
+#include "communication_drivers/i2c_offboard_isolated/temp_low_power_module.h"
+#include "communication_drivers/system_task/system_task.h"
 
 #define APPLICATION         UVX_LINAC_RACK1
 
@@ -152,9 +154,16 @@ static uint8_t dummy_u8;
 */
 static void ipc_init_parameters(void)
 {
-    volatile uint8_t uiloop, uiloop2;
+    volatile uint16_t uiloop, uiloop2;
+    uint16_t num_ps_modules;
 
-    for (uiloop = 0; uiloop < (uint8_t) get_param(Num_PS_Modules,0); uiloop++)
+    num_ps_modules = get_param_u16(Num_PS_Modules, 0);
+    if(num_ps_modules > NUM_MAX_PS_MODULES)
+    {
+        num_ps_modules = NUM_MAX_PS_MODULES;
+    }
+
+    for (uiloop = 0; uiloop < num_ps_modules; uiloop++)
     {
         g_ipc_mtoc.ps_module[uiloop].ps_status.bit.model = FBP;
         g_ipc_mtoc.ps_module[uiloop].ps_status.bit.active = 1;
@@ -303,6 +312,17 @@ static void bsmp_init_server(void)
 
 }
 
+/**
+* Read temperature of power modules, on system task POWER_TEMP_SAMPLE
+*/
+static void power_temp_sample(void)
+{
+    power_supply_1_temp_read();
+    power_supply_2_temp_read();
+    power_supply_3_temp_read();
+    power_supply_4_temp_read();
+}
+
 /**
 * @brief System configuration for FBP.
 *
@@ -314,4 +334,6 @@ void fbp_system_config()
     adcp_channel_config();
     bsmp_init_server();
     //ipc_init_parameters();
+
+    TaskRegister(POWER_TEMP_SAMPLE, power_temp_sample);
 }
@@ -21,6 +21,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdarg.h>
 #include <string.h>
 #include <math.h>
@@ -31,6 +32,7 @@
 #include "inc/hw_nvic.h"
 #include "inc/hw_types.h"
 #include "inc/hw_gpio.h"
+#include "inc/hw_uart.h"
 
 #include "driverlib/gpio.h"
 #include "driverlib/sysctl.h"
@@ -39,6 +41,7 @@
 #include "driverlib/systick.h"
 #include "driverlib/debug.h"
 #include "driverlib/ram.h"
+#include "driverlib/udma.h"
 
 #include "board_drivers/hardware_def.h"
 
@@ -49,12 +52,19 @@
 #include "communication_drivers/system_task/system_task.h"
 #include "communication_drivers/ipc/ipc_lib.h"
 #include "communication_drivers/parameters/ps_parameters.h"
+#include "communication_drivers/profiler/profiler.h"
+#include "communication_drivers/timer/timer.h"
 
 #include "rs485.h"
 
 // Put the code in to the RAM memory
 #pragma CODE_SECTION(isr_rs485, "ramfuncs");
 #pragma CODE_SECTION(rs485_process_data, "ramfuncs");
+#pragma CODE_SECTION(rs485_process_frame, "ramfuncs");
+#pragma CODE_SECTION(rs485_push_frame, "ramfuncs");
+#pragma CODE_SECTION(rs485_rx_dma_handler, "ramfuncs");
+#pragma CODE_SECTION(rs485_tx_dma_handler, "ramfuncs");
+#pragma CODE_SECTION(rs485_tx_fifo_handler, "ramfuncs");
 
 //*****************************************************************************
 
@@ -69,9 +79,20 @@
 #define SERIAL_MASTER_ADDRESS   0   // Master Address
 #define SERIAL_BUF_SIZE         (SERIAL_HEADER+3+3+16834+SERIAL_CSUM)
 
+/**
+ * Largest request is a curve block write: curve ID (1) + block offset (2) +
+ * block data (1024)
+ */
+#define SERIAL_RX_BUF_SIZE      (SERIAL_HEADER+3+3+1024+SERIAL_CSUM)
+#define NUM_RX_BUFFERS          4
+#define NUM_TX_SPANS            3
+
 #define HIGH_SPEED_BAUD         6000000
 #define LOW_SPEED_BAUD          115200
 
+#define DMA_MIN_BAUD            1000000
+#define UDMA_MAX_TRANSFER       1024
+
 #define BAUDRATE_DEFAULT        HIGH_SPEED_BAUD
 
 static uint8_t SERIAL_CH_0_ADDRESS = 1;
@@ -92,18 +113,271 @@ struct serial_buffer
     uint8_t csum;
 };
 
-static struct serial_buffer recv_buffer = {.index = 0};
+struct serial_rx_buffer
+{
+    uint8_t data[SERIAL_RX_BUF_SIZE];
+    uint16_t index;
+    uint8_t csum;
+};
+
+/**
+ * Answer is sent from up to 3 spans: send buffer (header and BSMP message),
+ * data left in place by BSMP (zero-copy curve blocks) and checksum.
+ */
+struct serial_tx_span
+{
+    uint8_t *data;
+    uint16_t len;
+};
+
+typedef enum
+{
+    Rx_Header,
+    Rx_Payload
+} rx_dma_stage_t;
+
+/**
+ * Receive buffers are a single-producer, single-consumer queue of frames.
+ * RS-485 ISR receives into ```recv_buffer[rx_tail]``` and BSMP processing on
+ * TaskCheck() consumes from ```recv_buffer[rx_head]```. Each index is written
+ * by only one side, so no locking is needed.
+ */
+static struct serial_rx_buffer recv_buffer[NUM_RX_BUFFERS];
 static struct serial_buffer send_buffer = {.index = 0};
 
+static volatile uint16_t rx_head = 0;
+static volatile uint16_t rx_tail = 0;
+static struct serial_rx_buffer *p_recv_buffer = &recv_buffer[0];
+
 static struct bsmp_raw_packet recv_packet =
-                             { .data = recv_buffer.data + 1 };
+                             { .data = recv_buffer[0].data + 1 };
 static struct bsmp_raw_packet send_packet =
-                             { .data = send_buffer.data + 1 };
+                             { .data = send_buffer.data + 1,
+                               .ext_enabled = true };
+
+static struct serial_tx_span tx_span[NUM_TX_SPANS];
 
 //*****************************************************************************
 
 static uint8_t MessageOverflow = 0;
 
+static bool rs485_dma = false;
+
+static volatile rx_dma_stage_t rx_dma_stage = Rx_Header;
+static volatile uint16_t rx_dma_remaining = 0;
+static volatile uint16_t rx_dma_chunk = 0;
+static volatile uint16_t rx_dma_last_count = 0;
+
+/**
+ * Answer is transmitted in background, by uDMA or by UART TX interrupt, and
+ * ```tx_busy``` is set until its last byte leaves the transceiver.
+ */
+static volatile uint16_t tx_span_index = 0;
+static volatile uint16_t tx_index = 0;
+static volatile uint16_t tx_remaining = 0;
+static volatile uint16_t tx_dma_chunk = 0;
+static volatile bool tx_busy = false;
+
+//*****************************************************************************
+
+/**
+ * @brief Push received frame into queue
+ *
+ * Called by RS-485 ISR when a complete frame is available on
+ * ```p_recv_buffer```. Frames with wrong checksum are discarded. If queue is
+ * full, frame is discarded and its buffer is reused for next frame.
+ */
+static void rs485_push_frame(void)
+{
+    uint16_t next;
+
+    if(p_recv_buffer->csum == 0)
+    {
+        next = (rx_tail + 1) % NUM_RX_BUFFERS;
+
+        if(next != rx_head)
+        {
+            rx_tail = next;
+            p_recv_buffer = &recv_buffer[rx_tail];
+            TaskSetNew(PROCESS_RS485_MESSAGE);
+        }
+        else
+        {
+            MessageOverflow = 1;
+        }
+    }
+
+    p_recv_buffer->index = 0;
+    p_recv_buffer->csum  = 0;
+}
+
+/**
+ * @brief Start uDMA transfer from UART RX FIFO
+ *
+ * Transfers are limited to 1024 bytes by uDMA, so longer frames are received
+ * in chunks.
+ *
+ * @param p_dst Pointer to destination
+ * @param size Number of bytes to be received
+ */
+static void rs485_rx_dma_start(uint8_t *p_dst, uint16_t size)
+{
+    rx_dma_chunk = (size > UDMA_MAX_TRANSFER) ? UDMA_MAX_TRANSFER : size;
+
+    uDMAChannelTransferSet(RS485_UART_RX_UDMA | UDMA_PRI_SELECT,
+                           UDMA_MODE_BASIC,
+                           (void *)(RS485_UART_BASE + UART_O_DR),
+                           p_dst, rx_dma_chunk);
+
+    uDMAChannelEnable(RS485_UART_RX_UDMA);
+}
+
+/**
+ * @brief Restart reception of a new frame on current receive buffer
+ *
+ * Frame header (address, command and payload size) is received first, so
+ * the size of the rest of the frame is known.
+ */
+static void rs485_rx_dma_restart(void)
+{
+    p_recv_buffer->index = 0;
+    p_recv_buffer->csum  = 0;
+
+    rx_dma_stage = Rx_Header;
+    rx_dma_remaining = SERIAL_HEADER + BSMP_HEADER_SIZE;
+    rx_dma_last_count = 0;
+
+    rs485_rx_dma_start(p_recv_buffer->data, rx_dma_remaining);
+}
+
+/**
+ * @brief Handle completion of uDMA transfer from UART RX FIFO
+ */
+static void rs485_rx_dma_handler(void)
+{
+    uint16_t i, size;
+
+    p_recv_buffer->index += rx_dma_chunk;
+    rx_dma_remaining -= rx_dma_chunk;
+
+    if(rx_dma_remaining)
+    {
+        rs485_rx_dma_start(&p_recv_buffer->data[p_recv_buffer->index],
+                           rx_dma_remaining);
+    }
+
+    else if(rx_dma_stage == Rx_Header)
+    {
+        size = (p_recv_buffer->data[2]<<8) | p_recv_buffer->data[3];
+
+        if(size > (SERIAL_RX_BUF_SIZE - SERIAL_HEADER - BSMP_HEADER_SIZE -
+                   SERIAL_CSUM))
+        {
+            rs485_rx_dma_restart();
+        }
+        else
+        {
+            rx_dma_stage = Rx_Payload;
+            rx_dma_remaining = size + SERIAL_CSUM;
+            rs485_rx_dma_start(&p_recv_buffer->data[p_recv_buffer->index],
+                               rx_dma_remaining);
+        }
+    }
+
+    else
+    {
+        /**
+         * Frame complete: queue it and start receiving next frame on next
+         * free buffer
+         */
+        for(i = 0; i < p_recv_buffer->index; i++)
+        {
+            p_recv_buffer->csum += p_recv_buffer->data[i];
+        }
+
+        rs485_push_frame();
+        rs485_rx_dma_restart();
+    }
+}
+
+/**
+ * @brief Start uDMA transfer of next chunk of answer to UART TX FIFO
+ */
+static void rs485_tx_dma_start(void)
+{
+    uint16_t span_remaining;
+
+    // Skip empty spans
+    while(tx_index == tx_span[tx_span_index].len)
+    {
+        tx_span_index++;
+        tx_index = 0;
+    }
+
+    span_remaining = tx_span[tx_span_index].len - tx_index;
+
+    tx_dma_chunk = (span_remaining > UDMA_MAX_TRANSFER) ?
+                   UDMA_MAX_TRANSFER : span_remaining;
+
+    uDMAChannelTransferSet(RS485_UART_TX_UDMA | UDMA_PRI_SELECT,
+                           UDMA_MODE_BASIC,
+                           &tx_span[tx_span_index].data[tx_index],
+                           (void *)(RS485_UART_BASE + UART_O_DR),
+                           tx_dma_chunk);
+
+    uDMAChannelEnable(RS485_UART_TX_UDMA);
+}
+
+/**
+ * @brief Handle completion of uDMA transfer to UART TX FIFO
+ */
+static void rs485_tx_dma_handler(void)
+{
+    tx_index += tx_dma_chunk;
+    tx_remaining -= tx_dma_chunk;
+
+    if(tx_remaining)
+    {
+        rs485_tx_dma_start();
+    }
+}
+
+/**
+ * @brief Fill UART TX FIFO with next bytes of answer
+ *
+ * Used when uDMA is disabled. TX interrupt is raised on FIFO level while
+ * answer is being queued, and on end of transmission after its last byte is
+ * queued, so transceiver only returns to reception after the whole answer.
+ * Must be called from RS-485 ISR or with interrupts disabled.
+ */
+static void rs485_tx_fifo_handler(void)
+{
+    while(tx_remaining && UARTSpaceAvail(RS485_UART_BASE))
+    {
+        // Skip empty spans
+        while(tx_index == tx_span[tx_span_index].len)
+        {
+            tx_span_index++;
+            tx_index = 0;
+        }
+
+        UARTCharPutNonBlocking(RS485_UART_BASE,
+                               tx_span[tx_span_index].data[tx_index++]);
+        tx_remaining--;
+    }
+
+    if(!tx_remaining)
+    {
+        UARTTxIntModeSet(RS485_UART_BASE, UART_TXINT_MODE_EOT);
+
+        /**
+         * Discard FIFO level interrupt: end of transmission is still ahead,
+         * since last byte was just queued
+         */
+        UARTIntClear(RS485_UART_BASE, UART_INT_TX);
+    }
+}
+
 //*****************************************************************************
 
 void isr_rs485(void)
@@ -114,6 +388,7 @@ void isr_rs485(void)
 	uint32_t ulStatus;
 
 	uint8_t time_out = 0;
+	uint32_t t_start = get_cycle_counter();
 
 	// Get the interrrupt status.
 	ulStatus = UARTIntStatus(RS485_UART_BASE, true);
@@ -123,173 +398,202 @@ void isr_rs485(void)
 
 	if(UARTRxErrorGet(RS485_UART_BASE)) UARTRxErrorClear(RS485_UART_BASE);
 
-	// Receive Interrupt Mask
-	if(UART_INT_RX == ulStatus || UART_INT_RT == ulStatus)
+	/**
+	 * uDMA mode: completion of uDMA transfers is signaled by UART interrupt
+	 */
+	if(rs485_dma)
 	{
-
-	    // GPIO1 turn on
-	    //GPIOPinWrite(GPIO_PORTP_BASE, GPIO_PIN_7, ON);
-
-	    // Low baud-rate
-	    if(g_ipc_mtoc.communication.rs485_baud.f < 1000000)
+	    if(tx_remaining && !uDMAChannelIsEnabled(RS485_UART_TX_UDMA))
 	    {
-            for(time_out = 0; time_out < 15; time_out++)
-            {
-                // Loop while there are characters in the receive FIFO.
-                while(UARTCharsAvail(RS485_UART_BASE) &&
-                      recv_buffer.index < SERIAL_BUF_SIZE)
-                {
-
-                    recv_buffer.data[recv_buffer.index] =
-                            (uint8_t)UARTCharGet(RS485_UART_BASE);;
-                    recv_buffer.csum += recv_buffer.data[recv_buffer.index++];
-
-                    time_out = 0;
-
-                }
-            }
+	        rs485_tx_dma_handler();
+	    }
 
-            sCarga = (recv_buffer.data[2]<<8) | recv_buffer.data[3];
+	    if(!uDMAChannelIsEnabled(RS485_UART_RX_UDMA))
+	    {
+	        rs485_rx_dma_handler();
+	    }
+	}
 
-            if(recv_buffer.index > sCarga +4)
-            {
-                //TaskSetNew(PROCESS_RS485_MESSAGE);
-                rs485_process_data();
-                MessageOverflow = 0;
-            }
+	// Receive Interrupt Mask
+	else if(UART_INT_RX == ulStatus || UART_INT_RT == ulStatus)
+	{
 
-            if(sCarga > SERIAL_BUF_SIZE)
-            {
-                recv_buffer.index = 0;
-                recv_buffer.csum  = 0;
-                send_buffer.index = 0;
-                send_buffer.csum  = 0;
+	    // GPIO1 turn on
+	    //GPIOPinWrite(GPIO_PORTP_BASE, GPIO_PIN_7, ON);
 
-                MessageOverflow = 0;
-            }
-	    }
-	    // High baud-rate
-	    else
-	    {
-            for(time_out = 0; time_out < 15; time_out++)
+        for(time_out = 0; time_out < 15; time_out++)
+        {
+            // Loop while there are characters in the receive FIFO.
+            while(UARTCharsAvail(RS485_UART_BASE) &&
+                  p_recv_buffer->index < SERIAL_RX_BUF_SIZE)
             {
-                // Loop while there are characters in the receive FIFO.
-                while(UARTCharsAvail(RS485_UART_BASE) &&
-                        recv_buffer.index < SERIAL_BUF_SIZE)
-                {
 
-                    recv_buffer.data[recv_buffer.index] =
-                            (uint8_t)UARTCharGet(RS485_UART_BASE);
-                    recv_buffer.csum += recv_buffer.data[recv_buffer.index++];
-                    time_out = 0;
+                p_recv_buffer->data[p_recv_buffer->index] =
+                        (uint8_t)UARTCharGet(RS485_UART_BASE);
+                p_recv_buffer->csum +=
+                        p_recv_buffer->data[p_recv_buffer->index++];
 
-                }
-            }
-
-            sCarga = (recv_buffer.data[2]<<8) | recv_buffer.data[3];
+                time_out = 0;
 
-            if(recv_buffer.index > sCarga +4)
-            {
-                //TaskSetNew(PROCESS_RS485_MESSAGE);
-                rs485_process_data();
-                MessageOverflow = 0;
             }
-            else
-            {
-                recv_buffer.index = 0;
-                recv_buffer.csum  = 0;
-                send_buffer.index = 0;
-                send_buffer.csum  = 0;
-            }
-	    }
-    //#endif
+        }
+
+        sCarga = (p_recv_buffer->data[2]<<8) | p_recv_buffer->data[3];
+
+        if(p_recv_buffer->index > sCarga +4)
+        {
+            rs485_push_frame();
+        }
+
+        /**
+         * Discard frame whose payload can't fit in buffer, as done on uDMA
+         * mode, once its size field has been received
+         */
+        if( (p_recv_buffer->index >= SERIAL_HEADER + BSMP_HEADER_SIZE) &&
+            (sCarga > (SERIAL_RX_BUF_SIZE - SERIAL_HEADER - BSMP_HEADER_SIZE -
+                       SERIAL_CSUM)) )
+        {
+            p_recv_buffer->index = 0;
+            p_recv_buffer->csum  = 0;
+
+            MessageOverflow = 0;
+        }
 	}
 
     // Transmit Interrupt Mask
-	else if(UART_INT_TX == ulStatus) // TX interrupt
+	if( (UART_INT_TX & ulStatus) && tx_remaining && !rs485_dma )
+	{
+	    rs485_tx_fifo_handler();
+	}
+
+	else if( (UART_INT_TX & ulStatus) && !tx_remaining ) // TX interrupt
 	{
 		while(UARTBusy(RS485_RD_BASE));
 
 		// Put IC in the reception mode
 		GPIOPinWrite(RS485_RD_BASE, RS485_RD_PIN, OFF);
 
+		tx_busy = false;
+
+		// Resume processing of frames received during transmission
+		if(rx_head != rx_tail)
+		{
+		    TaskSetNew(PROCESS_RS485_MESSAGE);
+		}
+
 	}
+
+	prof_record(PROF_ISR_RS485, get_cycle_counter() - t_start);
 }
 
 void rs485_tx_handler(void)
 {
-	unsigned int i;
+	unsigned int i, span;
+	uint16_t len;
+	bool int_disabled;
 
 	// Prepare answer
 	send_buffer.data[0] = SERIAL_MASTER_ADDRESS;
 	send_buffer.csum    = 0;
 
+	len = send_packet.len + SERIAL_HEADER;
+
+	tx_span[0].data = send_buffer.data;
+	tx_span[0].len  = len;
+	tx_span[1].data = send_packet.ext_data;
+	tx_span[1].len  = send_packet.ext_len;
+	tx_span[2].data = &send_buffer.data[len];
+	tx_span[2].len  = SERIAL_CSUM;
+
+	// CheckSum calc
+	for(span = 0; span < NUM_TX_SPANS - 1; span++)
+	{
+	    for(i = 0; i < tx_span[span].len; ++i)
+	    {
+	        send_buffer.csum -= tx_span[span].data[i];
+	    }
+	}
+	send_buffer.data[len] = send_buffer.csum;
+
 	// Send packet
 
 	// Put IC in the transmition mode
 	GPIOPinWrite(RS485_RD_BASE, RS485_RD_PIN, ON);
 
-	for(i = 0; i < send_packet.len + SERIAL_HEADER; ++i)
+	tx_busy = true;
+	tx_span_index = 0;
+	tx_index = 0;
+	tx_remaining = len + send_packet.ext_len + SERIAL_CSUM;
+
+	if(rs485_dma)
 	{
-		// Wait until have space in the TX buffer
-		while(!UARTSpaceAvail(RS485_UART_BASE));
-		// CheckSum calc
-		send_buffer.csum -= send_buffer.data[i];
-		// Send Byte
-		UARTCharPut(RS485_UART_BASE, send_buffer.data[i]);
+	    rs485_tx_dma_start();
+	}
+	else
+	{
+	    int_disabled = IntMasterDisable();
+	    UARTTxIntModeSet(RS485_UART_BASE, UART_TXINT_MODE_FIFO);
+	    rs485_tx_fifo_handler();
+	    if(!int_disabled)
+	    {
+	        IntMasterEnable();
+	    }
 	}
-	// Wait until have space in the TX buffer
-	while(!UARTSpaceAvail(RS485_UART_BASE));
-	// Send Byte
-	UARTCharPut(RS485_UART_BASE, send_buffer.csum);
-
 }
 
-void rs485_process_data(void)
+/**
+ * @brief Process received frame
+ *
+ * Check frame address, execute BSMP request and transmit response.
+ *
+ * @param p_frame Pointer to received frame
+ */
+static void rs485_process_frame(struct serial_rx_buffer *p_frame)
 {
 	// Received less than HEADER + CSUM bytes
-	if(recv_buffer.index < (SERIAL_HEADER + SERIAL_CSUM))
+	if(p_frame->index < (SERIAL_HEADER + SERIAL_CSUM))
 		goto exit;
 
 	// Checksum is not zero
-	if(recv_buffer.csum)
+	if(p_frame->csum)
 		goto exit;
 
 	// Packet is not for me
-	if(recv_buffer.data[0] != SERIAL_CH_1_ADDRESS && recv_buffer.data[0] !=
-	        SERIAL_CH_2_ADDRESS && recv_buffer.data[0] != SERIAL_CH_3_ADDRESS
-	        && recv_buffer.data[0] != SERIAL_CH_0_ADDRESS &&
-	        recv_buffer.data[0] != BCAST_ADDRESS)
+	if(p_frame->data[0] != SERIAL_CH_1_ADDRESS && p_frame->data[0] !=
+	        SERIAL_CH_2_ADDRESS && p_frame->data[0] != SERIAL_CH_3_ADDRESS
+	        && p_frame->data[0] != SERIAL_CH_0_ADDRESS &&
+	        p_frame->data[0] != BCAST_ADDRESS)
 	    goto exit;
 
 	//GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
 
-	recv_packet.len = recv_buffer.index - SERIAL_HEADER - SERIAL_CSUM;
+	recv_packet.data = p_frame->data + 1;
+	recv_packet.len = p_frame->index - SERIAL_HEADER - SERIAL_CSUM;
 
 
-    if ((recv_buffer.data[0] == SERIAL_CH_0_ADDRESS) ||
-        (recv_buffer.data[0] == BCAST_ADDRESS))
+    if ((p_frame->data[0] == SERIAL_CH_0_ADDRESS) ||
+        (p_frame->data[0] == BCAST_ADDRESS))
     {
         g_current_ps_id = 0;
         g_ipc_mtoc.msg_id = 0;
         BSMPprocess(&recv_packet, &send_packet, 0);
     }
 
-    else if (recv_buffer.data[0] == SERIAL_CH_1_ADDRESS)
+    else if (p_frame->data[0] == SERIAL_CH_1_ADDRESS)
 	{
         g_current_ps_id = 1;
         g_ipc_mtoc.msg_id = 1;
 	    BSMPprocess(&recv_packet, &send_packet, 1);
 	}
 
-	else if (recv_buffer.data[0] == SERIAL_CH_2_ADDRESS)
+	else if (p_frame->data[0] == SERIAL_CH_2_ADDRESS)
     {
         g_current_ps_id = 2;
         g_ipc_mtoc.msg_id = 2;
         BSMPprocess(&recv_packet, &send_packet, 2);
     }
 
-	else if (recv_buffer.data[0] == SERIAL_CH_3_ADDRESS)
+	else if (p_frame->data[0] == SERIAL_CH_3_ADDRESS)
     {
         g_current_ps_id = 3;
         g_ipc_mtoc.msg_id = 3;
@@ -299,19 +603,59 @@ void rs485_process_data(void)
 	//GPIOPinWrite(DEBUG_BASE, DEBUG_PIN, OFF);
 
 	//rs485_bkp_tx_handler();
-    if (recv_buffer.data[0] != BCAST_ADDRESS)
+    if (p_frame->data[0] != BCAST_ADDRESS)
     {
         rs485_tx_handler();
     }
 
 	exit:
-	recv_buffer.index = 0;
-	recv_buffer.csum  = 0;
+	p_frame->index = 0;
+	p_frame->csum  = 0;
 	send_buffer.index = 0;
 	send_buffer.csum  = 0;
 
 }
 
+/**
+ * @brief Process received frames
+ *
+ * Consume all frames queued by RS-485 ISR. While the response of last frame
+ * is being transmitted, processing is postponed, but reception of next
+ * frames goes on.
+ */
+void rs485_process_data(void)
+{
+    while(rx_head != rx_tail)
+    {
+        /**
+         * Answer buffer is in use: frames left are processed when
+         * transmission ends, as isr_rs485 sets this task again
+         */
+        if(tx_busy)
+        {
+            return;
+        }
+
+        rs485_process_frame(&recv_buffer[rx_head]);
+
+        rx_head = (rx_head + 1) % NUM_RX_BUFFERS;
+        MessageOverflow = 0;
+    }
+}
+
+/**
+ * @brief Check whether an answer is being transmitted
+ *
+ * Zero-copy answers are sent straight from curve memory, which must not be
+ * modified until transmission is finished.
+ *
+ * @return true while last answer is being transmitted
+ */
+bool rs485_tx_busy(void)
+{
+    return tx_busy;
+}
+
 void set_rs485_ch_1_address(uint8_t addr)
 {
     if(addr < 33 && addr > 0 && addr != SERIAL_CH_1_ADDRESS)
@@ -378,7 +722,7 @@ void config_rs485(uint32_t BaudRate)
 	{
 	    BaudRate = BAUDRATE_DEFAULT;
 	    set_param(RS485_Baudrate,0,BaudRate);
-	    save_param_eeprom(RS485_Baudrate,0);
+	    post_save_param_eeprom(RS485_Baudrate,0);
 	}
 
 	// RS485 serial configuration, operation mode 8-N-1
@@ -389,22 +733,50 @@ void config_rs485(uint32_t BaudRate)
 
 void init_rs485(void)
 {
-	if(HARDWARE_VERSION == 0x21) rs485_term_ctrl(get_param(RS485_Termination,0));
+	if(HARDWARE_VERSION == 0x21) rs485_term_ctrl(get_param_u16(RS485_Termination, 0));
 
 	// Load RS485 address from EEPROM and config it
-    set_rs485_ch_0_address(get_param(RS485_Address,0));
-	set_rs485_ch_1_address(get_param(RS485_Address,1));
-	set_rs485_ch_2_address(get_param(RS485_Address,2));
-	set_rs485_ch_3_address(get_param(RS485_Address,3));
+    set_rs485_ch_0_address(get_param_u16(RS485_Address, 0));
+	set_rs485_ch_1_address(get_param_u16(RS485_Address, 1));
+	set_rs485_ch_2_address(get_param_u16(RS485_Address, 2));
+	set_rs485_ch_3_address(get_param_u16(RS485_Address, 3));
 
-	config_rs485(get_param(RS485_Baudrate,0));
+	config_rs485(get_param_float(RS485_Baudrate, 0));
 
 	UARTFIFOEnable(RS485_UART_BASE);
 	UARTFIFOLevelSet(RS485_UART_BASE,UART_FIFO_TX1_8,UART_FIFO_RX1_8);
 
+	// Use uDMA on high baud-rates. It requires uDMA controller enabled.
+	rs485_dma = (g_ipc_mtoc.communication.rs485_baud.f >= DMA_MIN_BAUD);
+
+	if(rs485_dma)
+	{
+	    UARTDMAEnable(RS485_UART_BASE, UART_DMA_RX | UART_DMA_TX);
+
+	    uDMAChannelAttributeDisable(RS485_UART_RX_UDMA, UDMA_ATTR_ALL);
+	    uDMAChannelAttributeDisable(RS485_UART_TX_UDMA, UDMA_ATTR_ALL);
+
+	    uDMAChannelControlSet(RS485_UART_RX_UDMA | UDMA_PRI_SELECT,
+	                          UDMA_SIZE_8 | UDMA_SRC_INC_NONE |
+	                          UDMA_DST_INC_8 | UDMA_ARB_1);
+
+	    uDMAChannelControlSet(RS485_UART_TX_UDMA | UDMA_PRI_SELECT,
+	                          UDMA_SIZE_8 | UDMA_SRC_INC_8 |
+	                          UDMA_DST_INC_NONE | UDMA_ARB_4);
+
+	    rs485_rx_dma_restart();
+	}
+
 	//Habilita interrupção pela UART1 (RS-485)
 	IntRegister(RS485_INT, isr_rs485);
-	UARTIntEnable(RS485_UART_BASE, UART_INT_RX | UART_INT_TX | UART_INT_RT);
+	if(rs485_dma)
+	{
+	    UARTIntEnable(RS485_UART_BASE, UART_INT_TX);
+	}
+	else
+	{
+	    UARTIntEnable(RS485_UART_BASE, UART_INT_RX | UART_INT_TX | UART_INT_RT);
+	}
 	//UARTIntEnable(RS485_UART_BASE, UART_INT_RX | UART_INT_RT);
 
 	//EOT - End of Transmission
@@ -418,3 +790,37 @@ void init_rs485(void)
 
 	IntEnable(RS485_INT);
 }
+
+/**
+ * @brief Check uDMA reception timeout
+ *
+ * In uDMA mode, there is no interrupt while a frame is incomplete. This
+ * function must be called periodically (1 ms) to discard incomplete frames
+ * which didn't receive any byte since last call, resynchronizing reception.
+ */
+void rs485_check_rx_timeout(void)
+{
+    uint16_t count;
+
+    if(!rs485_dma)
+    {
+        return;
+    }
+
+    IntDisable(RS485_INT);
+
+    count = p_recv_buffer->index + rx_dma_chunk -
+            uDMAChannelSizeGet(RS485_UART_RX_UDMA | UDMA_PRI_SELECT);
+
+    if( (count != 0) && (count == rx_dma_last_count) )
+    {
+        uDMAChannelDisable(RS485_UART_RX_UDMA);
+        rs485_rx_dma_restart();
+    }
+    else
+    {
+        rx_dma_last_count = count;
+    }
+
+    IntEnable(RS485_INT);
+}
@@ -23,12 +23,15 @@
 #define RS485_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdarg.h>
 #include <string.h>
 
 extern void init_rs485(void);
 extern void rs485_process_data(void);
 extern void config_rs485(uint32_t BaudRate);
+extern void rs485_check_rx_timeout(void);
+extern bool rs485_tx_busy(void);
 //extern void SetRS485Address(uint8_t addr);
 extern uint8_t ReadRS485Address(void);
 
@@ -20,6 +20,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+#include "driverlib/interrupt.h"
 
 #include "communication_drivers/i2c_onboard/rtc.h"
 #include "communication_drivers/i2c_offboard_isolated/temp_low_power_module.h"
@@ -29,191 +32,188 @@
 #include "communication_drivers/ihm/ihm.h"
 #include "communication_drivers/can/can_bkp.h"
 #include "communication_drivers/ipc/ipc_lib.h"
+#include "communication_drivers/ipc/ipc_cmd_queue.h"
 #include "communication_drivers/i2c_onboard/eeprom.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
 #include "communication_drivers/adcp/adcp.h"
+#include "communication_drivers/bsmp/bsmp_lib.h"
 #include "communication_drivers/i2c_onboard/exio.h"
+#include "communication_drivers/profiler/profiler.h"
+#include "communication_drivers/timer/timer.h"
 #include "system_task.h"
 
-volatile uint8_t LedCtrl = 0;
+static volatile uint8_t LedCtrl = 0;
 
-volatile bool READ_RTC = 0;
-volatile bool READ_IIB = 0;
-volatile bool ITLK_ALARM_RESET = 0;
-volatile bool PROCESS_DISP_MESS = 0;
-volatile bool PROCESS_ETH_MESS = 0;
-volatile bool PROCESS_CAN_MESS = 0;
-volatile bool PROCESS_RS485_MESS = 0;
-volatile bool PROCESS_POWER_TEMP_SAMPLE = 0;
-volatile bool LED_STATUS_REQUEST = 0;
-volatile bool SAMPLE_ADCP_REQUEST = 0;
-volatile bool ADCP_SAMPLE_AVAILABLE_REQUEST = 0;
+static void read_rtc(void);
+static void led_status(void);
 
-void
-TaskSetNew(uint8_t TaskNum)
+/**
+ * Tasks table, indexed by priority. Tasks without handler are just cleared
+ * when selected.
+ */
+task_t g_tasks[NUM_MAX_TASKS] =
 {
-	switch(TaskNum)
-	{
-	case SAMPLE_RTC:
-		READ_RTC = 1;
-		break;
-
-	case 0x10:
-		READ_IIB = 1;
-		break;
-
-	case CLEAR_ITLK_ALARM:
-		ITLK_ALARM_RESET = 1;
-		break;
-
-	case PROCESS_DISPLAY_MESSAGE:
-		PROCESS_DISP_MESS = 1;
-		break;
+	[ADCP_SAMPLE_AVAILABLE]		= { .handler = adcp_get_samples },
+	[SAMPLE_ADCP]				= { .handler = adcp_read },
+	[PROCESS_CAN_MESSAGE]		= { .handler = NULL },		// TODO: can_check
+	[PROCESS_RS485_MESSAGE]		= { .handler = rs485_process_data },
+	[PROCESS_ETHERNET_MESSAGE]	= { .handler = NULL },		// TODO: Ethernet
+	[PROCESS_DISPLAY_MESSAGE]	= { .handler = NULL },		// TODO: display_process_data
+	[SAMPLE_RTC]				= { .handler = read_rtc },
+	[READ_IIB]					= { .handler = rs485_bkp_tx_handler },
+	[CLEAR_ITLK_ALARM]			= { .handler = NULL },		// TODO: interlock_alarm_reset
+	[POWER_TEMP_SAMPLE]			= { .handler = NULL },		// Registered by PS module
+	[LED_STATUS]				= { .handler = led_status },
+};
 
-	case PROCESS_ETHERNET_MESSAGE:
-		PROCESS_ETH_MESS = 1;
-		break;
-
-	case PROCESS_CAN_MESSAGE:
-		PROCESS_CAN_MESS = 1;
-		break;
-
-	case PROCESS_RS485_MESSAGE:
-		PROCESS_RS485_MESS = 1;
-		break;
-
-	case POWER_TEMP_SAMPLE:
-		PROCESS_POWER_TEMP_SAMPLE = 1;
-		break;
-
-	case LED_STATUS:
-	    LED_STATUS_REQUEST = 1;
-	    break;
-
-	case SAMPLE_ADCP:
-	    SAMPLE_ADCP_REQUEST = 1;
-	    break;
-
-	case ADCP_SAMPLE_AVAILABLE:
-	    ADCP_SAMPLE_AVAILABLE_REQUEST = 1;
-	    break;
+/**
+ * Bitmap of pending tasks: bit n set means task n is pending
+ */
+static volatile uint32_t task_pending = 0;
 
-	default:
+/**
+ * Position of least significant bit set on (x & -x), by de Bruijn sequence
+ */
+static const uint8_t lsb_debruijn[32] =
+{
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9
+};
 
-		break;
+static void read_rtc(void)
+{
+	rtc_read_data_hour();
+	//HeartBeatLED();
+}
 
+static void led_status(void)
+{
+	if(LedCtrl)
+	{
+		led_sts_ctrl(0);
+		led_itlk_ctrl(0);
+		sound_sel_ctrl(0);
+		LedCtrl = 0;
+	}
+	else
+	{
+		led_sts_ctrl(1);
+		if( g_ipc_ctom.ps_module[0].ps_status.bit.state == Interlock ||
+			g_ipc_ctom.ps_module[1].ps_status.bit.state == Interlock ||
+			g_ipc_ctom.ps_module[2].ps_status.bit.state == Interlock ||
+			g_ipc_ctom.ps_module[3].ps_status.bit.state == Interlock )
+		{
+			led_itlk_ctrl(1);
+			sound_sel_ctrl(1);
+		}
+		LedCtrl = 1;
 	}
 }
 
-void
-TaskCheck(void)
+/**
+ * Background tasks, executed when there's nothing else to do
+ */
+static void task_idle(void)
 {
+	process_eeprom_queue();
 
-	if(ADCP_SAMPLE_AVAILABLE_REQUEST)
+	/**
+	 * Readout buffer may be the source of an answer still being transmitted
+	 */
+	if(!rs485_tx_busy())
 	{
-	    ADCP_SAMPLE_AVAILABLE_REQUEST = 0;
-	    adcp_get_samples();
+		update_buf_samples_readout();
 	}
 
-    /**********************************************
-     * TODO: Process CAN message
-     * *******************************************/
-    //else if(PROCESS_CAN_MESS)
-    //{
-    //  PROCESS_CAN_MESS = 0;
-    //  can_check();
-    //}
+	bsmp_update_curves_csum();
+}
 
-	else if(SAMPLE_ADCP_REQUEST)
-	{
-	    SAMPLE_ADCP_REQUEST = 0;
-	    adcp_read();
-	}
+/**
+ * Set task as pending. It may be called from any context.
+ *
+ * @param TaskNum task number
+ */
+void
+TaskSetNew(uint8_t TaskNum)
+{
+	bool int_disabled;
 
-	else if(PROCESS_RS485_MESS)
+	if(TaskNum < NUM_MAX_TASKS)
 	{
-		PROCESS_RS485_MESS = 0;
-		rs485_process_data();
+		int_disabled = IntMasterDisable();
+		task_pending |= (1UL << TaskNum);
+		if(!int_disabled)
+		{
+			IntMasterEnable();
+		}
 	}
+}
 
-	else if(PROCESS_ETH_MESS)
+/**
+ * Register handler for specified task, replacing the current one
+ *
+ * @param TaskNum task number
+ * @param handler function executed when task is selected
+ * @return 1 if successful, 0 if task number is invalid
+ */
+uint8_t
+TaskRegister(uint8_t TaskNum, void (*handler)(void))
+{
+	if(TaskNum < NUM_MAX_TASKS)
 	{
-		PROCESS_ETH_MESS = 0;
-		// Ethernet function
+		g_tasks[TaskNum].handler = handler;
+		return 1;
 	}
 
-    /**********************************************
-     * TODO: Display process data
-     * *******************************************/
-	//else if(PROCESS_DISP_MESS)
-	//{
-	//	PROCESS_DISP_MESS = 0;
-	//	display_process_data();
-	//}
+	return 0;
+}
+
+/**
+ * Run highest priority pending task, or background tasks if there's none.
+ * Only one task runs per call.
+ */
+void
+TaskCheck(void)
+{
+	bool int_disabled;
+	uint32_t pending, t_start;
+	uint8_t task;
+	task_t *p_task;
 
-	else if(READ_RTC)
-	{
-		READ_RTC = 0;
-		rtc_read_data_hour();
-		//HeartBeatLED();
-	}
+	/**
+	 * Dispatch pending IPC messages as soon as C28 acknowledges the last one
+	 */
+	process_ipc_cmd_queue();
 
-	else if(READ_IIB)
-	{
-		READ_IIB = 0;
-		rs485_bkp_tx_handler();
-	}
+	pending = task_pending;
 
-    /**********************************************
-     * TODO: Reset interlocks
-     * *******************************************/
-	//else if(ITLK_ALARM_RESET)
-	//{
-	//	ITLK_ALARM_RESET = 0;
-    //
-	//	interlock_alarm_reset();
-	//}
-
-	else if(PROCESS_POWER_TEMP_SAMPLE)
+	if(pending)
 	{
-		PROCESS_POWER_TEMP_SAMPLE = 0;
+		task = lsb_debruijn[((pending & -pending) * 0x077CB531UL) >> 27];
+		p_task = &g_tasks[task];
+
+		int_disabled = IntMasterDisable();
+		task_pending &= ~(1UL << task);
+		if(!int_disabled)
+		{
+			IntMasterEnable();
+		}
 
-		// TODO: Fix it
-		//switch(g_ipc_mtoc[0].PSModule.Model.u16)
-		switch(g_ipc_mtoc.ps_module[g_current_ps_id].ps_status.bit.model)
+		if(p_task->handler)
 		{
-			case FBP:
-			    power_supply_1_temp_read();
-                power_supply_2_temp_read();
-                power_supply_3_temp_read();
-                power_supply_4_temp_read();
-                break;
+			t_start = get_cycle_counter();
+
+			p_task->handler();
+
+			if(task < PROF_NUM_TASKS)
+			{
+				prof_record(PROF_TASK(task), get_cycle_counter() - t_start);
+			}
 		}
 	}
 
-	else if(LED_STATUS_REQUEST)
+	else
 	{
-	    LED_STATUS_REQUEST = 0;
-
-	    if(LedCtrl)
-        {
-	        led_sts_ctrl(0);
-            led_itlk_ctrl(0);
-            sound_sel_ctrl(0);
-            LedCtrl = 0;
-        }
-        else
-        {
-            led_sts_ctrl(1);
-            if( g_ipc_ctom.ps_module[0].ps_status.bit.state == Interlock ||
-                g_ipc_ctom.ps_module[1].ps_status.bit.state == Interlock ||
-                g_ipc_ctom.ps_module[2].ps_status.bit.state == Interlock ||
-                g_ipc_ctom.ps_module[3].ps_status.bit.state == Interlock )
-            {
-                led_itlk_ctrl(1);
-                sound_sel_ctrl(1);
-            }
-            LedCtrl = 1;
-        }
+		task_idle();
 	}
-
 }
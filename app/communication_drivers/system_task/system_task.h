@@ -23,23 +23,43 @@
 #ifndef SYSTEM_TASK_H_
 #define SYSTEM_TASK_H_
 
+#define NUM_MAX_TASKS   32
+
+/**
+ * Tasks are numbered by priority: when several are pending, the lowest
+ * number runs first. Power supply modules may register their own tasks,
+ * from FIRST_PS_MODULE_TASK up to NUM_MAX_TASKS - 1.
+ */
 typedef enum
 {
-	SAMPLE_RTC,
-	CLEAR_ITLK_ALARM,
-	PROCESS_DISPLAY_MESSAGE,
-	PROCESS_ETHERNET_MESSAGE,
+	ADCP_SAMPLE_AVAILABLE,
+	SAMPLE_ADCP,
 	PROCESS_CAN_MESSAGE,
 	PROCESS_RS485_MESSAGE,
+	PROCESS_ETHERNET_MESSAGE,
+	PROCESS_DISPLAY_MESSAGE,
+	SAMPLE_RTC,
+	READ_IIB,
+	CLEAR_ITLK_ALARM,
 	POWER_TEMP_SAMPLE,
-	EEPROM_WRITE_REQUEST_CHECK,
 	LED_STATUS,
-	SAMPLE_ADCP,
-	ADCP_SAMPLE_AVAILABLE
+	FIRST_PS_MODULE_TASK
 }eTask;
 
+/**
+ * Execution time of tasks is recorded on profiler
+ */
+typedef struct
+{
+	void			(*handler)(void);
+} task_t;
+
+extern task_t g_tasks[NUM_MAX_TASKS];
+
 extern void TaskCheck(void);
 
 extern void TaskSetNew(uint8_t TaskNum);
 
+extern uint8_t TaskRegister(uint8_t TaskNum, void (*handler)(void));
+
 #endif /* SYSTEM_TASK_H_ */
@@ -19,6 +19,7 @@
  */
 
 #include <stdint.h>
+#include <stddef.h>
 
 #include "inc/hw_sysctl.h"
 #include "inc/hw_ints.h"
@@ -32,12 +33,55 @@
 #include "driverlib/gpio.h"
 
 #include "communication_drivers/adcp/adcp.h"
+#include "communication_drivers/profiler/profiler.h"
 #include "communication_drivers/system_task/system_task.h"
 #include "communication_drivers/i2c_onboard/exio.h"
+#include "communication_drivers/rs485/rs485.h"
 #include "board_drivers/hardware_def.h"
 
-uint16_t time = 0x00;
-uint8_t  iib_sample = 0x00;
+#include "timer.h"
+
+/**
+ * Cortex-M3 debug registers used for the cycle counter
+ */
+#define DEMCR                   0xE000EDFC
+#define DEMCR_TRCENA            0x01000000
+#define DWT_CTRL                0xE0001000
+#define DWT_CTRL_CYCCNTENA      0x00000001
+#define DWT_CYCCNT              0xE0001004
+
+static timer_wheel_entry_t *timer_wheel[TIMER_WHEEL_SIZE];
+static volatile uint32_t timer_wheel_ticks = 0;
+
+/**
+ * Default periodic timers, with phases spread across the 1000 ticks period
+ */
+static timer_wheel_entry_t timer_rtc;
+static timer_wheel_entry_t timer_power_temp;
+#if HARDWARE_VERSION == 0x21
+static timer_wheel_entry_t timer_led_status;
+#endif
+
+static void insert_timer_wheel(timer_wheel_entry_t *p_entry, uint32_t delay);
+static void remove_timer_wheel(timer_wheel_entry_t *p_entry);
+static void process_timer_wheel(void);
+
+static void request_rtc(void)
+{
+    TaskSetNew(SAMPLE_RTC);
+}
+
+static void request_power_temp(void)
+{
+    TaskSetNew(POWER_TEMP_SAMPLE);
+}
+
+#if HARDWARE_VERSION == 0x21
+static void request_led_status(void)
+{
+    TaskSetNew(LED_STATUS);
+}
+#endif
 
 /**
  * @brief Interrupt Service Routine for global timer
@@ -45,8 +89,8 @@ uint8_t  iib_sample = 0x00;
 
 void isr_global_timer(void)
 {
-	time++;
-	iib_sample++;
+	uint32_t t_start = get_cycle_counter();
+
 	// Apaga a interrup��o do timer 0 A
 	TimerIntClear(TIMER0_BASE, TIMER_TIMA_TIMEOUT);
 
@@ -55,28 +99,18 @@ void isr_global_timer(void)
 	adcp_read();
 	//TaskSetNew(SAMPLE_ADCP);
 
-	if(iib_sample >= 40)
-	{
-		iib_sample = 0;
-		//TaskSetNew(0x10);
-	}
-
-	if(time >= 1000)
-	{
-		time = 0;
-		TaskSetNew(SAMPLE_RTC);
-		TaskSetNew(POWER_TEMP_SAMPLE);
-		#if HARDWARE_VERSION == 0x21
-		    TaskSetNew(LED_STATUS);
-			#endif
-	}
+	rs485_check_rx_timeout();
 
+	process_timer_wheel();
+
+	prof_record(PROF_ISR_TIMER, get_cycle_counter() - t_start);
 }
 
 /*
  * @brief Global timer Initialization.
  *
- * TIMER0 A is responsible for the time increment in test routine.
+ * TIMER0 A is responsible for the time increment in test routine. Each tick
+ * advances the timer wheel, which triggers periodic system tasks.
  */
 
 void global_timer_init(void)
@@ -93,7 +127,204 @@ void global_timer_init(void)
 
 	IntPrioritySet(INT_TIMER0A, 3);
 
+    add_timer_wheel(&timer_rtc, request_rtc, 1000, 1000);
+    add_timer_wheel(&timer_power_temp, request_power_temp, 1000, 250);
+#if HARDWARE_VERSION == 0x21
+    add_timer_wheel(&timer_led_status, request_led_status, 1000, 500);
+#endif
+
 	IntEnable(INT_TIMER0A);
 
 	TimerEnable(TIMER0_BASE, TIMER_A);
 }
+
+/**
+ * @brief Get number of global timer ticks.
+ *
+ * @return Number of TIMER0 ticks since initialization
+ */
+uint32_t get_timer_wheel_ticks(void)
+{
+    return timer_wheel_ticks;
+}
+
+/**
+ * @brief Add timer to timer wheel.
+ *
+ * Callback is first executed after ```phase``` ticks, then every ```period```
+ * ticks. Modules with the same period should use different phases, so their
+ * work is spread across ticks. If entry is already active, it's rescheduled.
+ *
+ * @param p_entry Pointer to timer entry, owned by caller
+ * @param callback Function executed on TIMER0 ISR
+ * @param period Period in ticks. 0 for one-shot timer
+ * @param phase Delay in ticks for first execution. 0 is handled as 1
+ */
+void add_timer_wheel(timer_wheel_entry_t *p_entry, void (*callback)(void),
+                     uint32_t period, uint32_t phase)
+{
+    bool int_disabled;
+
+    int_disabled = IntMasterDisable();
+
+    if(p_entry->active)
+    {
+        remove_timer_wheel(p_entry);
+    }
+
+    p_entry->callback = callback;
+    p_entry->period = period;
+    insert_timer_wheel(p_entry, phase);
+
+    if(!int_disabled)
+    {
+        IntMasterEnable();
+    }
+}
+
+/**
+ * @brief Cancel timer.
+ *
+ * It's safe to cancel an inactive timer, or to cancel a timer from its own
+ * callback.
+ *
+ * @param p_entry Pointer to timer entry
+ */
+void cancel_timer_wheel(timer_wheel_entry_t *p_entry)
+{
+    bool int_disabled;
+
+    int_disabled = IntMasterDisable();
+
+    if(p_entry->active)
+    {
+        remove_timer_wheel(p_entry);
+    }
+
+    if(!int_disabled)
+    {
+        IntMasterEnable();
+    }
+}
+
+/**
+ * @brief Insert timer into wheel.
+ *
+ * Each slot keeps its timers sorted by expiration tick, so the ISR only
+ * checks the head of current slot. Must be called with interrupts disabled.
+ *
+ * @param p_entry Pointer to timer entry
+ * @param delay Number of ticks until expiration
+ */
+static void insert_timer_wheel(timer_wheel_entry_t *p_entry, uint32_t delay)
+{
+    timer_wheel_entry_t **pp_entry;
+
+    if(delay == 0)
+    {
+        delay = 1;
+    }
+
+    p_entry->expires = timer_wheel_ticks + delay;
+    p_entry->slot = p_entry->expires & TIMER_WHEEL_MASK;
+
+    pp_entry = &timer_wheel[p_entry->slot];
+
+    while( (*pp_entry != NULL) &&
+           ((int32_t) ((*pp_entry)->expires - p_entry->expires) <= 0) )
+    {
+        pp_entry = &(*pp_entry)->next;
+    }
+
+    p_entry->next = *pp_entry;
+    p_entry->active = true;
+    *pp_entry = p_entry;
+}
+
+/**
+ * @brief Remove timer from wheel.
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param p_entry Pointer to active timer entry
+ */
+static void remove_timer_wheel(timer_wheel_entry_t *p_entry)
+{
+    timer_wheel_entry_t **pp_entry;
+
+    pp_entry = &timer_wheel[p_entry->slot];
+
+    while( (*pp_entry != NULL) && (*pp_entry != p_entry) )
+    {
+        pp_entry = &(*pp_entry)->next;
+    }
+
+    if(*pp_entry == p_entry)
+    {
+        *pp_entry = p_entry->next;
+    }
+
+    p_entry->active = false;
+}
+
+/**
+ * @brief Advance timer wheel by one tick.
+ *
+ * Timers at the head of current slot which expire on this tick are
+ * detached one at a time, rescheduled if periodic and then executed, so
+ * callbacks may add or cancel timers, including themselves. Timers waiting
+ * for extra rounds are behind them and aren't visited, so ISR work is
+ * proportional to the number of expired timers.
+ */
+static void process_timer_wheel(void)
+{
+    timer_wheel_entry_t *p_entry;
+    timer_wheel_entry_t **pp_slot;
+
+    timer_wheel_ticks++;
+
+    pp_slot = &timer_wheel[timer_wheel_ticks & TIMER_WHEEL_MASK];
+
+    while( (*pp_slot != NULL) && ((*pp_slot)->expires == timer_wheel_ticks) )
+    {
+        p_entry = *pp_slot;
+        *pp_slot = p_entry->next;
+
+        if(p_entry->period)
+        {
+            insert_timer_wheel(p_entry, p_entry->period);
+        }
+        else
+        {
+            p_entry->active = false;
+        }
+
+        p_entry->callback();
+    }
+}
+
+/**
+ * @brief Cycle counter Initialization.
+ *
+ * Enable DWT cycle counter, used for timestamps and profiling. It counts
+ * M3 clock cycles and wraps around every 2^32 cycles (~57 s at 75 MHz).
+ */
+void init_cycle_counter(void)
+{
+    HWREG(DEMCR) |= DEMCR_TRCENA;
+    HWREG(DWT_CYCCNT) = 0;
+    HWREG(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * @brief Get current value of cycle counter.
+ *
+ * Differences between two readings are valid across wrap around if computed
+ * with unsigned 32-bit arithmetic.
+ *
+ * @return Number of M3 clock cycles since cycle counter initialization
+ */
+uint32_t get_cycle_counter(void)
+{
+    return HWREG(DWT_CYCCNT);
+}
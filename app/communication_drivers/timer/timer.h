@@ -21,6 +21,45 @@
 #ifndef TIMER_H_
 #define TIMER_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * M3 clock cycles per microsecond, used to convert cycle counter readings
+ */
+#define CYCLES_PER_US   75
+
+/**
+ * Number of slots of timer wheel. Must be a power of 2. Timers with delay
+ * longer than the wheel stay in their slot for extra rounds.
+ */
+#define TIMER_WHEEL_SIZE    64
+#define TIMER_WHEEL_MASK    (TIMER_WHEEL_SIZE - 1)
+
+typedef struct timer_wheel_entry timer_wheel_entry_t;
+
+/**
+ * Timer wheel entry. It's allocated by the owner module and must not be
+ * modified while active. ```callback``` is executed on TIMER0 ISR, so it
+ * should be short, usually just a TaskSetNew().
+ */
+struct timer_wheel_entry
+{
+    timer_wheel_entry_t *next;
+    void                (*callback)(void);
+    uint32_t            period;
+    uint32_t            expires;
+    uint16_t            slot;
+    bool                active;
+};
+
 extern void global_timer_init(void);
+extern uint32_t get_timer_wheel_ticks(void);
+extern void add_timer_wheel(timer_wheel_entry_t *p_entry,
+                            void (*callback)(void),
+                            uint32_t period, uint32_t phase);
+extern void cancel_timer_wheel(timer_wheel_entry_t *p_entry);
+extern void init_cycle_counter(void);
+extern uint32_t get_cycle_counter(void);
 
 #endif /* APP_COMMUNICATION_DRIVERS_TIMER_TIMER_H_ */
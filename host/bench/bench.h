@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file bench.h
+ * @brief Helpers for host benchmarks of DSP kernels.
+ *
+ * Each benchmark program is built once per optimization level, with the
+ * kernels it times, and prints a row per kernel: ns per sample of a single
+ * module, for the scalar function and its fast counterpart. A step runs a
+ * kernel over all its modules for one sample, after updating inputs. Input
+ * update alone is timed as well and subtracted, and the fastest of a few
+ * runs is taken, to reduce noise from the workstation.
+ *
+ * Times are measured on the workstation, so they compare kernels and
+ * compilers among themselves, not with M3 or C28 cycles.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#ifndef BENCH_FLAGS
+#define BENCH_FLAGS     ""
+#endif
+
+#define BENCH_SAMPLES   200000
+#define BENCH_RUNS      5
+
+#define BENCH_SIGNAL_SIZE   1024
+
+static float bench_signal[BENCH_SIGNAL_SIZE];
+
+/**
+ * Fill input signal table: sum of two sines, within +/- 1.5
+ */
+static inline void bench_init_signal(void)
+{
+    uint16_t n;
+
+    for(n = 0; n < BENCH_SIGNAL_SIZE; n++)
+    {
+        bench_signal[n] = sinf(0.0123 * n) + 0.5 * sinf(0.377 * n);
+    }
+}
+
+static inline double bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * Time a step, which processes one sample
+ *
+ * @return ns per step, fastest of BENCH_RUNS
+ */
+static inline double bench_time(void (*step)(void))
+{
+    double t_start, t, t_min = INFINITY;
+    uint32_t n;
+    uint16_t run;
+
+    for(run = 0; run < BENCH_RUNS; run++)
+    {
+        t_start = bench_now_ns();
+
+        for(n = 0; n < BENCH_SAMPLES; n++)
+        {
+            step();
+        }
+
+        t = (bench_now_ns() - t_start) / BENCH_SAMPLES;
+
+        if(t < t_min)
+        {
+            t_min = t;
+        }
+    }
+
+    return t_min;
+}
+
+/**
+ * Print table header, unless program was called with "-n", as done for all
+ * optimization levels but the first one
+ */
+static inline void bench_header(int argc, char **argv, const char *fast)
+{
+    if( (argc > 1) && !strcmp(argv[1], "-n") )
+    {
+        return;
+    }
+
+    printf("\n%-16s %-22s %12s %12s %8s\n", "kernel", "flags", "scalar ns",
+           fast, "speedup");
+}
+
+/**
+ * Print row of a kernel. Times are ns per step, converted to ns per sample
+ * of a single module after subtracting input update.
+ */
+static inline void bench_row(const char *kernel, double t_scalar,
+                             double t_fast, double t_inputs,
+                             uint16_t num_modules)
+{
+    double ns_scalar = (t_scalar - t_inputs) / num_modules;
+    double ns_fast = (t_fast - t_inputs) / num_modules;
+
+    printf("%-16s %-22s %12.2f %12.2f %7.2fx\n", kernel, BENCH_FLAGS,
+           ns_scalar, ns_fast, ns_scalar / ns_fast);
+}
+
+#endif /* BENCH_H_ */
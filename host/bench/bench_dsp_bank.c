@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file bench_dsp_bank.c
+ * @brief Banks of DSP modules against scalar modules.
+ *
+ * For each class, DSP_BANK_SIZE modules run either one run_dsp_* call per
+ * module, as the Control Framework does, or a single run_dsp_*_bank call.
+ * Modules are configured as in test_dsp_bank.c.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include "bench.h"
+#include "dsp.h"
+#include "dsp_bank.h"
+
+#define FREQ_SAMPLING   50000.0
+
+static volatile float in[DSP_BANK_SIZE];
+static volatile float out_scalar[DSP_BANK_SIZE];
+static volatile float out_bank[DSP_BANK_SIZE];
+
+static uint32_t n_sample;
+
+static dsp_lpf_t lpf[DSP_BANK_SIZE];
+static dsp_pi_t pi[DSP_BANK_SIZE];
+static dsp_iir_2p2z_t iir_2p2z[DSP_BANK_SIZE];
+static dsp_iir_3p3z_t iir_3p3z[DSP_BANK_SIZE];
+
+static dsp_lpf_bank_t lpf_bank;
+static dsp_pi_bank_t pi_bank;
+static dsp_iir_2p2z_bank_t iir_2p2z_bank;
+static dsp_iir_3p3z_bank_t iir_3p3z_bank;
+
+static inline void update_inputs(void)
+{
+    uint16_t i;
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        in[i] = bench_signal[(n_sample + 37*i) % BENCH_SIGNAL_SIZE];
+    }
+
+    n_sample++;
+}
+
+static void step_inputs(void)
+{
+    update_inputs();
+}
+
+#define BENCH_STEPS(name)                                                   \
+    static void step_##name(void)                                           \
+    {                                                                       \
+        uint16_t i;                                                         \
+                                                                            \
+        update_inputs();                                                    \
+        for(i = 0; i < DSP_BANK_SIZE; i++)                                  \
+        {                                                                   \
+            run_dsp_##name(&name[i]);                                       \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    static void step_##name##_bank(void)                                    \
+    {                                                                       \
+        update_inputs();                                                    \
+        run_dsp_##name##_bank(&name##_bank);                                \
+    }
+
+BENCH_STEPS(lpf)
+BENCH_STEPS(pi)
+BENCH_STEPS(iir_2p2z)
+BENCH_STEPS(iir_3p3z)
+
+static void init_modules(void)
+{
+    uint16_t i;
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        init_dsp_lpf(&lpf[i], 100.0 * (i + 1), FREQ_SAMPLING, &in[i],
+                     &out_scalar[i]);
+        init_dsp_pi(&pi[i], 0.2 * (i + 1), 50.0 * (i + 1), FREQ_SAMPLING, 1.0,
+                    -1.0, &in[i], &out_scalar[i]);
+        init_dsp_notch_2p2z(&iir_2p2z[i], 0.9, 500.0 * (i + 1), FREQ_SAMPLING,
+                            1.0, -1.0, &in[i], &out_scalar[i]);
+        init_dsp_iir_3p3z(&iir_3p3z[i], 0.1, 0.2 * i, 0.05, 0.01, -1.2, 0.4,
+                          -0.05, 1.0, -1.0, &in[i], &out_scalar[i]);
+    }
+
+    load_dsp_lpf_bank(&lpf_bank, lpf, DSP_BANK_SIZE);
+    load_dsp_pi_bank(&pi_bank, pi, DSP_BANK_SIZE);
+    load_dsp_iir_2p2z_bank(&iir_2p2z_bank, iir_2p2z, DSP_BANK_SIZE);
+    load_dsp_iir_3p3z_bank(&iir_3p3z_bank, iir_3p3z, DSP_BANK_SIZE);
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        lpf_bank.out[i] = &out_bank[i];
+        pi_bank.out[i] = &out_bank[i];
+        iir_2p2z_bank.out[i] = &out_bank[i];
+        iir_3p3z_bank.out[i] = &out_bank[i];
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double t_inputs;
+
+    bench_init_signal();
+    init_modules();
+
+    bench_header(argc, argv, "bank ns");
+
+    t_inputs = bench_time(step_inputs);
+
+    bench_row("lpf", bench_time(step_lpf), bench_time(step_lpf_bank),
+              t_inputs, DSP_BANK_SIZE);
+    bench_row("pi", bench_time(step_pi), bench_time(step_pi_bank),
+              t_inputs, DSP_BANK_SIZE);
+    bench_row("iir_2p2z", bench_time(step_iir_2p2z),
+              bench_time(step_iir_2p2z_bank), t_inputs, DSP_BANK_SIZE);
+    bench_row("iir_3p3z", bench_time(step_iir_3p3z),
+              bench_time(step_iir_3p3z_bank), t_inputs, DSP_BANK_SIZE);
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file bench_dsp_vect_fast.c
+ * @brief Prepared matrix-vector product against run_dsp_vect_product().
+ *
+ * Each case of test_dsp_vect_fast.c is timed with run_dsp_vect_product() and
+ * with the kernel selected by load_dsp_vect_product_fast(): unrolled for
+ * 2x2, 4x4 and 8x8, dense for other sizes and CSR for sparse matrices, whose
+ * rows have two non-zero elements.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bench.h"
+#include "dsp.h"
+#include "dsp_vect_fast.h"
+
+static volatile float in[NUM_MAX_MATRIX_SIZE];
+static volatile float out_ref[NUM_MAX_MATRIX_SIZE];
+static volatile float out_fast[NUM_MAX_MATRIX_SIZE];
+
+static uint32_t n_sample;
+static uint16_t num_inputs;
+
+static dsp_vect_product_t vect_product;
+static dsp_vect_product_fast_t fast;
+
+static inline void update_inputs(void)
+{
+    uint16_t c;
+
+    for(c = 0; c < num_inputs; c++)
+    {
+        in[c] = bench_signal[(n_sample + 37*c) % BENCH_SIGNAL_SIZE];
+    }
+
+    n_sample++;
+}
+
+static void step_inputs(void)
+{
+    update_inputs();
+}
+
+static void step_vect_product(void)
+{
+    update_inputs();
+    run_dsp_vect_product(&vect_product);
+}
+
+static void step_vect_product_fast(void)
+{
+    update_inputs();
+    run_dsp_vect_product_fast(&fast);
+}
+
+/**
+ * Fill matrix from input signal table. When sparse, only diagonal and one
+ * element of each row are non-zero, as in test_dsp_vect_fast.c.
+ */
+static void fill_matrix(uint16_t num_rows, uint16_t num_cols,
+                        volatile float matrix[num_rows][num_cols],
+                        bool sparse)
+{
+    uint16_t r, c;
+
+    for(r = 0; r < num_rows; r++)
+    {
+        for(c = 0; c < num_cols; c++)
+        {
+            if( !sparse || (r == c) || (c == ((r + 3) % num_cols)) )
+            {
+                matrix[r][c] = bench_signal[(r*num_cols + c) * 7];
+            }
+            else
+            {
+                matrix[r][c] = 0.0;
+            }
+        }
+    }
+}
+
+static void bench_vect_product(const char *kernel, uint16_t num_rows,
+                               uint16_t num_cols, bool sparse,
+                               bool allow_sparse)
+{
+    volatile float matrix[num_rows][num_cols];
+
+    fill_matrix(num_rows, num_cols, matrix, sparse);
+    init_dsp_vect_product(&vect_product, num_rows, num_cols, matrix, in,
+                          out_ref);
+    load_dsp_vect_product_fast(&fast, &vect_product, allow_sparse);
+    fast.out = out_fast;
+
+    num_inputs = num_cols;
+
+    bench_row(kernel, bench_time(step_vect_product),
+              bench_time(step_vect_product_fast), bench_time(step_inputs), 1);
+}
+
+int main(int argc, char **argv)
+{
+    bench_init_signal();
+
+    bench_header(argc, argv, "fast ns");
+
+    bench_vect_product("2x2 unrolled", 2, 2, false, true);
+    bench_vect_product("4x4 unrolled", 4, 4, false, true);
+    bench_vect_product("8x8 unrolled", 8, 8, false, true);
+    bench_vect_product("3x5 dense", 3, 5, false, true);
+    bench_vect_product("12x12 dense", NUM_MAX_MATRIX_SIZE,
+                       NUM_MAX_MATRIX_SIZE, false, true);
+    bench_vect_product("8x8 sparse unrl", 8, 8, true, false);
+    bench_vect_product("8x8 sparse CSR", 8, 8, true, true);
+    bench_vect_product("12x6 sparse CSR", NUM_MAX_MATRIX_SIZE, 6, true, true);
+
+    return 0;
+}
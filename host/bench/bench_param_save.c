@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file bench_param_save.c
+ * @brief Cost of saving and loading the parameters bank on the EEPROM model.
+ *
+ * Whole bank is saved and loaded as the firmware did before parameters bank
+ * images, one I2C transaction per element followed by a fixed 375000 loops
+ * SysCtlDelay, and as an image through EEPROM write queue. I2C transactions
+ * and write cycles are counted by the EEPROM model, and time spent on EEPROM
+ * is estimated from them with a 5 ms write cycle on a 400 kHz bus. CPU time
+ * is the time the caller is blocked: fixed delays for per-element saves, and
+ * I2C transfers only for the write queue, which polls write cycle completion
+ * from background.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+
+#include "fw_host.h"
+
+#include "board_drivers/hardware_def.h"
+#include "communication_drivers/i2c_onboard/eeprom.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
+#include "communication_drivers/i2c_onboard/i2c_onboard.h"
+#include "communication_drivers/parameters/ps_parameters.h"
+#include "communication_drivers/timer/timer.h"
+
+/**
+ * Save whole bank one element at a time, as ```save_param_bank()``` did
+ * before parameters bank images
+ */
+static void save_param_bank_per_element(void)
+{
+    uint8_t data[2 + 4];
+    uint8_t size_type;
+    u_uint16_t u_add;
+    param_id_t id;
+    uint16_t n;
+
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        size_type = g_parameters[id].size_type;
+
+        for(n = 0; n < g_parameters[id].num_elements; n++)
+        {
+            u_add.u16 = g_parameters[id].eeprom_add.u16 + size_type*n;
+            data[0] = u_add.u8[1];
+            data[1] = u_add.u8[0];
+            memcpy(&data[2], g_parameters[id].p_val.u8 + size_type*n,
+                   size_type);
+
+            GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, OFF);
+            write_i2c(I2C_SLV_ADDR_EEPROM, 2 + size_type, data);
+            SysCtlDelay(375000);
+            GPIOPinWrite(EEPROM_WP_BASE, EEPROM_WP_PIN, ON);
+        }
+    }
+}
+
+static void print_row(const char *name, double cpu_us)
+{
+    printf("%-26s %8u %8u %8u %8u %10.1f %10.1f\n", name,
+           g_host_i2c_stats.reads, g_host_i2c_stats.writes,
+           g_host_i2c_stats.bytes_read + g_host_i2c_stats.bytes_written,
+           g_host_i2c_stats.ack_polls, host_i2c_time_us(&g_host_i2c_stats) /
+           1000.0, cpu_us / 1000.0);
+}
+
+static void start(void)
+{
+    memset(&g_host_i2c_stats, 0, sizeof(g_host_i2c_stats));
+    g_host_delay_cycles = 0;
+}
+
+/**
+ * Bus time of I2C transfers only, without write cycles
+ */
+static double bus_us(void)
+{
+    return host_i2c_time_us(&g_host_i2c_stats) -
+           (double) g_host_i2c_stats.writes * HOST_EEPROM_TWR_US;
+}
+
+int main(void)
+{
+    host_fw_reset();
+    init_parameters_bank();
+    init_eeprom_queue();
+
+    printf("Parameters bank: %u elements\n\n", get_param_bank_size());
+    printf("%-26s %8s %8s %8s %8s %10s %10s\n", "", "reads", "writes",
+           "bytes", "polls", "EEPROM ms", "CPU ms");
+
+    start();
+    save_param_bank_per_element();
+    print_row("save per element", bus_us() +
+              (double) g_host_delay_cycles / CYCLES_PER_US);
+
+    start();
+    post_save_param_bank();
+    while(eeprom_queue_busy())
+    {
+        process_eeprom_queue();
+    }
+    print_row("save image", bus_us());
+
+    /**
+     * Invalidate both images, so load falls back to one element per read
+     */
+    g_host_eeprom.data[PARAM_IMAGE_ADD_A] ^= 0xFF;
+    g_host_eeprom.data[PARAM_IMAGE_ADD_B] ^= 0xFF;
+    start();
+    load_param_bank();
+    print_row("load per element", bus_us());
+
+    post_save_param_bank();
+    while(eeprom_queue_busy())
+    {
+        process_eeprom_queue();
+    }
+
+    start();
+    load_param_bank();
+    print_row("load image", bus_us());
+
+    return 0;
+}
@@ -0,0 +1,713 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_analysis.c
+ * @brief Analysis of DSP pipelines.
+ *
+ * Each stage is modelled by a transfer function of up to 3rd order:
+ *
+ *               b0 + b1*z^-1 + b2*z^-2 + b3*z^-3
+ *      H(z) = ----------------------------------
+ *                1 + a1*z^-1 + a2*z^-2 + a3*z^-3
+ *
+ * Transfer function of the pipeline is the product of all stages. Roots of
+ * numerator and denominator polynomials are found with Durand-Kerner method.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "dsp_analysis.h"
+
+#define PI                  3.141592653589793
+#define MAX_STAGE_ORDER     3
+#define ROOTS_MAX_ITER      500
+#define ROOTS_TOLERANCE     1e-14
+
+typedef struct
+{
+    uint16_t    order;
+    double      num[MAX_STAGE_ORDER + 1];
+    double      den[MAX_STAGE_ORDER + 1];
+} stage_tf_t;
+
+/**
+ * Working copy of a stage, used for step response simulation
+ */
+typedef union
+{
+    dsp_error_t         error;
+    dsp_srlim_t         srlim;
+    dsp_lpf_t           lpf;
+    dsp_pi_t            pi;
+    dsp_iir_2p2z_t      iir_2p2z;
+    dsp_iir_3p3z_t      iir_3p3z;
+    dsp_vdclink_ff_t    ff;
+} stage_copy_t;
+
+static dsp_complex_t c_mul(dsp_complex_t x, dsp_complex_t y)
+{
+    dsp_complex_t r;
+
+    r.re = x.re*y.re - x.im*y.im;
+    r.im = x.re*y.im + x.im*y.re;
+    return r;
+}
+
+static dsp_complex_t c_div(dsp_complex_t x, dsp_complex_t y)
+{
+    dsp_complex_t r;
+    double den = y.re*y.re + y.im*y.im;
+
+    if(den == 0.0)
+    {
+        r.re = INFINITY;
+        r.im = 0.0;
+    }
+    else
+    {
+        r.re = (x.re*y.re + x.im*y.im) / den;
+        r.im = (x.im*y.re - x.re*y.im) / den;
+    }
+    return r;
+}
+
+static double c_abs(dsp_complex_t x)
+{
+    return sqrt(x.re*x.re + x.im*x.im);
+}
+
+/**
+ * Get linear model of pipeline stage.
+ *
+ * @param p_stage
+ * @param p_tf
+ */
+static void get_stage_tf(dsp_pipeline_stage_t *p_stage, stage_tf_t *p_tf)
+{
+    memset(p_tf, 0, sizeof(stage_tf_t));
+    p_tf->num[0] = 1.0;
+    p_tf->den[0] = 1.0;
+
+    switch(p_stage->dsp_class)
+    {
+        case DSP_LPF:
+        {
+            dsp_lpf_t *p_lpf = (dsp_lpf_t *) p_stage->p_module;
+
+            p_tf->order = 1;
+            p_tf->num[0] = p_lpf->k;
+            p_tf->num[1] = p_lpf->k;
+            p_tf->den[1] = -p_lpf->a;
+            break;
+        }
+
+        case DSP_PI:
+        {
+            dsp_pi_t *p_pi = (dsp_pi_t *) p_stage->p_module;
+
+            p_tf->order = 1;
+            p_tf->num[0] = (double) p_pi->coeffs.s.kp + p_pi->coeffs.s.ki;
+            p_tf->num[1] = -p_pi->coeffs.s.kp;
+            p_tf->den[1] = -1.0;
+            break;
+        }
+
+        case DSP_IIR_2P2Z:
+        {
+            dsp_iir_2p2z_t *p_iir = (dsp_iir_2p2z_t *) p_stage->p_module;
+
+            p_tf->order = 2;
+            p_tf->num[0] = p_iir->coeffs.s.b0;
+            p_tf->num[1] = p_iir->coeffs.s.b1;
+            p_tf->num[2] = p_iir->coeffs.s.b2;
+            p_tf->den[1] = p_iir->coeffs.s.a1;
+            p_tf->den[2] = p_iir->coeffs.s.a2;
+            break;
+        }
+
+        case DSP_IIR_3P3Z:
+        {
+            dsp_iir_3p3z_t *p_iir = (dsp_iir_3p3z_t *) p_stage->p_module;
+
+            p_tf->order = 3;
+            p_tf->num[0] = p_iir->coeffs.s.b0;
+            p_tf->num[1] = p_iir->coeffs.s.b1;
+            p_tf->num[2] = p_iir->coeffs.s.b2;
+            p_tf->num[3] = p_iir->coeffs.s.b3;
+            p_tf->den[1] = p_iir->coeffs.s.a1;
+            p_tf->den[2] = p_iir->coeffs.s.a2;
+            p_tf->den[3] = p_iir->coeffs.s.a3;
+            break;
+        }
+
+        case DSP_VdcLink_FeedForward:
+        {
+            dsp_vdclink_ff_t *p_ff = (dsp_vdclink_ff_t *) p_stage->p_module;
+
+            /**
+             * Gain around current DC-link voltage measurement. A non-positive
+             * measurement has no meaningful gain, even when vdc_min allows
+             * it, so it's taken as unity gain like below vdc_min.
+             */
+            if( (*(p_ff->vdc_meas) > 0.0) &&
+                !(*(p_ff->vdc_meas) < p_ff->coeffs.s.vdc_min) )
+            {
+                p_tf->num[0] = p_ff->coeffs.s.vdc_nom / *(p_ff->vdc_meas);
+            }
+            break;
+        }
+
+        /**
+         * Error (from positive input) and SRLim (small signals) have unity gain
+         */
+        default:
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * Evaluate polynomial on powers of z^-1.
+ *
+ * @param p_coeffs
+ * @param order
+ * @param z_inv
+ * @return Polynomial value
+ */
+static dsp_complex_t eval_poly(const double *p_coeffs, uint16_t order,
+                               dsp_complex_t z_inv)
+{
+    int16_t i;
+    dsp_complex_t acc;
+
+    /**
+     * Horner scheme from highest power
+     */
+    acc.re = p_coeffs[order];
+    acc.im = 0.0;
+
+    for(i = order - 1; i >= 0; i--)
+    {
+        acc = c_mul(acc, z_inv);
+        acc.re += p_coeffs[i];
+    }
+
+    return acc;
+}
+
+/**
+ * Find roots of polynomial p[0]*z^n + p[1]*z^(n-1) + ... + p[n], which is
+ * the polynomial of a stage multiplied by z^n. Leading null coefficients
+ * are discarded, as they correspond to roots at infinity.
+ *
+ * @param p_coeffs
+ * @param order
+ * @param p_roots
+ * @return Number of roots found
+ */
+static uint16_t find_poly_roots(const double *p_coeffs, uint16_t order,
+                                dsp_complex_t *p_roots)
+{
+    uint16_t i, j, k, n;
+    double monic[MAX_STAGE_ORDER + 1];
+    double max_delta;
+    dsp_complex_t seed, num, den, diff, delta;
+
+    while(order && (p_coeffs[0] == 0.0))
+    {
+        p_coeffs++;
+        order--;
+    }
+
+    n = order;
+
+    if(n == 0)
+    {
+        return 0;
+    }
+
+    for(i = 0; i <= n; i++)
+    {
+        monic[i] = p_coeffs[i] / p_coeffs[0];
+    }
+
+    seed.re = 0.4;
+    seed.im = 0.9;
+
+    for(i = 0; i < n; i++)
+    {
+        p_roots[i] = (i == 0) ? seed : c_mul(p_roots[i-1], seed);
+    }
+
+    for(k = 0; k < ROOTS_MAX_ITER; k++)
+    {
+        max_delta = 0.0;
+
+        for(i = 0; i < n; i++)
+        {
+            /**
+             * Evaluate monic polynomial at current root estimate
+             */
+            num.re = monic[0];
+            num.im = 0.0;
+            for(j = 1; j <= n; j++)
+            {
+                num = c_mul(num, p_roots[i]);
+                num.re += monic[j];
+            }
+
+            den.re = 1.0;
+            den.im = 0.0;
+            for(j = 0; j < n; j++)
+            {
+                if(j != i)
+                {
+                    diff.re = p_roots[i].re - p_roots[j].re;
+                    diff.im = p_roots[i].im - p_roots[j].im;
+                    den = c_mul(den, diff);
+                }
+            }
+
+            delta = c_div(num, den);
+
+            if(isfinite(delta.re) && isfinite(delta.im))
+            {
+                p_roots[i].re -= delta.re;
+                p_roots[i].im -= delta.im;
+
+                if(c_abs(delta) > max_delta)
+                {
+                    max_delta = c_abs(delta);
+                }
+            }
+        }
+
+        if(max_delta < ROOTS_TOLERANCE)
+        {
+            break;
+        }
+    }
+
+    return n;
+}
+
+/**
+ * Calculate frequency response of pipeline.
+ *
+ * @param p_pipeline
+ * @param freq [Hz]
+ * @param freq_sampling [Hz]
+ * @return Complex value of transfer function
+ */
+dsp_complex_t calc_dsp_pipeline_tf(dsp_pipeline_t *p_pipeline, float freq,
+                                   float freq_sampling)
+{
+    uint16_t i;
+    double w;
+    stage_tf_t tf;
+    dsp_complex_t h, z_inv;
+
+    w = 2.0 * PI * freq / freq_sampling;
+    z_inv.re = cos(w);
+    z_inv.im = -sin(w);
+
+    h.re = 1.0;
+    h.im = 0.0;
+
+    for(i = 0; i < p_pipeline->num_stages; i++)
+    {
+        get_stage_tf(&p_pipeline->stages[i], &tf);
+        h = c_mul(h, c_div(eval_poly(tf.num, tf.order, z_inv),
+                           eval_poly(tf.den, tf.order, z_inv)));
+    }
+
+    return h;
+}
+
+/**
+ * Calculate Bode diagram of pipeline. Phase is unwrapped along frequency
+ * points, which must be in ascending order.
+ *
+ * @param p_pipeline
+ * @param freq_sampling [Hz]
+ * @param p_freq Array of frequencies [Hz]
+ * @param num_freqs
+ * @param p_mag_db Array of magnitudes [dB]
+ * @param p_phase_deg Array of phases [deg]
+ */
+void calc_dsp_pipeline_bode(dsp_pipeline_t *p_pipeline, float freq_sampling,
+                            const float *p_freq, uint16_t num_freqs,
+                            float *p_mag_db, float *p_phase_deg)
+{
+    uint16_t i;
+    double phase, phase_old;
+    dsp_complex_t h;
+
+    phase_old = 0.0;
+
+    for(i = 0; i < num_freqs; i++)
+    {
+        h = calc_dsp_pipeline_tf(p_pipeline, p_freq[i], freq_sampling);
+
+        phase = atan2(h.im, h.re) * 180.0 / PI;
+
+        if(i > 0)
+        {
+            while(phase - phase_old > 180.0)
+            {
+                phase -= 360.0;
+            }
+            while(phase - phase_old < -180.0)
+            {
+                phase += 360.0;
+            }
+        }
+
+        p_mag_db[i] = 20.0 * log10(c_abs(h));
+        p_phase_deg[i] = phase;
+        phase_old = phase;
+    }
+}
+
+/**
+ * Calculate poles and zeros of pipeline, on z-plane.
+ *
+ * @param p_pipeline
+ * @param p_pz_map
+ */
+void calc_dsp_pipeline_pz_map(dsp_pipeline_t *p_pipeline,
+                              dsp_pz_map_t *p_pz_map)
+{
+    uint16_t i;
+    stage_tf_t tf;
+
+    p_pz_map->num_poles = 0;
+    p_pz_map->num_zeros = 0;
+
+    for(i = 0; i < p_pipeline->num_stages; i++)
+    {
+        get_stage_tf(&p_pipeline->stages[i], &tf);
+
+        p_pz_map->num_zeros +=
+            find_poly_roots(tf.num, tf.order,
+                            &p_pz_map->zeros[p_pz_map->num_zeros]);
+        p_pz_map->num_poles +=
+            find_poly_roots(tf.den, tf.order,
+                            &p_pz_map->poles[p_pz_map->num_poles]);
+    }
+}
+
+/**
+ * Calculate gain and phase margins of pipeline, taken as open-loop transfer
+ * function. Crossover frequencies are searched over DSP_ANALYSIS_NUM_FREQS
+ * log-spaced points and linearly interpolated.
+ *
+ * @param p_pipeline
+ * @param freq_sampling [Hz]
+ * @param p_margins
+ */
+void calc_dsp_pipeline_margins(dsp_pipeline_t *p_pipeline,
+                               float freq_sampling, dsp_margins_t *p_margins)
+{
+    uint16_t i;
+    double ratio, freq, freq_old, mag, mag_old, x, margin;
+    dsp_complex_t h, h_old;
+    dsp_pz_map_t pz_map;
+
+    p_margins->gain_margin_db = INFINITY;
+    p_margins->phase_margin_deg = INFINITY;
+    p_margins->freq_gain_cross = 0.0;
+    p_margins->freq_phase_cross = 0.0;
+
+    ratio = pow(0.5 / DSP_ANALYSIS_FREQ_MIN_RATIO,
+                1.0 / (DSP_ANALYSIS_NUM_FREQS - 1));
+
+    freq = freq_sampling * DSP_ANALYSIS_FREQ_MIN_RATIO;
+    h = calc_dsp_pipeline_tf(p_pipeline, freq, freq_sampling);
+    mag = c_abs(h);
+
+    for(i = 1; i < DSP_ANALYSIS_NUM_FREQS; i++)
+    {
+        freq_old = freq;
+        h_old = h;
+        mag_old = mag;
+
+        freq = freq_old * ratio;
+        h = calc_dsp_pipeline_tf(p_pipeline, freq, freq_sampling);
+        mag = c_abs(h);
+
+        /**
+         * Gain crossover: magnitude crosses 1
+         */
+        if( (mag_old - 1.0) * (mag - 1.0) <= 0.0 && (mag_old != mag) )
+        {
+            x = (1.0 - mag_old) / (mag - mag_old);
+            margin = 180.0 + atan2(h_old.im + x*(h.im - h_old.im),
+                                   h_old.re + x*(h.re - h_old.re)) * 180.0 / PI;
+            if(margin > 180.0)
+            {
+                margin -= 360.0;
+            }
+
+            if(margin < p_margins->phase_margin_deg)
+            {
+                p_margins->phase_margin_deg = margin;
+                p_margins->freq_gain_cross = freq_old * pow(ratio, x);
+            }
+        }
+
+        /**
+         * Phase crossover: response crosses negative real axis
+         */
+        if( (h_old.im * h.im <= 0.0) && (h_old.im != h.im) )
+        {
+            x = h_old.im / (h_old.im - h.im);
+
+            if( (h_old.re + x*(h.re - h_old.re)) < 0.0 )
+            {
+                margin = -20.0 * log10(mag_old + x*(mag - mag_old));
+
+                if(margin < p_margins->gain_margin_db)
+                {
+                    p_margins->gain_margin_db = margin;
+                    p_margins->freq_phase_cross = freq_old * pow(ratio, x);
+                }
+            }
+        }
+    }
+
+    calc_dsp_pipeline_pz_map(p_pipeline, &pz_map);
+
+    p_margins->stable = true;
+    for(i = 0; i < pz_map.num_poles; i++)
+    {
+        if(c_abs(pz_map.poles[i]) >= 1.0)
+        {
+            p_margins->stable = false;
+        }
+    }
+}
+
+/**
+ * Simulate step response of pipeline, from null initial states. Stages are
+ * copied and wired to local signals, and then run with their respective
+ * run_dsp_* functions, so saturations and slew-rate limits are included.
+ * Error stages have null negative input, and VdcLink feed-forward stages keep
+ * current DC-link voltage measurement.
+ *
+ * @param p_pipeline
+ * @param amplitude
+ * @param p_out Array of output samples
+ * @param num_samples
+ * @return Number of simulated samples
+ */
+uint16_t calc_dsp_pipeline_step(dsp_pipeline_t *p_pipeline, float amplitude,
+                                float *p_out, uint16_t num_samples)
+{
+    uint16_t i, n;
+    volatile float signals[DSP_PIPELINE_MAX_STAGES + 1];
+    volatile float vdc_meas[DSP_PIPELINE_MAX_STAGES];
+    volatile float zero;
+    stage_copy_t stages[DSP_PIPELINE_MAX_STAGES];
+    dsp_pipeline_stage_t *p_stage;
+
+    zero = 0.0;
+
+    for(i = 0; i < p_pipeline->num_stages; i++)
+    {
+        p_stage = &p_pipeline->stages[i];
+
+        switch(p_stage->dsp_class)
+        {
+            case DSP_Error:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_error_t));
+                stages[i].error.pos = &signals[i];
+                stages[i].error.neg = &zero;
+                stages[i].error.error = &signals[i+1];
+                reset_dsp_error(&stages[i].error);
+                break;
+            }
+
+            case DSP_SRLim:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_srlim_t));
+                stages[i].srlim.in = &signals[i];
+                stages[i].srlim.out = &signals[i+1];
+                reset_dsp_srlim(&stages[i].srlim);
+                break;
+            }
+
+            case DSP_LPF:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_lpf_t));
+                stages[i].lpf.in = &signals[i];
+                stages[i].lpf.out = &signals[i+1];
+                reset_dsp_lpf(&stages[i].lpf);
+                break;
+            }
+
+            case DSP_PI:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_pi_t));
+                stages[i].pi.in = &signals[i];
+                stages[i].pi.out = &signals[i+1];
+                reset_dsp_pi(&stages[i].pi);
+                break;
+            }
+
+            case DSP_IIR_2P2Z:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_iir_2p2z_t));
+                stages[i].iir_2p2z.in = &signals[i];
+                stages[i].iir_2p2z.out = &signals[i+1];
+                reset_dsp_iir_2p2z(&stages[i].iir_2p2z);
+                break;
+            }
+
+            case DSP_IIR_3P3Z:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_iir_3p3z_t));
+                stages[i].iir_3p3z.in = &signals[i];
+                stages[i].iir_3p3z.out = &signals[i+1];
+                reset_dsp_iir_3p3z(&stages[i].iir_3p3z);
+                break;
+            }
+
+            case DSP_VdcLink_FeedForward:
+            {
+                memcpy(&stages[i], (void *) p_stage->p_module,
+                       sizeof(dsp_vdclink_ff_t));
+                vdc_meas[i] = *(stages[i].ff.vdc_meas);
+                stages[i].ff.vdc_meas = &vdc_meas[i];
+                stages[i].ff.in = &signals[i];
+                stages[i].ff.out = &signals[i+1];
+                signals[i] = 0.0;
+                reset_dsp_vdclink_ff(&stages[i].ff);
+                break;
+            }
+
+            default:
+            {
+                return 0;
+            }
+        }
+    }
+
+    for(n = 0; n < num_samples; n++)
+    {
+        signals[0] = amplitude;
+
+        for(i = 0; i < p_pipeline->num_stages; i++)
+        {
+            switch(p_pipeline->stages[i].dsp_class)
+            {
+                case DSP_Error:
+                {
+                    run_dsp_error(&stages[i].error);
+                    break;
+                }
+
+                case DSP_SRLim:
+                {
+                    run_dsp_srlim(&stages[i].srlim, stages[i].srlim.bypass);
+                    break;
+                }
+
+                case DSP_LPF:
+                {
+                    run_dsp_lpf(&stages[i].lpf);
+                    break;
+                }
+
+                case DSP_PI:
+                {
+                    run_dsp_pi(&stages[i].pi);
+                    break;
+                }
+
+                case DSP_IIR_2P2Z:
+                {
+                    run_dsp_iir_2p2z(&stages[i].iir_2p2z);
+                    break;
+                }
+
+                case DSP_IIR_3P3Z:
+                {
+                    run_dsp_iir_3p3z(&stages[i].iir_3p3z);
+                    break;
+                }
+
+                case DSP_VdcLink_FeedForward:
+                {
+                    run_dsp_vdclink_ff(&stages[i].ff);
+                    break;
+                }
+
+                default:
+                {
+                    break;
+                }
+            }
+        }
+
+        p_out[n] = signals[p_pipeline->num_stages];
+    }
+
+    return num_samples;
+}
+
+/**
+ * Analyze several candidate pipelines. Each analysis is independent, so
+ * they're distributed among threads when built with OpenMP.
+ *
+ * @param p_analysis Array of analyses
+ * @param num Number of analyses
+ */
+void run_dsp_analysis_batch(dsp_analysis_t *p_analysis, uint16_t num)
+{
+    int32_t i;
+
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic)
+#endif
+    for(i = 0; i < num; i++)
+    {
+        calc_dsp_pipeline_margins(p_analysis[i].p_pipeline,
+                                  p_analysis[i].freq_sampling,
+                                  &p_analysis[i].margins);
+
+        calc_dsp_pipeline_pz_map(p_analysis[i].p_pipeline,
+                                 &p_analysis[i].pz_map);
+
+        if(p_analysis[i].p_step)
+        {
+            calc_dsp_pipeline_step(p_analysis[i].p_pipeline,
+                                   p_analysis[i].step_amplitude,
+                                   p_analysis[i].p_step,
+                                   p_analysis[i].num_step_samples);
+        }
+    }
+}
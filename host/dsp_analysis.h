@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file dsp_analysis.h
+ * @brief Analysis of DSP pipelines.
+ *
+ * Offline analysis of chains of DSP modules, described as dsp_pipeline_t,
+ * for screening of controller tunings on a workstation before sending them
+ * with ```bsmp_set_dsp_coeffs```. It computes frequency response, pole-zero
+ * map, stability margins and step response of a pipeline.
+ *
+ * Frequency response, poles and zeros are calculated from the linear model of
+ * each module, ignoring saturations and slew-rate limits. Step response is
+ * simulated with run_dsp_* functions, over copies of the modules, so the
+ * pipeline itself is never modified. Stability margins assume pipeline is the
+ * open-loop transfer function, so a model of the plant may be appended to it
+ * as an IIR stage.
+ *
+ * All functions are reentrant, and ```run_dsp_analysis_batch()``` analyzes
+ * several candidate pipelines in parallel when built with OpenMP.
+ *
+ * This module isn't part of ARM firmware. It's built for the workstation by
+ * host/Makefile, together with the DSP modules it analyzes.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef DSP_ANALYSIS_H_
+#define DSP_ANALYSIS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "dsp_pipeline.h"
+
+#define DSP_ANALYSIS_MAX_ORDER      (3*DSP_PIPELINE_MAX_STAGES)
+
+/**
+ * Log-spaced frequency points used to search for crossover frequencies,
+ * from DSP_ANALYSIS_FREQ_MIN_RATIO*freq_sampling up to Nyquist frequency
+ */
+#define DSP_ANALYSIS_NUM_FREQS      2000
+#define DSP_ANALYSIS_FREQ_MIN_RATIO 1e-6
+
+typedef struct
+{
+    double  re;
+    double  im;
+} dsp_complex_t;
+
+typedef struct
+{
+    uint16_t        num_poles;
+    uint16_t        num_zeros;
+    dsp_complex_t   poles[DSP_ANALYSIS_MAX_ORDER];
+    dsp_complex_t   zeros[DSP_ANALYSIS_MAX_ORDER];
+} dsp_pz_map_t;
+
+/**
+ * Margins are the worst ones among all crossover frequencies. When there's no
+ * crossover, respective margin and frequency are set to INFINITY and 0.
+ * ```stable``` means all poles are strictly inside unit circle, which isn't
+ * true for a PI alone, due to its integrator.
+ */
+typedef struct
+{
+    float   gain_margin_db;
+    float   phase_margin_deg;
+    float   freq_gain_cross;
+    float   freq_phase_cross;
+    bool    stable;
+} dsp_margins_t;
+
+/**
+ * Analysis of a candidate pipeline, used by ```run_dsp_analysis_batch()```.
+ * Step response is only simulated if ```p_step``` isn't null.
+ */
+typedef struct
+{
+    dsp_pipeline_t  *p_pipeline;
+    float           freq_sampling;
+    float           step_amplitude;
+    uint16_t        num_step_samples;
+    float           *p_step;
+    dsp_margins_t   margins;
+    dsp_pz_map_t    pz_map;
+} dsp_analysis_t;
+
+extern dsp_complex_t calc_dsp_pipeline_tf(dsp_pipeline_t *p_pipeline,
+                                          float freq, float freq_sampling);
+extern void calc_dsp_pipeline_bode(dsp_pipeline_t *p_pipeline,
+                                   float freq_sampling, const float *p_freq,
+                                   uint16_t num_freqs, float *p_mag_db,
+                                   float *p_phase_deg);
+extern void calc_dsp_pipeline_pz_map(dsp_pipeline_t *p_pipeline,
+                                     dsp_pz_map_t *p_pz_map);
+extern void calc_dsp_pipeline_margins(dsp_pipeline_t *p_pipeline,
+                                      float freq_sampling,
+                                      dsp_margins_t *p_margins);
+extern uint16_t calc_dsp_pipeline_step(dsp_pipeline_t *p_pipeline,
+                                       float amplitude, float *p_out,
+                                       uint16_t num_samples);
+extern void run_dsp_analysis_batch(dsp_analysis_t *p_analysis, uint16_t num);
+
+#endif /* DSP_ANALYSIS_H_ */
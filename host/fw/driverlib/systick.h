@@ -0,0 +1,26 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file systick.h
+ * @brief SysTick driver.
+ *
+ * Host stand-in for the header of the same name from TI controlSUITE, with
+ * only what firmware sources built by host/Makefile need.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef __SYSTICK_H__
+#define __SYSTICK_H__
+
+#endif /* __SYSTICK_H__ */
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file fw_host.c
+ * @brief Host stand-ins for hardware seams of ARM firmware.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/sysctl.h"
+
+#include "board_drivers/hardware_def.h"
+#include "communication_drivers/i2c_onboard/eeprom.h"
+#include "communication_drivers/i2c_onboard/exio.h"
+#include "communication_drivers/i2c_onboard/i2c_onboard.h"
+#include "communication_drivers/ipc/ipc_lib.h"
+#include "communication_drivers/psmodules/fbp_dclink/fbp_dclink.h"
+#include "communication_drivers/rs485/rs485.h"
+#include "communication_drivers/system_task/system_task.h"
+#include "communication_drivers/timer/timer.h"
+
+#include "fw_host.h"
+
+host_eeprom_t g_host_eeprom;
+host_i2c_stats_t g_host_i2c_stats;
+
+/**
+ * Tasks set by ```TaskSetNew()```, one bit per task, IPC messages sent to C28
+ * and M3 cycles spent on ```SysCtlDelay()```
+ */
+uint32_t g_host_tasks;
+uint32_t g_host_ipc_msgs;
+uint64_t g_host_delay_cycles;
+
+static uint64_t cycle_counter_offset;
+static bool int_master_disabled;
+static float digital_potentiometer;
+
+/**
+ * Reset models to power-up state: EEPROM is erased (0xFF), write protected
+ * and healthy, and all counters are cleared
+ */
+void host_fw_reset(void)
+{
+    memset(g_host_eeprom.data, 0xFF, HOST_EEPROM_SIZE);
+    g_host_eeprom.wp = 1;
+    g_host_eeprom.writes_left = -1;
+    g_host_eeprom.stuck = 0;
+
+    memset(&g_host_i2c_stats, 0, sizeof(g_host_i2c_stats));
+    g_host_tasks = 0;
+    g_host_ipc_msgs = 0;
+    g_host_delay_cycles = 0;
+}
+
+/**
+ * Advance cycle counter, so timeouts expire without waiting for them
+ */
+void host_advance_us(uint32_t us)
+{
+    cycle_counter_offset += (uint64_t) us * CYCLES_PER_US;
+}
+
+/**
+ * Estimate time spent on EEPROM by I2C transactions and write cycles. Each
+ * byte takes 9 bits on bus: reads send slave address twice and EEPROM address
+ * once, writes send slave address and EEPROM address once.
+ */
+double host_i2c_time_us(const host_i2c_stats_t *p_stats)
+{
+    double bits;
+
+    bits = 9.0 * ( 4.0 * p_stats->reads + p_stats->bytes_read +
+                   3.0 * p_stats->writes + p_stats->bytes_written +
+                   2.0 * p_stats->ack_polls );
+
+    return (1e6 * bits / HOST_I2C_BIT_RATE) +
+           ((double) p_stats->writes * HOST_EEPROM_TWR_US);
+}
+
+/******************************************************************************
+ *                                  i2c_onboard
+ *****************************************************************************/
+
+void init_i2c_onboard(void)
+{
+}
+
+/**
+ * Only EEPROM is modeled: sequential read with double address, which wraps
+ * around end of memory
+ */
+void read_i2c(uint8_t SLAVE_ADDR, uint8_t TYPE_REGISTER_ADDR,
+              uint16_t MESSAGE_SIZE, uint8_t *data)
+{
+    uint16_t add;
+    uint16_t i;
+
+    g_host_i2c_stats.reads++;
+    g_host_i2c_stats.bytes_read += MESSAGE_SIZE;
+
+    if( (SLAVE_ADDR != I2C_SLV_ADDR_EEPROM) ||
+        (TYPE_REGISTER_ADDR != DOUBLE_ADDRESS) )
+    {
+        memset(data, 0, MESSAGE_SIZE);
+        return;
+    }
+
+    add = ((uint16_t) data[0] << 8) | data[1];
+
+    for(i = 0; i < MESSAGE_SIZE; i++)
+    {
+        data[i] = g_host_eeprom.data[(add + i) % HOST_EEPROM_SIZE];
+    }
+}
+
+/**
+ * Page write into EEPROM, which rolls over within the page as the real
+ * device does. Writes are ignored while write protected or after a power
+ * loss.
+ */
+void write_i2c(uint8_t SLAVE_ADDR, uint8_t MESSAGE_SIZE, uint8_t *data)
+{
+    uint16_t add, page;
+    uint16_t i;
+
+    if(SLAVE_ADDR != I2C_SLV_ADDR_EEPROM)
+    {
+        return;
+    }
+
+    g_host_i2c_stats.writes++;
+    g_host_i2c_stats.bytes_written += MESSAGE_SIZE - 2;
+
+    if(g_host_eeprom.wp || !g_host_eeprom.writes_left)
+    {
+        return;
+    }
+
+    if(g_host_eeprom.writes_left > 0)
+    {
+        g_host_eeprom.writes_left--;
+    }
+
+    add = (((uint16_t) data[0] << 8) | data[1]) % HOST_EEPROM_SIZE;
+    page = add - (add % EEPROM_PAGE_SIZE);
+
+    for(i = 2; i < MESSAGE_SIZE; i++)
+    {
+        g_host_eeprom.data[page + (add % EEPROM_PAGE_SIZE)] = data[i];
+        add++;
+    }
+}
+
+uint8_t ack_poll_i2c(uint8_t SLAVE_ADDR)
+{
+    g_host_i2c_stats.ack_polls++;
+
+    return (SLAVE_ADDR == I2C_SLV_ADDR_EEPROM) && !g_host_eeprom.stuck;
+}
+
+/******************************************************************************
+ *                                    timer
+ *****************************************************************************/
+
+void init_cycle_counter(void)
+{
+}
+
+uint32_t get_cycle_counter(void)
+{
+    struct timespec ts;
+    uint64_t ns;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ns = (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+    return (uint32_t) (ns * CYCLES_PER_US / 1000 + cycle_counter_offset);
+}
+
+/******************************************************************************
+ *                                   ipc_lib
+ *****************************************************************************/
+
+volatile u_float_t g_wfmref[SIZE_WFMREF];
+volatile u_float_t g_buf_samples_ctom[SIZE_BUF_SAMPLES_CTOM];
+volatile u_float_t g_buf_samples_mtoc[SIZE_BUF_SAMPLES_MTOC];
+
+volatile u_float_t g_buf_samples_readout_data[SIZE_BUF_SAMPLES_CTOM];
+buf_readout_t g_buf_samples_readout;
+
+volatile ipc_ctom_t g_ipc_ctom;
+volatile ipc_mtoc_t g_ipc_mtoc;
+
+void send_ipc_msg(uint16_t msg_id, uint32_t flag)
+{
+    g_ipc_mtoc.msg_id = msg_id;
+    g_host_ipc_msgs++;
+}
+
+void send_ipc_lowpriority_msg(uint16_t msg_id, ipc_mtoc_lowpriority_msg_t msg)
+{
+    send_ipc_msg(msg_id, low_priority_msg_to_reg(msg));
+}
+
+uint32_t low_priority_msg_to_reg(ipc_mtoc_lowpriority_msg_t msg)
+{
+    return ((msg << 4) | IPC_MTOC_LOWPRIORITY_MSG) & 0x0000FFFF;
+}
+
+/**
+ * Host addresses don't fit C28 address space, so they're kept as they are
+ */
+uint32_t ipc_mtoc_translate(uint32_t shared_add)
+{
+    return shared_add;
+}
+
+uint32_t ipc_ctom_translate(uint32_t shared_add)
+{
+    return shared_add;
+}
+
+uint16_t ipc_mtoc_busy(uint32_t ulFlags)
+{
+    return 0;
+}
+
+void enable_buf_samples_stream(uint16_t ps_id)
+{
+}
+
+void disable_buf_samples_stream(void)
+{
+}
+
+/******************************************************************************
+ *                        system_task, exio, rs485, fbp_dclink
+ *****************************************************************************/
+
+void TaskSetNew(uint8_t TaskNum)
+{
+    g_host_tasks |= (1UL << TaskNum);
+}
+
+void rs485_term_ctrl(uint8_t sts)
+{
+}
+
+volatile uint8_t g_current_ps_id;
+
+void set_digital_potentiometer(float perc)
+{
+    digital_potentiometer = perc;
+}
+
+float get_digital_potentiometer(void)
+{
+    return digital_potentiometer;
+}
+
+/******************************************************************************
+ *                                  driverlib
+ *****************************************************************************/
+
+void GPIOPinWrite(unsigned long ulPort, unsigned char ucPins,
+                  unsigned char ucVal)
+{
+    if( (ulPort == EEPROM_WP_BASE) && (ucPins & EEPROM_WP_PIN) )
+    {
+        g_host_eeprom.wp = (ucVal & EEPROM_WP_PIN) ? 1 : 0;
+    }
+}
+
+bool IntMasterDisable(void)
+{
+    bool was_disabled = int_master_disabled;
+
+    int_master_disabled = true;
+    return was_disabled;
+}
+
+bool IntMasterEnable(void)
+{
+    bool was_disabled = int_master_disabled;
+
+    int_master_disabled = false;
+    return was_disabled;
+}
+
+/**
+ * Each loop of SysCtlDelay takes 3 cycles
+ */
+void SysCtlDelay(unsigned long ulCount)
+{
+    g_host_delay_cycles += 3 * (uint64_t) ulCount;
+}
+
+void SysCtlReset(void)
+{
+}
+
+void SysCtlHoldSubSystemInReset(unsigned long ulSubSystems)
+{
+}
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file fw_host.h
+ * @brief Host stand-ins for hardware seams of ARM firmware.
+ *
+ * Firmware sources built by host/Makefile reach hardware only through a few
+ * modules, which are replaced here:
+ *
+ *  - ```i2c_onboard```: I2C transactions go to a model of the onboard EEPROM,
+ *    which counts transactions and write cycles, honors write protection and
+ *    page roll-over, and may drop writes to emulate a power loss or refuse
+ *    ACK polls to emulate a write cycle which never completes.
+ *  - ```timer```: cycle counter runs from the monotonic clock at the M3 clock
+ *    rate, plus an offset which tests may advance.
+ *  - ```ipc_lib```: shared RAM and message RAM are ordinary variables, and
+ *    C28 acknowledges messages as soon as they're sent.
+ *  - ```system_task```, ```exio```, ```rs485```, ```fbp_dclink``` and the few
+ *    driverlib calls left: just enough to link.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef FW_HOST_H_
+#define FW_HOST_H_
+
+#include <stdint.h>
+
+#define HOST_EEPROM_SIZE        0x2000
+
+/**
+ * EEPROM write cycle (tWR) and I2C bit rate of onboard bus, used to estimate
+ * time spent on EEPROM from transaction counts
+ */
+#define HOST_EEPROM_TWR_US      5000
+#define HOST_I2C_BIT_RATE       400000
+
+typedef struct
+{
+    uint32_t    reads;          // Read transactions
+    uint32_t    writes;         // Write transactions, each one a write cycle
+    uint32_t    bytes_read;     // Data bytes read
+    uint32_t    bytes_written;  // Data bytes written, without address
+    uint32_t    ack_polls;      // ACK polls of write cycle completion
+} host_i2c_stats_t;
+
+typedef struct
+{
+    uint8_t     data[HOST_EEPROM_SIZE];
+    uint8_t     wp;             // Write protection pin
+    int32_t     writes_left;    // Writes stored before power loss, < 0 for no limit
+    uint8_t     stuck;          // ACK polls fail, so write cycles time out
+} host_eeprom_t;
+
+extern host_eeprom_t g_host_eeprom;
+extern host_i2c_stats_t g_host_i2c_stats;
+extern uint32_t g_host_tasks;
+extern uint32_t g_host_ipc_msgs;
+extern uint64_t g_host_delay_cycles;
+
+extern void host_fw_reset(void);
+extern void host_advance_us(uint32_t us);
+extern double host_i2c_time_us(const host_i2c_stats_t *p_stats);
+
+#endif /* FW_HOST_H_ */
@@ -0,0 +1,34 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file hw_memmap.h
+ * @brief Peripheral base addresses.
+ *
+ * Host stand-in for the header of the same name from TI controlSUITE, with
+ * only what firmware sources built by host/Makefile need.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+/**
+ * Base addresses only identify ports on host
+ */
+#define GPIO_PORTG_BASE         0x4003E000
+#define GPIO_PORTN_BASE         0x40064000
+#define GPIO_PORTP_BASE         0x40065000
+#define GPIO_PORTR_BASE         0x40067000
+
+#endif /* __HW_MEMMAP_H__ */
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test.h
+ * @brief Helpers for host tests.
+ *
+ * Each test is a program which prints failed checks and returns the number
+ * of failures, so ```make test``` stops on the first failing program.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#ifndef TEST_H_
+#define TEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+
+static uint32_t test_num_checks;
+static uint32_t test_num_failures;
+
+#define CHECK(cond, ...)                                                    \
+    do                                                                      \
+    {                                                                       \
+        test_num_checks++;                                                  \
+        if(!(cond))                                                         \
+        {                                                                   \
+            test_num_failures++;                                            \
+            printf("%s:%d: ", __FILE__, __LINE__);                          \
+            printf(__VA_ARGS__);                                            \
+            printf("\n");                                                   \
+        }                                                                   \
+    } while(0)
+
+/**
+ * Report results and return value of test program.
+ */
+static inline int test_result(const char *name)
+{
+    printf("%s: %u checks, %u failures\n", name, test_num_checks,
+           test_num_failures);
+    return (test_num_failures > 0);
+}
+
+/**
+ * Deterministic test signal: sum of a sine with a different frequency for
+ * each channel and a pseudo-random noise, with amplitude large enough to
+ * saturate modules limited to +/- 1.
+ */
+static inline float test_signal(uint32_t n, uint16_t channel)
+{
+    static uint32_t seed = 12345;
+
+    seed = seed * 1103515245 + 12345;
+
+    return 1.5 * sinf(0.01 * n * (channel + 1)) +
+           0.2 * (((float) ((seed >> 16) & 0x7FFF) / 16384.0) - 1.0);
+}
+
+#endif /* TEST_H_ */
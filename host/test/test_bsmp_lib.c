@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_bsmp_lib.c
+ * @brief BSMP server of ARM firmware, over host stand-ins of its seams.
+ *
+ * Requests go through ```BSMPprocess()```, as received from RS-485, and
+ * answers are checked against IPC shared RAM. Saving the parameters bank
+ * runs through EEPROM write queue down to the EEPROM model. Latency of
+ * variable reads is printed, and must agree with the histogram on BSMP
+ * statistics.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "test.h"
+#include "fw_host.h"
+
+#include "communication_drivers/bsmp/bsmp_lib.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
+#include "communication_drivers/ipc/ipc_lib.h"
+#include "communication_drivers/parameters/ps_parameters.h"
+
+#define NUM_LATENCY_REQUESTS    100000
+
+static uint8_t recv_data[16];
+static uint8_t send_data[1024];
+
+static struct bsmp_raw_packet recv_packet = { .data = recv_data };
+static struct bsmp_raw_packet send_packet = { .data = send_data };
+
+static void request(uint8_t cmd, uint16_t size, const uint8_t *payload)
+{
+    recv_data[0] = cmd;
+    recv_data[1] = size >> 8;
+    recv_data[2] = size & 0xFF;
+    memcpy(&recv_data[3], payload, size);
+    recv_packet.len = 3 + size;
+
+    BSMPprocess(&recv_packet, &send_packet, 0);
+}
+
+/**
+ * Execute function and get its return code, which is answered as an error
+ * when not 0
+ */
+static uint8_t execute_func(uint8_t id, uint8_t input)
+{
+    uint8_t payload[2] = {id, input};
+
+    request(0x50, 2, payload);
+
+    return ( (send_data[0] == 0x51) || (send_data[0] == 0x53) ) ?
+           send_data[3] : 0xFF;
+}
+
+static void test_query_version(void)
+{
+    request(0x00, 0, NULL);
+
+    CHECK( (send_data[0] == 0x01) && (send_packet.len == 6),
+           "query version answered %02X, %u bytes", send_data[0],
+           send_packet.len );
+}
+
+static void test_var_read(void)
+{
+    uint8_t id = 0;
+
+    g_ipc_ctom.ps_module[0].ps_status.all = 0x1234;
+
+    request(0x10, 1, &id);
+
+    CHECK( (send_data[0] == 0x11) && (send_packet.len == 5) &&
+           (send_data[3] == 0x34) && (send_data[4] == 0x12),
+           "var 0 answered %02X, %u bytes", send_data[0], send_packet.len );
+}
+
+/**
+ * Mode 1 of save_param_bank_changed posts the bank only if it differs from
+ * the saved image, and answers busy while EEPROM queue is writing it
+ */
+static void test_save_param_bank_changed(void)
+{
+    uint16_t polls = 0;
+
+    CHECK(execute_func(43, 1) == 0, "unchanged bank not saved");
+    CHECK(!eeprom_queue_busy(), "unchanged bank was posted");
+
+    set_param(PS_Model, 0, 1.0);
+
+    CHECK(execute_func(43, 1) == 0, "changed bank not posted");
+    CHECK(eeprom_queue_busy(), "changed bank wasn't posted");
+    CHECK(execute_func(43, 1) == 6, "save while writing wasn't busy");
+    CHECK(execute_func(43, 2) == 8, "invalid mode wasn't rejected");
+
+    while(eeprom_queue_busy() && (polls++ < 1000))
+    {
+        process_eeprom_queue();
+    }
+
+    CHECK(!eeprom_queue_busy(), "EEPROM queue didn't finish");
+    CHECK(g_eeprom_queue_stats.timeouts == 0, "EEPROM write timed out");
+    CHECK(g_host_i2c_stats.writes > 0, "nothing written on EEPROM");
+    CHECK(execute_func(43, 1) == 0, "saved bank not acknowledged");
+    CHECK(!eeprom_queue_busy(), "saved bank was posted again");
+}
+
+/**
+ * Latency measured around ```BSMPprocess()``` must be accounted on the
+ * histogram of BSMP statistics, which is read as variable 24
+ */
+static void test_latency(void)
+{
+    bsmp_stats_summary_t summary;
+    struct timespec t0, t1;
+    uint32_t requests_before, hist_sum = 0;
+    uint8_t id;
+    uint32_t i;
+    double ns;
+
+    id = 24;
+    request(0x10, 1, &id);
+    memcpy(&summary, &send_data[3], sizeof(summary));
+    requests_before = summary.requests;
+
+    id = 1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(i = 0; i < NUM_LATENCY_REQUESTS; i++)
+    {
+        request(0x10, 1, &id);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+    printf("BSMP var read: %.0f ns/request on host\n",
+           ns / NUM_LATENCY_REQUESTS);
+
+    id = 24;
+    request(0x10, 1, &id);
+    memcpy(&summary, &send_data[3], sizeof(summary));
+
+    CHECK(summary.requests - requests_before == NUM_LATENCY_REQUESTS + 1,
+          "%u requests accounted", summary.requests - requests_before);
+
+    for(i = 0; i < BSMP_LATENCY_BINS; i++)
+    {
+        hist_sum += summary.hist[i];
+    }
+
+    CHECK(hist_sum == summary.requests, "histogram holds %u of %u requests",
+          hist_sum, summary.requests);
+}
+
+int main(void)
+{
+    host_fw_reset();
+    init_parameters_bank();
+    init_eeprom_queue();
+    bsmp_init(0);
+
+    test_query_version();
+    test_var_read();
+    test_save_param_bank_changed();
+    test_latency();
+
+    return test_result("test_bsmp_lib");
+}
@@ -0,0 +1,296 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_dsp_analysis.c
+ * @brief Analysis of DSP pipelines against known transfer functions.
+ *
+ * Results are compared with closed-form expressions:
+ *
+ *  - LPF is a Tustin discretization of 1/(tau*s + 1), so its response at
+ *    frequency f is the continuous one at 2*fs*tan(pi*f/fs) rad/s;
+ *  - notch filter has zeros on unit circle, at its notch frequency;
+ *  - integrator with 2 samples delay, ki*z^-2/(1 - z^-1), has phase
+ *    crossover at fs/6, where its gain is ki, and gain crossover at
+ *    w = 2*asin(ki/2), with phase margin of 90 - 1.5*w degrees;
+ *  - step response of PI is a ramp, kp*A + ki*A*(n+1).
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "test.h"
+#include "dsp.h"
+#include "dsp_pipeline.h"
+#include "dsp_analysis.h"
+
+#define FREQ_SAMPLING   10000.0
+#define PI              3.141592653589793
+#define NUM_STEP        100
+
+static volatile float signals[DSP_PIPELINE_MAX_STAGES + 1];
+
+static double c_abs(dsp_complex_t x)
+{
+    return sqrt(x.re*x.re + x.im*x.im);
+}
+
+static void test_lpf_response(void)
+{
+    static dsp_lpf_t lpf;
+    static dsp_pipeline_t pipeline;
+    static const float freq[] = {0.0, 50.0, 200.0, 1000.0, 4000.0};
+    double freq_cut, w_analog, mag, phase;
+    dsp_complex_t h;
+    dsp_pz_map_t pz_map;
+    uint16_t i;
+
+    freq_cut = 200.0;
+    init_dsp_lpf(&lpf, freq_cut, FREQ_SAMPLING, &signals[0], &signals[1]);
+    init_dsp_pipeline(&pipeline);
+    add_dsp_pipeline_stage(&pipeline, DSP_LPF, &lpf);
+
+    for(i = 0; i < sizeof(freq)/sizeof(freq[0]); i++)
+    {
+        w_analog = 2.0 * FREQ_SAMPLING * tan(PI * freq[i] / FREQ_SAMPLING);
+        mag = 1.0 / sqrt(1.0 + pow(w_analog / (2.0 * PI * freq_cut), 2.0));
+        phase = -atan(w_analog / (2.0 * PI * freq_cut));
+
+        h = calc_dsp_pipeline_tf(&pipeline, freq[i], FREQ_SAMPLING);
+
+        CHECK(fabs(c_abs(h) - mag) < 1e-5, "LPF at %g Hz: |H| %.6f != %.6f",
+              freq[i], c_abs(h), mag);
+        CHECK(fabs(atan2(h.im, h.re) - phase) < 1e-4,
+              "LPF at %g Hz: phase %.6f != %.6f", freq[i],
+              atan2(h.im, h.re), phase);
+    }
+
+    /**
+     * Tustin maps s = -1/tau to z = a and s = infinity to z = -1
+     */
+    calc_dsp_pipeline_pz_map(&pipeline, &pz_map);
+    CHECK( (pz_map.num_poles == 1) && (pz_map.num_zeros == 1),
+           "LPF: %u poles, %u zeros", pz_map.num_poles, pz_map.num_zeros);
+    CHECK( (fabs(pz_map.poles[0].re - lpf.a) < 1e-6) &&
+           (fabs(pz_map.poles[0].im) < 1e-6), "LPF: pole %g%+gj",
+           pz_map.poles[0].re, pz_map.poles[0].im);
+    CHECK( (fabs(pz_map.zeros[0].re + 1.0) < 1e-6) &&
+           (fabs(pz_map.zeros[0].im) < 1e-6), "LPF: zero %g%+gj",
+           pz_map.zeros[0].re, pz_map.zeros[0].im);
+}
+
+static void test_notch_zeros(void)
+{
+    static dsp_iir_2p2z_t notch;
+    static dsp_pipeline_t pipeline;
+    double freq_notch, angle;
+    dsp_complex_t h;
+    dsp_pz_map_t pz_map;
+    uint16_t i;
+
+    freq_notch = 1000.0;
+    init_dsp_notch_2p2z(&notch, 0.9, freq_notch, FREQ_SAMPLING, 1e6, -1e6,
+                        &signals[0], &signals[1]);
+    init_dsp_pipeline(&pipeline);
+    add_dsp_pipeline_stage(&pipeline, DSP_IIR_2P2Z, &notch);
+
+    calc_dsp_pipeline_pz_map(&pipeline, &pz_map);
+    CHECK(pz_map.num_zeros == 2, "Notch: %u zeros", pz_map.num_zeros);
+
+    for(i = 0; i < pz_map.num_zeros; i++)
+    {
+        angle = fabs(atan2(pz_map.zeros[i].im, pz_map.zeros[i].re));
+
+        CHECK(fabs(c_abs(pz_map.zeros[i]) - 1.0) < 1e-5,
+              "Notch: zero %u radius %.6f", i, c_abs(pz_map.zeros[i]));
+        CHECK(fabs(angle - 2.0 * PI * freq_notch / FREQ_SAMPLING) < 1e-5,
+              "Notch: zero %u angle %.6f", i, angle);
+    }
+
+    h = calc_dsp_pipeline_tf(&pipeline, freq_notch, FREQ_SAMPLING);
+    CHECK(c_abs(h) < 1e-5, "Notch: |H| %g at notch frequency", c_abs(h));
+
+    h = calc_dsp_pipeline_tf(&pipeline, 0.0, FREQ_SAMPLING);
+    CHECK(fabs(c_abs(h) - 1.0) < 1e-5, "Notch: DC gain %g", c_abs(h));
+}
+
+/**
+ * Integrator from PI with null proportional gain, followed by a 2 samples
+ * delay from 2P2Z filter.
+ */
+static void init_delayed_integrator(dsp_pi_t *p_pi, dsp_iir_2p2z_t *p_delay,
+                                    dsp_pipeline_t *p_pipeline, float ki)
+{
+    init_dsp_pi(p_pi, 0.0, ki, FREQ_SAMPLING, 1e6, -1e6, &signals[0],
+                &signals[1]);
+    init_dsp_iir_2p2z(p_delay, 0.0, 0.0, 1.0, 0.0, 0.0, 1e6, -1e6,
+                      &signals[1], &signals[2]);
+    init_dsp_pipeline(p_pipeline);
+    add_dsp_pipeline_stage(p_pipeline, DSP_PI, p_pi);
+    add_dsp_pipeline_stage(p_pipeline, DSP_IIR_2P2Z, p_delay);
+}
+
+static void test_margins(void)
+{
+    static dsp_pi_t pi;
+    static dsp_iir_2p2z_t delay;
+    static dsp_pipeline_t pipeline;
+    double ki, w_cross, gm_db, pm_deg;
+    dsp_margins_t margins;
+
+    ki = 0.5;
+    w_cross = 2.0 * asin(ki / 2.0);
+    gm_db = -20.0 * log10(ki);
+    pm_deg = 90.0 - 1.5 * w_cross * 180.0 / PI;
+
+    init_delayed_integrator(&pi, &delay, &pipeline, ki);
+    calc_dsp_pipeline_margins(&pipeline, FREQ_SAMPLING, &margins);
+
+    CHECK(fabs(margins.gain_margin_db - gm_db) < 0.01,
+          "Gain margin %.4f != %.4f dB", margins.gain_margin_db, gm_db);
+    CHECK(fabs(margins.phase_margin_deg - pm_deg) < 0.05,
+          "Phase margin %.4f != %.4f deg", margins.phase_margin_deg, pm_deg);
+    CHECK(fabs(margins.freq_phase_cross - FREQ_SAMPLING / 6.0) <
+          1e-3 * FREQ_SAMPLING, "Phase crossover %.3f Hz",
+          margins.freq_phase_cross);
+    CHECK(fabs(margins.freq_gain_cross - w_cross * FREQ_SAMPLING / (2.0*PI)) <
+          1e-3 * FREQ_SAMPLING, "Gain crossover %.3f Hz",
+          margins.freq_gain_cross);
+
+    /**
+     * Integrator pole lies on unit circle
+     */
+    CHECK(!margins.stable, "Integrator taken as stable");
+}
+
+static void test_step(void)
+{
+    static dsp_pi_t pi;
+    static dsp_pipeline_t pipeline;
+    float step[NUM_STEP];
+    double kp, ki, amplitude, expected;
+    uint16_t n;
+
+    kp = 0.5;
+    ki = 0.01;
+    amplitude = 2.0;
+
+    init_dsp_pi(&pi, kp, ki, FREQ_SAMPLING, 1e6, -1e6, &signals[0],
+                &signals[1]);
+    init_dsp_pipeline(&pipeline);
+    add_dsp_pipeline_stage(&pipeline, DSP_PI, &pi);
+
+    CHECK(calc_dsp_pipeline_step(&pipeline, amplitude, step, NUM_STEP) ==
+          NUM_STEP, "Step: number of samples");
+
+    for(n = 0; n < NUM_STEP; n++)
+    {
+        expected = kp * amplitude + ki * amplitude * (n + 1);
+        CHECK(fabs(step[n] - expected) < 1e-4, "Step sample %u: %g != %g", n,
+              step[n], expected);
+    }
+
+    /**
+     * Simulation must not modify pipeline modules
+     */
+    CHECK(pi.u_int == 0.0, "Step: PI module modified");
+}
+
+/**
+ * Feed-forward gain is vdc_nom/vdc_meas, or unity if measurement is below
+ * vdc_min or not positive.
+ */
+static void test_vdclink_ff_gain(void)
+{
+    static dsp_vdclink_ff_t ff;
+    static dsp_pipeline_t pipeline;
+    static volatile float vdc_meas;
+    dsp_complex_t h;
+
+    init_dsp_vdclink_ff(&ff, 100.0, -1.0, &vdc_meas, &signals[0],
+                        &signals[1]);
+    init_dsp_pipeline(&pipeline);
+    add_dsp_pipeline_stage(&pipeline, DSP_VdcLink_FeedForward, &ff);
+
+    vdc_meas = 50.0;
+    h = calc_dsp_pipeline_tf(&pipeline, 0.0, FREQ_SAMPLING);
+    CHECK(fabs(h.re - 2.0) < 1e-6, "FF gain %g at 50 V", h.re);
+
+    vdc_meas = 0.0;
+    h = calc_dsp_pipeline_tf(&pipeline, 0.0, FREQ_SAMPLING);
+    CHECK(h.re == 1.0, "FF gain %g at 0 V", h.re);
+
+    vdc_meas = -10.0;
+    h = calc_dsp_pipeline_tf(&pipeline, 0.0, FREQ_SAMPLING);
+    CHECK(h.re == 1.0, "FF gain %g at -10 V", h.re);
+}
+
+/**
+ * Batch analysis must give the same results as individual calls.
+ */
+static void test_batch(void)
+{
+    static dsp_pi_t pi[2];
+    static dsp_iir_2p2z_t delay[2];
+    static dsp_pipeline_t pipeline[2];
+    static dsp_analysis_t analysis[2];
+    float step[NUM_STEP];
+    dsp_margins_t margins;
+    uint16_t i, n;
+
+    for(i = 0; i < 2; i++)
+    {
+        init_delayed_integrator(&pi[i], &delay[i], &pipeline[i],
+                                0.2 * (i + 1));
+
+        analysis[i].p_pipeline = &pipeline[i];
+        analysis[i].freq_sampling = FREQ_SAMPLING;
+        analysis[i].step_amplitude = 1.0;
+        analysis[i].num_step_samples = NUM_STEP;
+        analysis[i].p_step = malloc(NUM_STEP * sizeof(float));
+    }
+
+    run_dsp_analysis_batch(analysis, 2);
+
+    for(i = 0; i < 2; i++)
+    {
+        calc_dsp_pipeline_margins(&pipeline[i], FREQ_SAMPLING, &margins);
+        calc_dsp_pipeline_step(&pipeline[i], 1.0, step, NUM_STEP);
+
+        CHECK( (analysis[i].margins.gain_margin_db == margins.gain_margin_db)
+               && (analysis[i].margins.phase_margin_deg ==
+                   margins.phase_margin_deg),
+               "Batch %u: margins", i);
+
+        for(n = 0; n < NUM_STEP; n++)
+        {
+            CHECK(analysis[i].p_step[n] == step[n], "Batch %u: step %u", i,
+                  n);
+        }
+
+        free(analysis[i].p_step);
+    }
+}
+
+int main(void)
+{
+    test_lpf_response();
+    test_notch_zeros();
+    test_margins();
+    test_step();
+    test_vdclink_ff_gain();
+    test_batch();
+
+    return test_result("test_dsp_analysis");
+}
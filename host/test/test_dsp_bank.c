@@ -0,0 +1,223 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_dsp_bank.c
+ * @brief Banks of DSP modules against scalar modules.
+ *
+ * Each bank runs along an array of scalar modules sharing the same inputs,
+ * and outputs must match exactly at every sample. Bank outputs are written
+ * to separate signals.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include "test.h"
+#include "dsp.h"
+#include "dsp_bank.h"
+
+#define NUM_SAMPLES     5000
+#define FREQ_SAMPLING   50000.0
+
+static volatile float in[DSP_BANK_SIZE];
+static volatile float out_scalar[DSP_BANK_SIZE];
+static volatile float out_bank[DSP_BANK_SIZE];
+
+static void update_inputs(uint32_t n, uint16_t num)
+{
+    uint16_t i;
+
+    for(i = 0; i < num; i++)
+    {
+        in[i] = test_signal(n, i);
+    }
+}
+
+static void check_outputs(const char *name, uint32_t n, uint16_t num)
+{
+    uint16_t i;
+
+    for(i = 0; i < num; i++)
+    {
+        CHECK(out_scalar[i] == out_bank[i], "%s[%u] sample %u: %.9g != %.9g",
+              name, i, n, out_scalar[i], out_bank[i]);
+    }
+}
+
+static void test_lpf_bank(void)
+{
+    static dsp_lpf_t lpf[DSP_BANK_SIZE];
+    static dsp_lpf_bank_t bank;
+    uint16_t i;
+    uint32_t n;
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        init_dsp_lpf(&lpf[i], 100.0 * (i + 1), FREQ_SAMPLING, &in[i],
+                     &out_scalar[i]);
+    }
+
+    CHECK(load_dsp_lpf_bank(&bank, lpf, DSP_BANK_SIZE) == DSP_BANK_SIZE,
+          "LPF bank size");
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        bank.out[i] = &out_bank[i];
+    }
+    reset_dsp_lpf_bank(&bank);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_inputs(n, DSP_BANK_SIZE);
+
+        for(i = 0; i < DSP_BANK_SIZE; i++)
+        {
+            run_dsp_lpf(&lpf[i]);
+        }
+        run_dsp_lpf_bank(&bank);
+
+        check_outputs("LPF", n, DSP_BANK_SIZE);
+    }
+}
+
+static void test_pi_bank(void)
+{
+    static dsp_pi_t pi[DSP_BANK_SIZE];
+    static dsp_pi_bank_t bank;
+    uint16_t i;
+    uint32_t n;
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        init_dsp_pi(&pi[i], 0.2 * (i + 1), 50.0 * (i + 1), FREQ_SAMPLING, 1.0,
+                    -1.0, &in[i], &out_scalar[i]);
+    }
+
+    load_dsp_pi_bank(&bank, pi, DSP_BANK_SIZE);
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        bank.out[i] = &out_bank[i];
+    }
+    reset_dsp_pi_bank(&bank);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_inputs(n, DSP_BANK_SIZE);
+
+        for(i = 0; i < DSP_BANK_SIZE; i++)
+        {
+            run_dsp_pi(&pi[i]);
+        }
+        run_dsp_pi_bank(&bank);
+
+        check_outputs("PI", n, DSP_BANK_SIZE);
+    }
+
+    /**
+     * States stored back to modules overwrite theirs
+     */
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        pi[i].u_int = 0.0;
+    }
+    store_dsp_pi_bank(&bank, pi);
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        CHECK(pi[i].u_int == bank.u_int[i], "PI[%u] stored state", i);
+    }
+}
+
+static void test_iir_2p2z_bank(void)
+{
+    static dsp_iir_2p2z_t iir[DSP_BANK_SIZE];
+    static dsp_iir_2p2z_bank_t bank;
+    uint16_t i;
+    uint32_t n;
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        init_dsp_notch_2p2z(&iir[i], 0.9, 500.0 * (i + 1), FREQ_SAMPLING, 1.0,
+                            -1.0, &in[i], &out_scalar[i]);
+    }
+
+    load_dsp_iir_2p2z_bank(&bank, iir, DSP_BANK_SIZE);
+
+    for(i = 0; i < DSP_BANK_SIZE; i++)
+    {
+        bank.out[i] = &out_bank[i];
+    }
+    reset_dsp_iir_2p2z_bank(&bank);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_inputs(n, DSP_BANK_SIZE);
+
+        for(i = 0; i < DSP_BANK_SIZE; i++)
+        {
+            run_dsp_iir_2p2z(&iir[i]);
+        }
+        run_dsp_iir_2p2z_bank(&bank);
+
+        check_outputs("IIR_2P2Z", n, DSP_BANK_SIZE);
+    }
+}
+
+static void test_iir_3p3z_bank(void)
+{
+    static dsp_iir_3p3z_t iir[DSP_BANK_SIZE];
+    static dsp_iir_3p3z_bank_t bank;
+    uint16_t i;
+    uint32_t n;
+
+    /**
+     * Fewer modules than bank size
+     */
+    for(i = 0; i < DSP_BANK_SIZE/2; i++)
+    {
+        init_dsp_iir_3p3z(&iir[i], 0.1, 0.2 * i, 0.05, 0.01, -1.2, 0.4, -0.05,
+                          1.0, -1.0, &in[i], &out_scalar[i]);
+    }
+
+    CHECK(load_dsp_iir_3p3z_bank(&bank, iir, DSP_BANK_SIZE/2) ==
+          DSP_BANK_SIZE/2, "IIR_3P3Z bank size");
+
+    for(i = 0; i < DSP_BANK_SIZE/2; i++)
+    {
+        bank.out[i] = &out_bank[i];
+    }
+    reset_dsp_iir_3p3z_bank(&bank);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_inputs(n, DSP_BANK_SIZE/2);
+
+        for(i = 0; i < DSP_BANK_SIZE/2; i++)
+        {
+            run_dsp_iir_3p3z(&iir[i]);
+        }
+        run_dsp_iir_3p3z_bank(&bank);
+
+        check_outputs("IIR_3P3Z", n, DSP_BANK_SIZE/2);
+    }
+}
+
+int main(void)
+{
+    test_lpf_bank();
+    test_pi_bank();
+    test_iir_2p2z_bank();
+    test_iir_3p3z_bank();
+
+    return test_result("test_dsp_bank");
+}
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_dsp_pipeline.c
+ * @brief Fused pipeline against chained DSP modules.
+ *
+ * Two identical chains with all pipeline classes are set up: one runs each
+ * module separately and the other runs as a pipeline. Outputs and states
+ * kept by the pipeline must match exactly at every sample, with SRLim both
+ * active and bypassed.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "test.h"
+#include "dsp.h"
+#include "dsp_pipeline.h"
+
+#define NUM_SAMPLES     50000
+#define FREQ_SAMPLING   48000.0
+
+typedef struct
+{
+    volatile float  ref;
+    volatile float  ref_srlim;
+    volatile float  meas;
+    volatile float  error;
+    volatile float  pi;
+    volatile float  lpf;
+    volatile float  notch;
+    volatile float  iir_3p3z;
+    volatile float  vdc;
+    volatile float  out;
+
+    dsp_srlim_t         srlim;
+    dsp_error_t         err;
+    dsp_pi_t            pi_ctrl;
+    dsp_lpf_t           lpf_filt;
+    dsp_iir_2p2z_t      notch_filt;
+    dsp_iir_3p3z_t      iir_3p3z_filt;
+    dsp_vdclink_ff_t    ff;
+} chain_t;
+
+static void init_chain(chain_t *p_chain, uint16_t bypass_srlim)
+{
+    memset(p_chain, 0, sizeof(chain_t));
+
+    init_dsp_srlim(&p_chain->srlim, 50.0, FREQ_SAMPLING, &p_chain->ref,
+                   &p_chain->ref_srlim);
+    p_chain->srlim.bypass = bypass_srlim;
+    init_dsp_error(&p_chain->err, &p_chain->ref_srlim, &p_chain->meas,
+                   &p_chain->error);
+    init_dsp_pi(&p_chain->pi_ctrl, 0.7, 30.0, FREQ_SAMPLING, 0.9, -0.9,
+                &p_chain->error, &p_chain->pi);
+    init_dsp_lpf(&p_chain->lpf_filt, 5000.0, FREQ_SAMPLING, &p_chain->pi,
+                 &p_chain->lpf);
+    init_dsp_notch_2p2z(&p_chain->notch_filt, 0.9, 1000.0, FREQ_SAMPLING,
+                        0.95, -0.95, &p_chain->lpf, &p_chain->notch);
+    init_dsp_iir_3p3z(&p_chain->iir_3p3z_filt, 0.1, 0.2, 0.05, 0.01, -1.2,
+                      0.4, -0.05, 0.9, -0.9, &p_chain->notch,
+                      &p_chain->iir_3p3z);
+    init_dsp_vdclink_ff(&p_chain->ff, 100.0, 20.0, &p_chain->vdc,
+                        &p_chain->iir_3p3z, &p_chain->out);
+}
+
+static void run_chain(chain_t *p_chain)
+{
+    run_dsp_srlim(&p_chain->srlim, p_chain->srlim.bypass);
+    run_dsp_error(&p_chain->err);
+    run_dsp_pi(&p_chain->pi_ctrl);
+    run_dsp_lpf(&p_chain->lpf_filt);
+    run_dsp_iir_2p2z(&p_chain->notch_filt);
+    run_dsp_iir_3p3z(&p_chain->iir_3p3z_filt);
+    run_dsp_vdclink_ff(&p_chain->ff);
+}
+
+static void test_pipeline(uint16_t bypass_srlim)
+{
+    static chain_t chain;
+    static chain_t chain_pipeline;
+    static dsp_pipeline_t pipeline;
+    uint16_t num_added;
+    uint32_t n;
+
+    init_chain(&chain, bypass_srlim);
+    init_chain(&chain_pipeline, bypass_srlim);
+
+    init_dsp_pipeline(&pipeline);
+    num_added = add_dsp_pipeline_stage(&pipeline, DSP_SRLim,
+                                       &chain_pipeline.srlim);
+    num_added += add_dsp_pipeline_stage(&pipeline, DSP_Error,
+                                        &chain_pipeline.err);
+    num_added += add_dsp_pipeline_stage(&pipeline, DSP_PI,
+                                        &chain_pipeline.pi_ctrl);
+    num_added += add_dsp_pipeline_stage(&pipeline, DSP_LPF,
+                                        &chain_pipeline.lpf_filt);
+    num_added += add_dsp_pipeline_stage(&pipeline, DSP_IIR_2P2Z,
+                                        &chain_pipeline.notch_filt);
+    num_added += add_dsp_pipeline_stage(&pipeline, DSP_IIR_3P3Z,
+                                        &chain_pipeline.iir_3p3z_filt);
+    num_added += add_dsp_pipeline_stage(&pipeline, DSP_VdcLink_FeedForward,
+                                        &chain_pipeline.ff);
+
+    CHECK(num_added == 7, "bypass %u: %u stages added", bypass_srlim,
+          num_added);
+    CHECK(pipeline.num_stages == (bypass_srlim ? 6 : 7),
+          "bypass %u: %u stages in pipeline", bypass_srlim,
+          pipeline.num_stages);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        chain.ref = chain_pipeline.ref = 10.0 * test_signal(n, 0);
+        chain.meas = chain_pipeline.meas = test_signal(n, 1);
+        chain.vdc = chain_pipeline.vdc = 60.0 + 50.0 * test_signal(n, 2);
+
+        run_chain(&chain);
+        run_dsp_pipeline(&pipeline);
+
+        CHECK(chain.out == chain_pipeline.out,
+              "bypass %u, sample %u: output %.9g != %.9g", bypass_srlim, n,
+              chain.out, chain_pipeline.out);
+        /**
+         * Bypassed SRLim isn't a pipeline stage, so its output isn't updated
+         */
+        CHECK(bypass_srlim || (chain.ref_srlim == chain_pipeline.ref_srlim),
+              "bypass %u, sample %u: SRLim output", bypass_srlim, n);
+        CHECK(chain.lpf == chain_pipeline.lpf,
+              "bypass %u, sample %u: LPF output", bypass_srlim, n);
+        CHECK(chain.pi_ctrl.u_int == chain_pipeline.pi_ctrl.u_int,
+              "bypass %u, sample %u: PI integrator", bypass_srlim, n);
+        CHECK( (chain.notch_filt.w1 == chain_pipeline.notch_filt.w1) &&
+               (chain.notch_filt.w2 == chain_pipeline.notch_filt.w2),
+              "bypass %u, sample %u: IIR_2P2Z states", bypass_srlim, n);
+        CHECK( (chain.iir_3p3z_filt.w1 == chain_pipeline.iir_3p3z_filt.w1) &&
+               (chain.iir_3p3z_filt.w2 == chain_pipeline.iir_3p3z_filt.w2) &&
+               (chain.iir_3p3z_filt.w3 == chain_pipeline.iir_3p3z_filt.w3),
+              "bypass %u, sample %u: IIR_3P3Z states", bypass_srlim, n);
+    }
+}
+
+/**
+ * Module whose input isn't the output of previous stage must be rejected.
+ */
+static void test_pipeline_broken_chain(void)
+{
+    static chain_t chain;
+    static dsp_pipeline_t pipeline;
+
+    init_chain(&chain, 0);
+    init_dsp_pipeline(&pipeline);
+
+    CHECK(add_dsp_pipeline_stage(&pipeline, DSP_PI, &chain.pi_ctrl) == 1,
+          "first stage rejected");
+    CHECK(add_dsp_pipeline_stage(&pipeline, DSP_IIR_2P2Z,
+                                 &chain.notch_filt) == 0,
+          "broken chain accepted");
+    CHECK(pipeline.num_stages == 1, "%u stages after broken chain",
+          pipeline.num_stages);
+}
+
+int main(void)
+{
+    test_pipeline(0);
+    test_pipeline(1);
+    test_pipeline_broken_chain();
+
+    return test_result("test_dsp_pipeline");
+}
@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_dsp_q.c
+ * @brief Fixed-point DSP modules against float modules.
+ *
+ * Each Q15 and Q31 module runs along its float counterpart, with the same
+ * input converted to fixed-point. Maximum error, normalized by full scale,
+ * must stay below bounds with some margin over the expected quantization
+ * error: Q15 bounds reflect its 2^-12 coefficient resolution, so they are
+ * loose for small coefficients, as the 2 Hz LPF.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include "test.h"
+#include "dsp.h"
+#include "dsp_q.h"
+
+#define NUM_SAMPLES     100000
+#define FREQ_SAMPLING   10000.0
+#define FULL_SCALE      10.0
+
+static volatile float in, out;
+static volatile q15_t in_q15, out_q15;
+static volatile q31_t in_q31, out_q31;
+
+typedef struct
+{
+    double max_err_q15;
+    double max_err_q31;
+} q_error_t;
+
+static void update_input(uint32_t n)
+{
+    in = 4.0 * test_signal(n, 0);
+    in_q15 = float_to_q15(in, FULL_SCALE);
+    in_q31 = float_to_q31(in, FULL_SCALE);
+}
+
+static void update_error(q_error_t *p_err)
+{
+    double err;
+
+    err = fabs(q15_to_float(out_q15, FULL_SCALE) - out) / FULL_SCALE;
+    if(err > p_err->max_err_q15)
+    {
+        p_err->max_err_q15 = err;
+    }
+
+    err = fabs(q31_to_float(out_q31, FULL_SCALE) - out) / FULL_SCALE;
+    if(err > p_err->max_err_q31)
+    {
+        p_err->max_err_q31 = err;
+    }
+}
+
+static void check_error(const char *name, q_error_t *p_err, double bound_q15,
+                        double bound_q31)
+{
+    CHECK(p_err->max_err_q15 < bound_q15, "%s: Q15 error %.3g >= %.3g", name,
+          p_err->max_err_q15, bound_q15);
+    CHECK(p_err->max_err_q31 < bound_q31, "%s: Q31 error %.3g >= %.3g", name,
+          p_err->max_err_q31, bound_q31);
+}
+
+static void test_srlim_q(void)
+{
+    static dsp_srlim_t srlim;
+    static dsp_srlim_q15_t srlim_q15;
+    static dsp_srlim_q31_t srlim_q31;
+    q_error_t err = {0.0, 0.0};
+    uint32_t n;
+
+    init_dsp_srlim(&srlim, 2000.0, FREQ_SAMPLING, &in, &out);
+    init_dsp_srlim_q15(&srlim_q15, &srlim, FULL_SCALE, &in_q15, &out_q15);
+    init_dsp_srlim_q31(&srlim_q31, &srlim, FULL_SCALE, &in_q31, &out_q31);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_input(n);
+        run_dsp_srlim(&srlim, USE_MODULE);
+        run_dsp_srlim_q15(&srlim_q15);
+        run_dsp_srlim_q31(&srlim_q31);
+        update_error(&err);
+    }
+
+    check_error("SRLim", &err, 5e-4, 1e-6);
+}
+
+static void test_lpf_q(float freq_cut, double bound_q15, double bound_q31)
+{
+    static dsp_lpf_t lpf;
+    static dsp_lpf_q15_t lpf_q15;
+    static dsp_lpf_q31_t lpf_q31;
+    q_error_t err = {0.0, 0.0};
+    uint32_t n;
+
+    init_dsp_lpf(&lpf, freq_cut, FREQ_SAMPLING, &in, &out);
+    CHECK(init_dsp_lpf_q15(&lpf_q15, &lpf, &in_q15, &out_q15) == 0,
+          "LPF Q15 coefficients saturated");
+    CHECK(init_dsp_lpf_q31(&lpf_q31, &lpf, &in_q31, &out_q31) == 0,
+          "LPF Q31 coefficients saturated");
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_input(n);
+        run_dsp_lpf(&lpf);
+        run_dsp_lpf_q15(&lpf_q15);
+        run_dsp_lpf_q31(&lpf_q31);
+        update_error(&err);
+    }
+
+    check_error("LPF", &err, bound_q15, bound_q31);
+}
+
+static void test_pi_q(float kp, float ki, float u_max, double bound_q15,
+                      double bound_q31)
+{
+    static dsp_pi_t pi;
+    static dsp_pi_q15_t pi_q15;
+    static dsp_pi_q31_t pi_q31;
+    q_error_t err = {0.0, 0.0};
+    uint32_t n;
+
+    init_dsp_pi(&pi, kp, ki, FREQ_SAMPLING, u_max, -u_max, &in, &out);
+    CHECK(init_dsp_pi_q15(&pi_q15, &pi, FULL_SCALE, &in_q15, &out_q15) == 0,
+          "PI Q15 coefficients saturated");
+    CHECK(init_dsp_pi_q31(&pi_q31, &pi, FULL_SCALE, &in_q31, &out_q31) == 0,
+          "PI Q31 coefficients saturated");
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_input(n);
+        run_dsp_pi(&pi);
+        run_dsp_pi_q15(&pi_q15);
+        run_dsp_pi_q31(&pi_q31);
+        update_error(&err);
+    }
+
+    check_error("PI", &err, bound_q15, bound_q31);
+}
+
+/**
+ * With proportional and integral gains of opposite signs, proportional term
+ * saturates at one limit while integrator goes towards the other one, so
+ * dynamic anti-windup limits exceed Q range. Integrator must saturate at Q
+ * range instead of wrapping around, so it never decreases for a constant
+ * positive input.
+ */
+static void test_pi_q_integrator_range(void)
+{
+    static dsp_pi_t pi;
+    static dsp_pi_q15_t pi_q15;
+    static dsp_pi_q31_t pi_q31;
+    q15_t u_int_q15;
+    q31_t u_int_q31;
+    uint32_t n;
+
+    init_dsp_pi(&pi, -4.0, 0.5, FREQ_SAMPLING, FULL_SCALE, -FULL_SCALE, &in,
+                &out);
+    init_dsp_pi_q15(&pi_q15, &pi, FULL_SCALE, &in_q15, &out_q15);
+    init_dsp_pi_q31(&pi_q31, &pi, FULL_SCALE, &in_q31, &out_q31);
+
+    in_q15 = float_to_q15(0.5*FULL_SCALE, FULL_SCALE);
+    in_q31 = float_to_q31(0.5*FULL_SCALE, FULL_SCALE);
+
+    for(n = 0; n < 1000; n++)
+    {
+        u_int_q15 = pi_q15.u_int;
+        u_int_q31 = pi_q31.u_int;
+
+        run_dsp_pi_q15(&pi_q15);
+        run_dsp_pi_q31(&pi_q31);
+
+        CHECK(pi_q15.u_int >= u_int_q15, "PI Q15 integrator wrapped at %u",
+              n);
+        CHECK(pi_q31.u_int >= u_int_q31, "PI Q31 integrator wrapped at %u",
+              n);
+    }
+
+    CHECK(pi_q15.u_int == Q15_MAX, "PI Q15 integrator %d", pi_q15.u_int);
+    CHECK(pi_q31.u_int == Q31_MAX, "PI Q31 integrator %d", pi_q31.u_int);
+}
+
+static void test_iir_2p2z_q(void)
+{
+    static dsp_iir_2p2z_t iir;
+    static dsp_iir_2p2z_q15_t iir_q15;
+    static dsp_iir_2p2z_q31_t iir_q31;
+    q_error_t err = {0.0, 0.0};
+    uint32_t n;
+
+    init_dsp_notch_2p2z(&iir, 0.9, 500.0, FREQ_SAMPLING, 9.5, -9.5, &in,
+                        &out);
+    CHECK(init_dsp_iir_2p2z_q15(&iir_q15, &iir, FULL_SCALE, &in_q15,
+                                &out_q15) == 0,
+          "IIR_2P2Z Q15 coefficients saturated");
+    CHECK(init_dsp_iir_2p2z_q31(&iir_q31, &iir, FULL_SCALE, &in_q31,
+                                &out_q31) == 0,
+          "IIR_2P2Z Q31 coefficients saturated");
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_input(n);
+        run_dsp_iir_2p2z(&iir);
+        run_dsp_iir_2p2z_q15(&iir_q15);
+        run_dsp_iir_2p2z_q31(&iir_q31);
+        update_error(&err);
+    }
+
+    check_error("IIR_2P2Z", &err, 3e-2, 1e-4);
+}
+
+static void test_iir_3p3z_q(void)
+{
+    static dsp_iir_3p3z_t iir;
+    static dsp_iir_3p3z_q15_t iir_q15;
+    static dsp_iir_3p3z_q31_t iir_q31;
+    q_error_t err = {0.0, 0.0};
+    uint32_t n;
+
+    init_dsp_iir_3p3z(&iir, 0.05, 0.05, 0.05, 0.05, -1.2, 0.5, -0.1, 9.5, -9.5,
+                      &in, &out);
+    CHECK(init_dsp_iir_3p3z_q15(&iir_q15, &iir, FULL_SCALE, &in_q15,
+                                &out_q15) == 0,
+          "IIR_3P3Z Q15 coefficients saturated");
+    CHECK(init_dsp_iir_3p3z_q31(&iir_q31, &iir, FULL_SCALE, &in_q31,
+                                &out_q31) == 0,
+          "IIR_3P3Z Q31 coefficients saturated");
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        update_input(n);
+        run_dsp_iir_3p3z(&iir);
+        run_dsp_iir_3p3z_q15(&iir_q15);
+        run_dsp_iir_3p3z_q31(&iir_q31);
+        update_error(&err);
+    }
+
+    check_error("IIR_3P3Z", &err, 5e-3, 1e-6);
+}
+
+/**
+ * Coefficients out of +/- 8 range must be reported, including the upper
+ * limit itself, which isn't representable.
+ */
+static void test_coeff_range(void)
+{
+    static dsp_iir_2p2z_t iir;
+    static dsp_iir_2p2z_q15_t iir_q15;
+    static dsp_iir_2p2z_q31_t iir_q31;
+
+    init_dsp_iir_2p2z(&iir, 8.0, -8.0, 7.9, -9.0, 0.5, 9.5, -9.5, &in, &out);
+
+    CHECK(load_dsp_iir_2p2z_q15(&iir_q15, &iir, FULL_SCALE) == 2,
+          "IIR_2P2Z Q15 saturated coefficients");
+    CHECK(load_dsp_iir_2p2z_q31(&iir_q31, &iir, FULL_SCALE) == 2,
+          "IIR_2P2Z Q31 saturated coefficients");
+    CHECK(iir_q15.b0 == Q15_MAX, "Q15 coefficient not saturated");
+    CHECK(iir_q31.a1 == Q31_MIN, "Q31 coefficient not saturated");
+}
+
+int main(void)
+{
+    test_srlim_q();
+    test_lpf_q(200.0, 1e-3, 1e-6);
+    test_lpf_q(2.0, 2e-1, 5e-6);
+    test_pi_q(0.6, 0.1, 9.0, 1e-2, 5e-6);
+    test_pi_q(4.0, 0.5, FULL_SCALE, 2e-2, 5e-6);
+    test_pi_q_integrator_range();
+    test_iir_2p2z_q();
+    test_iir_3p3z_q();
+    test_coeff_range();
+
+    return test_result("test_dsp_q");
+}
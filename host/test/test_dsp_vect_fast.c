@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_dsp_vect_fast.c
+ * @brief Prepared matrix-vector product against reference implementation.
+ *
+ * For each kernel, prepared product must select the expected kernel and
+ * give exactly the same outputs as run_dsp_vect_product(), since all of them
+ * accumulate each row in the same order.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "test.h"
+#include "dsp.h"
+#include "dsp_vect_fast.h"
+
+#define NUM_SAMPLES     200
+
+static volatile float in[NUM_MAX_MATRIX_SIZE];
+static volatile float out_ref[NUM_MAX_MATRIX_SIZE];
+static volatile float out_fast[NUM_MAX_MATRIX_SIZE];
+
+/**
+ * Fill matrix with pseudo-random values. When sparse, only diagonal and
+ * one element of each row are non-zero.
+ */
+static void fill_matrix(uint16_t num_rows, uint16_t num_cols,
+                        volatile float matrix[num_rows][num_cols],
+                        bool sparse)
+{
+    uint16_t r, c;
+
+    for(r = 0; r < num_rows; r++)
+    {
+        for(c = 0; c < num_cols; c++)
+        {
+            if( !sparse || (r == c) || (c == ((r + 3) % num_cols)) )
+            {
+                matrix[r][c] = test_signal(r*num_cols + c, c);
+            }
+            else
+            {
+                matrix[r][c] = 0.0;
+            }
+        }
+    }
+}
+
+static void test_vect_product(uint16_t num_rows, uint16_t num_cols,
+                              bool sparse, bool allow_sparse,
+                              dsp_vect_product_kernel_t kernel)
+{
+    static dsp_vect_product_t vect_product;
+    static dsp_vect_product_fast_t fast;
+    volatile float matrix[num_rows][num_cols];
+    uint16_t r, c;
+    uint32_t n;
+
+    fill_matrix(num_rows, num_cols, matrix, sparse);
+    init_dsp_vect_product(&vect_product, num_rows, num_cols, matrix, in,
+                          out_ref);
+    load_dsp_vect_product_fast(&fast, &vect_product, allow_sparse);
+    fast.out = out_fast;
+
+    CHECK(fast.kernel == kernel, "%ux%u: kernel %u, expected %u", num_rows,
+          num_cols, fast.kernel, kernel);
+
+    for(n = 0; n < NUM_SAMPLES; n++)
+    {
+        for(c = 0; c < num_cols; c++)
+        {
+            in[c] = test_signal(n, c);
+        }
+
+        run_dsp_vect_product(&vect_product);
+        run_dsp_vect_product_fast(&fast);
+
+        for(r = 0; r < num_rows; r++)
+        {
+            CHECK(out_ref[r] == out_fast[r],
+                  "%ux%u kernel %u, row %u sample %u: %.9g != %.9g",
+                  num_rows, num_cols, kernel, r, n, out_ref[r], out_fast[r]);
+        }
+    }
+}
+
+int main(void)
+{
+    test_vect_product(2, 2, false, true, Vect_Product_2x2);
+    test_vect_product(4, 4, false, true, Vect_Product_4x4);
+    test_vect_product(8, 8, false, true, Vect_Product_8x8);
+    test_vect_product(3, 5, false, true, Vect_Product_Dense);
+    test_vect_product(NUM_MAX_MATRIX_SIZE, NUM_MAX_MATRIX_SIZE, false, true,
+                      Vect_Product_Dense);
+
+    test_vect_product(8, 8, true, true, Vect_Product_CSR);
+    test_vect_product(8, 8, true, false, Vect_Product_8x8);
+    test_vect_product(NUM_MAX_MATRIX_SIZE, 6, true, true, Vect_Product_CSR);
+
+    return test_result("test_dsp_vect_fast");
+}
@@ -0,0 +1,324 @@
+/******************************************************************************
+ * Copyright (C) 2026 by LNLS - Brazilian Synchrotron Light Laboratory
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. LNLS and
+ * the Brazilian Center for Research in Energy and Materials (CNPEM) are not
+ * liable for any misuse of this material.
+ *
+ *****************************************************************************/
+
+/**
+ * @file test_ps_parameters.c
+ * @brief Parameters bank images on the EEPROM model.
+ *
+ * Saves go through EEPROM write queue and alternate between slots A and B,
+ * and boot is emulated by clearing the bank and loading it again. Torn
+ * images are written on the slot of the next save, by dropping writes after
+ * a number of pages or corrupting a byte, and load must fall back to the
+ * other slot, which keeps being the newest one for the next save. Writes
+ * which time out must keep the confirmed image and dirty bits, so the save
+ * is retried on the same slot with the same sequence number.
+ *
+ * @author agent
+ * @date 17/10/2026
+ *
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "test.h"
+#include "fw_host.h"
+
+#include "communication_drivers/common/crc32.h"
+#include "communication_drivers/i2c_onboard/eeprom.h"
+#include "communication_drivers/i2c_onboard/eeprom_queue.h"
+#include "communication_drivers/ipc/ipc_lib.h"
+#include "communication_drivers/parameters/ps_parameters.h"
+
+#define IMAGE_PAGES ((sizeof(param_image_header_t) + image_size() + \
+                      EEPROM_PAGE_SIZE - 1) / EEPROM_PAGE_SIZE)
+
+static uint8_t eeprom_snapshot[HOST_EEPROM_SIZE];
+
+static uint16_t image_size(void)
+{
+    param_id_t id;
+    uint16_t size = 0;
+
+    for(id = 0; id < NUM_PARAMETERS; id++)
+    {
+        size += g_parameters[id].size_type * g_parameters[id].num_elements;
+    }
+
+    return size;
+}
+
+static param_image_header_t image_header(uint16_t add)
+{
+    param_image_header_t header;
+
+    memcpy(&header, &g_host_eeprom.data[add], sizeof(header));
+
+    return header;
+}
+
+static uint8_t image_valid(uint16_t add)
+{
+    param_image_header_t header = image_header(add);
+    uint32_t crc;
+
+    if( (header.magic != PARAM_IMAGE_MAGIC) || (header.size != image_size()) )
+    {
+        return 0;
+    }
+
+    crc = crc32(0, (uint8_t *) &header, offsetof(param_image_header_t, crc));
+    crc = crc32(crc, &g_host_eeprom.data[add + sizeof(header)], header.size);
+
+    return (crc == header.crc);
+}
+
+/**
+ * Run EEPROM write queue until it's idle. Cycle counter is advanced past
+ * write cycle timeout on every call, so failed ACK polls time out at once.
+ */
+static void drain_eeprom_queue(void)
+{
+    uint16_t calls = 0;
+
+    while(eeprom_queue_busy() && (calls++ < 1000))
+    {
+        process_eeprom_queue();
+        host_advance_us(EEPROM_WRITE_TIMEOUT_US + 1);
+    }
+}
+
+/**
+ * Saved value is set at both ends of the image, so any torn write leaves
+ * stale data where it differs from the previous image
+ */
+static void save(float val)
+{
+    set_param(PS_Name, 0, val);
+    set_param(Analog_Var_Max, 3, val);
+    set_param(Analog_Var_Min, NUM_MAX_ANALOG_VAR - 1, val);
+    CHECK(post_save_param_bank(), "save of %g not posted", val);
+    drain_eeprom_queue();
+}
+
+/**
+ * Power-up: bank is cleared and loaded from EEPROM
+ */
+static void reboot(void)
+{
+    memset((void *) &g_ipc_mtoc, 0, sizeof(g_ipc_mtoc));
+    init_parameters_bank();
+    init_eeprom_queue();
+    memset(&g_host_i2c_stats, 0, sizeof(g_host_i2c_stats));
+    load_param_bank();
+}
+
+static void test_crc32(void)
+{
+    const uint8_t check[] = "123456789";
+
+    CHECK(crc32(0, check, 9) == 0xCBF43926, "CRC-32 check value");
+    CHECK(crc32(crc32(0, check, 4), &check[4], 5) == 0xCBF43926,
+          "CRC-32 continued over split data");
+    CHECK(crc32(0, check, 0) == 0, "CRC-32 of no data");
+}
+
+/**
+ * Blank EEPROM holds no image, so bank is loaded from legacy layout, one
+ * transaction per element, and first save goes to slot A
+ */
+static void test_first_save(void)
+{
+    reboot();
+
+    CHECK(g_host_i2c_stats.reads == 2 + get_param_bank_size(),
+          "legacy load took %u reads", g_host_i2c_stats.reads);
+
+    save(10.0);
+
+    CHECK(image_valid(PARAM_IMAGE_ADD_A) &&
+          (image_header(PARAM_IMAGE_ADD_A).sequence == 1),
+          "first image not on slot A with sequence 1");
+    CHECK(!image_valid(PARAM_IMAGE_ADD_B), "slot B written by first save");
+    CHECK(g_host_i2c_stats.writes == IMAGE_PAGES,
+          "image written with %u page writes", g_host_i2c_stats.writes);
+}
+
+/**
+ * Saves alternate between slots and newest image is loaded with a single
+ * sequential read, besides the two header reads
+ */
+static void test_alternate_slots(void)
+{
+    save(20.0);
+
+    CHECK(image_valid(PARAM_IMAGE_ADD_B) &&
+          (image_header(PARAM_IMAGE_ADD_B).sequence == 2),
+          "second image not on slot B with sequence 2");
+    CHECK(image_header(PARAM_IMAGE_ADD_A).sequence == 1,
+          "slot A overwritten by second save");
+
+    reboot();
+
+    CHECK(g_host_i2c_stats.reads == 3, "image load took %u reads",
+          g_host_i2c_stats.reads);
+    CHECK(get_param(Analog_Var_Max, 3) == 20.0, "loaded %g instead of 20",
+          get_param(Analog_Var_Max, 3));
+}
+
+/**
+ * Third save is torn on slot A. Slot B must be loaded, and the next save
+ * must go to slot A again, with sequence number 3, leaving slot B intact.
+ */
+static void check_torn_image(const char *name, int32_t writes_left,
+                             uint16_t corrupt_offset)
+{
+    memcpy(g_host_eeprom.data, eeprom_snapshot, HOST_EEPROM_SIZE);
+    reboot();
+
+    g_host_eeprom.writes_left = writes_left;
+    save(30.0);
+    g_host_eeprom.writes_left = -1;
+
+    if(corrupt_offset)
+    {
+        g_host_eeprom.data[PARAM_IMAGE_ADD_A + corrupt_offset] ^= 0x01;
+    }
+
+    CHECK(!image_valid(PARAM_IMAGE_ADD_A), "%s: slot A isn't torn", name);
+
+    reboot();
+
+    CHECK(get_param(Analog_Var_Max, 3) == 20.0,
+          "%s: loaded %g instead of 20 from slot B", name,
+          get_param(Analog_Var_Max, 3));
+
+    save(40.0);
+
+    CHECK(image_valid(PARAM_IMAGE_ADD_A) &&
+          (image_header(PARAM_IMAGE_ADD_A).sequence == 3),
+          "%s: next save not on slot A with sequence 3", name);
+    CHECK(!memcmp(&g_host_eeprom.data[PARAM_IMAGE_ADD_B],
+                  &eeprom_snapshot[PARAM_IMAGE_ADD_B], PARAM_IMAGE_SLOT_SIZE),
+          "%s: slot B modified", name);
+
+    reboot();
+
+    CHECK(get_param(Analog_Var_Max, 3) == 40.0,
+          "%s: loaded %g instead of 40", name, get_param(Analog_Var_Max, 3));
+}
+
+static void test_torn_images(void)
+{
+    memcpy(eeprom_snapshot, g_host_eeprom.data, HOST_EEPROM_SIZE);
+
+    check_torn_image("header only", 1, 0);
+    check_torn_image("partial data", IMAGE_PAGES / 2, 0);
+    check_torn_image("last page missing", IMAGE_PAGES - 1, 0);
+    check_torn_image("bad CRC", -1, sizeof(param_image_header_t) + 5);
+    check_torn_image("bad header", -1, offsetof(param_image_header_t, size));
+
+    memcpy(g_host_eeprom.data, eeprom_snapshot, HOST_EEPROM_SIZE);
+}
+
+/**
+ * Older image is loaded when newest one is torn, and no image at all falls
+ * back to legacy layout, restarting sequence on slot A
+ */
+static void test_slot_choice(void)
+{
+    reboot();
+    g_host_eeprom.data[PARAM_IMAGE_ADD_B + sizeof(param_image_header_t)] ^= 1;
+    reboot();
+
+    CHECK(get_param(Analog_Var_Max, 3) == 10.0,
+          "loaded %g instead of 10 from slot A", get_param(Analog_Var_Max, 3));
+
+    g_host_eeprom.data[PARAM_IMAGE_ADD_A + sizeof(param_image_header_t)] ^= 1;
+    reboot();
+
+    CHECK(g_host_i2c_stats.reads == 4 + get_param_bank_size(),
+          "load without valid image took %u reads", g_host_i2c_stats.reads);
+
+    save(50.0);
+
+    CHECK(image_valid(PARAM_IMAGE_ADD_A) &&
+          (image_header(PARAM_IMAGE_ADD_A).sequence == 1),
+          "save after legacy load not on slot A with sequence 1");
+
+    memcpy(g_host_eeprom.data, eeprom_snapshot, HOST_EEPROM_SIZE);
+}
+
+/**
+ * Write cycle never completes, so save times out. Confirmed image must be
+ * kept, modified elements must be dirty again, and the retry must go to the
+ * same slot with the same sequence number.
+ */
+static void test_write_timeout(void)
+{
+    uint32_t timeouts;
+    u_float_t saved;
+
+    reboot();
+    saved = g_ipc_mtoc.analog_vars.max[4];
+    timeouts = g_eeprom_queue_stats.timeouts;
+
+    set_param(Analog_Var_Max, 4, 44.0);
+
+    g_host_eeprom.stuck = 1;
+    CHECK(post_save_param_bank_dirty(), "dirty element not posted");
+    drain_eeprom_queue();
+    g_host_eeprom.stuck = 0;
+
+    CHECK(g_eeprom_queue_stats.timeouts > timeouts, "write didn't time out");
+
+    load_param_eeprom(Analog_Var_Max, 4);
+
+    CHECK(!memcmp(saved.u8, (void *) g_ipc_mtoc.analog_vars.max[4].u8, 4),
+          "restored %g from image of failed write",
+          get_param(Analog_Var_Max, 4));
+
+    set_param(Analog_Var_Max, 3, 60.0);
+
+    g_host_eeprom.stuck = 1;
+    CHECK(post_save_param_bank_dirty(), "dirty element not posted");
+    drain_eeprom_queue();
+    g_host_eeprom.stuck = 0;
+
+    CHECK(post_save_param_bank_dirty(), "retry not posted");
+    CHECK(eeprom_queue_busy(), "dirty bit lost by failed write");
+    drain_eeprom_queue();
+
+    CHECK(image_valid(PARAM_IMAGE_ADD_A) &&
+          (image_header(PARAM_IMAGE_ADD_A).sequence == 3),
+          "retry not on slot A with sequence 3");
+    CHECK(image_header(PARAM_IMAGE_ADD_B).sequence == 2,
+          "slot B overwritten by retry");
+
+    reboot();
+
+    CHECK(get_param(Analog_Var_Max, 3) == 60.0, "loaded %g instead of 60",
+          get_param(Analog_Var_Max, 3));
+}
+
+int main(void)
+{
+    host_fw_reset();
+
+    test_crc32();
+    test_first_save();
+    test_alternate_slots();
+    test_torn_images();
+    test_slot_choice();
+    test_write_timeout();
+
+    return test_result("test_ps_parameters");
+}